@@ -3,12 +3,47 @@
 
 #pragma once
 
+#include <glm/simd/platform.h>
 #include <cstdio>
+#include <cstddef>
+#include <memory>
 
 namespace gli{
 namespace detail
 {
 	FILE* open_file(const char *Filename, const char *mode);
+
+	/// Move the position of File to Offset bytes from its beginning, including beyond 2 GB
+	bool seek_file(FILE* File, std::size_t Offset);
+
+	/// Return the size in bytes of File, the position of File is left unspecified
+	std::size_t file_size(FILE* File);
+
+	/// Private mapping of a whole file. Pages are shared with the file cache until they are written, writes are never
+	/// carried to the file.
+	class file_mapping
+	{
+	public:
+		file_mapping();
+		~file_mapping();
+
+		bool open(char const* Filename);
+		void close();
+
+		bool empty() const;
+		std::size_t size() const;
+		char* data() const;
+
+	private:
+		file_mapping(file_mapping const&);
+		file_mapping& operator=(file_mapping const&);
+
+		char* Data;
+		std::size_t Size;
+	};
+
+	/// Map Filename, returns nullptr in case of failure
+	std::shared_ptr<file_mapping> map_file(char const* Filename);
 }//namespace detail
 }//namespace gli
 
@@ -1,6 +1,39 @@
 #pragma once
 
-#include <glm/simd/platform.h>
+#if GLM_PLATFORM & GLM_PLATFORM_WINDOWS
+	// Every gli user includes this file: windows.h is included with as few declarations and macros as possible, and
+	// the legacy near and far macros are removed when gli is the first to include it
+#	if !defined(_WINDOWS_)
+#		define GLI_WINDOWS_INCLUDED
+#	endif
+#	if !defined(WIN32_LEAN_AND_MEAN)
+#		define WIN32_LEAN_AND_MEAN
+#		define GLI_WIN32_LEAN_AND_MEAN
+#	endif
+#	if !defined(NOMINMAX)
+#		define NOMINMAX
+#		define GLI_NOMINMAX
+#	endif
+#	include <windows.h>
+#	if defined(GLI_WINDOWS_INCLUDED)
+#		undef near
+#		undef far
+#		undef GLI_WINDOWS_INCLUDED
+#	endif
+#	if defined(GLI_WIN32_LEAN_AND_MEAN)
+#		undef WIN32_LEAN_AND_MEAN
+#		undef GLI_WIN32_LEAN_AND_MEAN
+#	endif
+#	if defined(GLI_NOMINMAX)
+#		undef NOMINMAX
+#		undef GLI_NOMINMAX
+#	endif
+#else
+#	include <fcntl.h>
+#	include <sys/mman.h>
+#	include <sys/stat.h>
+#	include <unistd.h>
+#endif
 
 namespace gli{
 namespace detail
@@ -15,5 +48,125 @@ namespace detail
 			return std::fopen(Filename, Mode);
 #		endif
 	}
+
+	inline bool seek_file(FILE* File, std::size_t Offset)
+	{
+#		if GLM_COMPILER & GLM_COMPILER_VC
+			return _fseeki64(File, static_cast<__int64>(Offset), SEEK_SET) == 0;
+#		elif GLM_PLATFORM & GLM_PLATFORM_WINDOWS
+			return fseeko64(File, static_cast<off64_t>(Offset), SEEK_SET) == 0;
+#		else
+			return fseeko(File, static_cast<off_t>(Offset), SEEK_SET) == 0;
+#		endif
+	}
+
+	inline std::size_t file_size(FILE* File)
+	{
+#		if GLM_COMPILER & GLM_COMPILER_VC
+			if(_fseeki64(File, 0, SEEK_END) != 0)
+				return 0;
+			__int64 const Size = _ftelli64(File);
+#		elif GLM_PLATFORM & GLM_PLATFORM_WINDOWS
+			if(fseeko64(File, 0, SEEK_END) != 0)
+				return 0;
+			off64_t const Size = ftello64(File);
+#		else
+			if(fseeko(File, 0, SEEK_END) != 0)
+				return 0;
+			off_t const Size = ftello(File);
+#		endif
+		return Size > 0 ? static_cast<std::size_t>(Size) : 0;
+	}
+
+	inline file_mapping::file_mapping()
+		: Data(nullptr)
+		, Size(0)
+	{}
+
+	inline file_mapping::~file_mapping()
+	{
+		this->close();
+	}
+
+	inline bool file_mapping::open(char const* Filename)
+	{
+		this->close();
+
+#		if GLM_PLATFORM & GLM_PLATFORM_WINDOWS
+			HANDLE File = CreateFileA(Filename, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+			if(File == INVALID_HANDLE_VALUE)
+				return false;
+
+			LARGE_INTEGER FileSize;
+			HANDLE Mapping = nullptr;
+			if(GetFileSizeEx(File, &FileSize) && FileSize.QuadPart > 0)
+				Mapping = CreateFileMappingA(File, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+			if(Mapping)
+			{
+				this->Data = static_cast<char*>(MapViewOfFile(Mapping, FILE_MAP_COPY, 0, 0, 0));
+				CloseHandle(Mapping);
+			}
+			CloseHandle(File);
+
+			if(!this->Data)
+				return false;
+			this->Size = static_cast<std::size_t>(FileSize.QuadPart);
+#		else
+			int const File = ::open(Filename, O_RDONLY | O_CLOEXEC);
+			if(File < 0)
+				return false;
+
+			struct stat Status;
+			void* Mapping = MAP_FAILED;
+			if(fstat(File, &Status) == 0 && Status.st_size > 0)
+				Mapping = mmap(nullptr, static_cast<std::size_t>(Status.st_size), PROT_READ | PROT_WRITE, MAP_PRIVATE, File, 0);
+			::close(File);
+
+			if(Mapping == MAP_FAILED)
+				return false;
+			this->Data = static_cast<char*>(Mapping);
+			this->Size = static_cast<std::size_t>(Status.st_size);
+#		endif
+
+		return true;
+	}
+
+	inline void file_mapping::close()
+	{
+		if(!this->Data)
+			return;
+
+#		if GLM_PLATFORM & GLM_PLATFORM_WINDOWS
+			UnmapViewOfFile(this->Data);
+#		else
+			munmap(this->Data, this->Size);
+#		endif
+
+		this->Data = nullptr;
+		this->Size = 0;
+	}
+
+	inline bool file_mapping::empty() const
+	{
+		return this->Data == nullptr;
+	}
+
+	inline std::size_t file_mapping::size() const
+	{
+		return this->Size;
+	}
+
+	inline char* file_mapping::data() const
+	{
+		return this->Data;
+	}
+
+	inline std::shared_ptr<file_mapping> map_file(char const* Filename)
+	{
+		std::shared_ptr<file_mapping> Mapping = std::make_shared<file_mapping>();
+		if(!Mapping->open(Filename))
+			return nullptr;
+		return Mapping;
+	}
 }//namespace detail
 }//namespace gli
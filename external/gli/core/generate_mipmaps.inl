@@ -5,6 +5,7 @@
 #include "../sampler3d.hpp"
 #include "../sampler_cube.hpp"
 #include "../sampler_cube_array.hpp"
+#include "mipmaps_box.hpp"
 
 namespace gli
 {
@@ -124,4 +125,147 @@ namespace gli
 	{
 		return generate_mipmaps(Texture, Texture.base_layer(), Texture.max_layer(), Texture.base_face(), Texture.max_face(), Texture.base_level(), Texture.max_level(), Minification);
 	}
+
+	inline texture1d generate_mipmaps_box(
+		texture1d const& Texture,
+		texture1d::size_type BaseLevel, texture1d::size_type MaxLevel,
+		size_t ThreadCount)
+	{
+		fsampler1D Sampler(Texture, WRAP_CLAMP_TO_EDGE);
+		texture Storage(Sampler());
+		for(texture1d::size_type Level = BaseLevel; Level < MaxLevel; ++Level)
+			if(!detail::generate_mipmap_box(Storage, 0, 0, 0, 0, Level, ThreadCount))
+				Sampler.generate_mipmaps(Level, Level + 1, FILTER_LINEAR);
+		return Sampler();
+	}
+
+	inline texture1d_array generate_mipmaps_box(
+		texture1d_array const& Texture,
+		texture1d_array::size_type BaseLayer, texture1d_array::size_type MaxLayer,
+		texture1d_array::size_type BaseLevel, texture1d_array::size_type MaxLevel,
+		size_t ThreadCount)
+	{
+		fsampler1DArray Sampler(Texture, WRAP_CLAMP_TO_EDGE);
+		texture Storage(Sampler());
+		for(texture1d_array::size_type Level = BaseLevel; Level < MaxLevel; ++Level)
+			if(!detail::generate_mipmap_box(Storage, BaseLayer, MaxLayer, 0, 0, Level, ThreadCount))
+				Sampler.generate_mipmaps(BaseLayer, MaxLayer, Level, Level + 1, FILTER_LINEAR);
+		return Sampler();
+	}
+
+	inline texture2d generate_mipmaps_box(
+		texture2d const& Texture,
+		texture2d::size_type BaseLevel, texture2d::size_type MaxLevel,
+		size_t ThreadCount)
+	{
+		fsampler2D Sampler(Texture, WRAP_CLAMP_TO_EDGE);
+		texture Storage(Sampler());
+		for(texture2d::size_type Level = BaseLevel; Level < MaxLevel; ++Level)
+			if(!detail::generate_mipmap_box(Storage, 0, 0, 0, 0, Level, ThreadCount))
+				Sampler.generate_mipmaps(Level, Level + 1, FILTER_LINEAR);
+		return Sampler();
+	}
+
+	inline texture2d_array generate_mipmaps_box(
+		texture2d_array const& Texture,
+		texture2d_array::size_type BaseLayer, texture2d_array::size_type MaxLayer,
+		texture2d_array::size_type BaseLevel, texture2d_array::size_type MaxLevel,
+		size_t ThreadCount)
+	{
+		fsampler2DArray Sampler(Texture, WRAP_CLAMP_TO_EDGE);
+		texture Storage(Sampler());
+		for(texture2d_array::size_type Level = BaseLevel; Level < MaxLevel; ++Level)
+			if(!detail::generate_mipmap_box(Storage, BaseLayer, MaxLayer, 0, 0, Level, ThreadCount))
+				Sampler.generate_mipmaps(BaseLayer, MaxLayer, Level, Level + 1, FILTER_LINEAR);
+		return Sampler();
+	}
+
+	inline texture3d generate_mipmaps_box(
+		texture3d const& Texture,
+		texture3d::size_type BaseLevel, texture3d::size_type MaxLevel,
+		size_t ThreadCount)
+	{
+		fsampler3D Sampler(Texture, WRAP_CLAMP_TO_EDGE);
+		texture Storage(Sampler());
+		for(texture3d::size_type Level = BaseLevel; Level < MaxLevel; ++Level)
+			if(!detail::generate_mipmap_box(Storage, 0, 0, 0, 0, Level, ThreadCount))
+				Sampler.generate_mipmaps(Level, Level + 1, FILTER_LINEAR);
+		return Sampler();
+	}
+
+	inline texture_cube generate_mipmaps_box(
+		texture_cube const& Texture,
+		texture_cube::size_type BaseFace, texture_cube::size_type MaxFace,
+		texture_cube::size_type BaseLevel, texture_cube::size_type MaxLevel,
+		size_t ThreadCount)
+	{
+		fsamplerCube Sampler(Texture, WRAP_CLAMP_TO_EDGE);
+		texture Storage(Sampler());
+		for(texture_cube::size_type Level = BaseLevel; Level < MaxLevel; ++Level)
+			if(!detail::generate_mipmap_box(Storage, 0, 0, BaseFace, MaxFace, Level, ThreadCount))
+				Sampler.generate_mipmaps(BaseFace, MaxFace, Level, Level + 1, FILTER_LINEAR);
+		return Sampler();
+	}
+
+	inline texture_cube_array generate_mipmaps_box(
+		texture_cube_array const& Texture,
+		texture_cube_array::size_type BaseLayer, texture_cube_array::size_type MaxLayer,
+		texture_cube_array::size_type BaseFace, texture_cube_array::size_type MaxFace,
+		texture_cube_array::size_type BaseLevel, texture_cube_array::size_type MaxLevel,
+		size_t ThreadCount)
+	{
+		fsamplerCubeArray Sampler(Texture, WRAP_CLAMP_TO_EDGE);
+		texture Storage(Sampler());
+		for(texture_cube_array::size_type Level = BaseLevel; Level < MaxLevel; ++Level)
+			if(!detail::generate_mipmap_box(Storage, BaseLayer, MaxLayer, BaseFace, MaxFace, Level, ThreadCount))
+				Sampler.generate_mipmaps(BaseLayer, MaxLayer, BaseFace, MaxFace, Level, Level + 1, FILTER_LINEAR);
+		return Sampler();
+	}
+
+	template <>
+	inline texture1d generate_mipmaps_box<texture1d>(texture1d const& Texture, size_t ThreadCount)
+	{
+		return generate_mipmaps_box(Texture, Texture.base_level(), Texture.max_level(), ThreadCount);
+	}
+
+	template <>
+	inline texture1d_array generate_mipmaps_box<texture1d_array>(texture1d_array const& Texture, size_t ThreadCount)
+	{
+		return generate_mipmaps_box(Texture, Texture.base_layer(), Texture.max_layer(), Texture.base_level(), Texture.max_level(), ThreadCount);
+	}
+
+	template <>
+	inline texture2d generate_mipmaps_box<texture2d>(texture2d const& Texture, size_t ThreadCount)
+	{
+		return generate_mipmaps_box(Texture, Texture.base_level(), Texture.max_level(), ThreadCount);
+	}
+
+	template <>
+	inline texture2d_array generate_mipmaps_box<texture2d_array>(texture2d_array const& Texture, size_t ThreadCount)
+	{
+		return generate_mipmaps_box(Texture, Texture.base_layer(), Texture.max_layer(), Texture.base_level(), Texture.max_level(), ThreadCount);
+	}
+
+	template <>
+	inline texture3d generate_mipmaps_box<texture3d>(texture3d const& Texture, size_t ThreadCount)
+	{
+		return generate_mipmaps_box(Texture, Texture.base_level(), Texture.max_level(), ThreadCount);
+	}
+
+	template <>
+	inline texture_cube generate_mipmaps_box<texture_cube>(texture_cube const& Texture, size_t ThreadCount)
+	{
+		return generate_mipmaps_box(Texture, Texture.base_face(), Texture.max_face(), Texture.base_level(), Texture.max_level(), ThreadCount);
+	}
+
+	template <>
+	inline texture_cube_array generate_mipmaps_box<texture_cube_array>(texture_cube_array const& Texture, size_t ThreadCount)
+	{
+		return generate_mipmaps_box(Texture, Texture.base_layer(), Texture.max_layer(), Texture.base_face(), Texture.max_face(), Texture.base_level(), Texture.max_level(), ThreadCount);
+	}
+
+	inline void set_parallel_run(void (*Run)(size_t WorkerCount, std::function<void()> const& Job))
+	{
+		detail::parallel_run() = Run ? Run : detail::run_threads;
+	}
 }//namespace gli
@@ -5,46 +5,33 @@
 
 namespace gli
 {
+	/// Read the header of a texture (DDS, KTX or KMG) from memory
+	inline texture_header load_header(char const * Data, std::size_t Size)
+	{
+		if(Size >= sizeof(detail::FOURCC_DDS) && strncmp(Data, detail::FOURCC_DDS, 4) == 0)
+			return detail::load_dds_header(Data, Size);
+		if(Size >= sizeof(detail::FOURCC_KMG100) && memcmp(Data, detail::FOURCC_KMG100, sizeof(detail::FOURCC_KMG100)) == 0)
+			return detail::load_kmg_header(Data, Size);
+		if(Size >= sizeof(detail::FOURCC_KTX10) && memcmp(Data, detail::FOURCC_KTX10, sizeof(detail::FOURCC_KTX10)) == 0)
+			return detail::load_ktx_header(Data, Size);
+
+		return texture_header();
+	}
+
 	/// Load a texture (DDS, KTX or KMG) from memory
 	inline texture load(char const * Data, std::size_t Size)
 	{
-		{
-			texture Texture = load_dds(Data, Size);
-			if(!Texture.empty())
-				return Texture;
-		}
-		{
-			texture Texture = load_kmg(Data, Size);
-			if(!Texture.empty())
-				return Texture;
-		}
-		{
-			texture Texture = load_ktx(Data, Size);
-			if(!Texture.empty())
-				return Texture;
-		}
-
-		return texture();
+		return detail::load_texture(Data, Size, load_header(Data, Size), nullptr);
 	}
 
 	/// Load a texture (DDS, KTX or KMG) from file
 	inline texture load(char const * Filename)
 	{
-		FILE* File = detail::open_file(Filename, "rb");
-		if(!File)
+		detail::file_mapping File;
+		if(!File.open(Filename))
 			return texture();
 
-		long Beg = std::ftell(File);
-		std::fseek(File, 0, SEEK_END);
-		long End = std::ftell(File);
-		std::fseek(File, 0, SEEK_SET);
-
-		std::vector<char> Data(static_cast<std::size_t>(End - Beg));
-
-		std::fread(&Data[0], 1, Data.size(), File);
-		std::fclose(File);
-
-		return load(&Data[0], Data.size());
+		return load(File.data(), File.size());
 	}
 
 	/// Load a texture (DDS, KTX or KMG) from file
@@ -52,4 +39,20 @@ namespace gli
 	{
 		return load(Filename.c_str());
 	}
+
+	/// Load a texture (DDS, KTX or KMG) referencing a file mapping
+	inline texture load_mapped(char const * Filename)
+	{
+		std::shared_ptr<detail::file_mapping> const Mapping = detail::map_file(Filename);
+		if(!Mapping)
+			return texture();
+
+		return detail::load_texture(Mapping->data(), Mapping->size(), load_header(Mapping->data(), Mapping->size()), Mapping);
+	}
+
+	/// Load a texture (DDS, KTX or KMG) referencing a file mapping
+	inline texture load_mapped(std::string const & Filename)
+	{
+		return load_mapped(Filename.c_str());
+	}
 }//namespace gli
@@ -1,4 +1,5 @@
 #include "../dx.hpp"
+#include "../texture_header.hpp"
 #include "file.hpp"
 #include <cstdio>
 #include <cassert>
@@ -158,17 +159,18 @@ namespace detail
 			return dx::D3DFMT_AT2N;
 		}
 	}
-}//namespace detail
 
-	inline texture load_dds(char const * Data, std::size_t Size)
+	inline texture_header load_dds_header(char const * Data, std::size_t Size)
 	{
 		GLI_ASSERT(Data && (Size >= sizeof(detail::FOURCC_DDS)));
 
 		if(strncmp(Data, detail::FOURCC_DDS, 4) != 0)
-			return texture();
+			return texture_header();
 		std::size_t Offset = sizeof(detail::FOURCC_DDS);
 
 		GLI_ASSERT(Size >= sizeof(detail::dds_header));
+		if(Size < Offset + sizeof(detail::dds_header))
+			return texture_header();
 
 		detail::dds_header const & Header(*reinterpret_cast<detail::dds_header const *>(Data + Offset));
 		Offset += sizeof(detail::dds_header);
@@ -176,6 +178,8 @@ namespace detail
 		detail::dds_header10 Header10;
 		if((Header.Format.flags & dx::DDPF_FOURCC) && (Header.Format.fourCC == dx::D3DFMT_DX10 || Header.Format.fourCC == dx::D3DFMT_GLI1))
 		{
+			if(Size < Offset + sizeof(detail::dds_header10))
+				return texture_header();
 			std::memcpy(&Header10, Data + Offset, sizeof(Header10));
 			Offset += sizeof(detail::dds_header10);
 		}
@@ -285,36 +289,42 @@ namespace detail
 		if(Header.CubemapFlags & detail::DDSCAPS2_VOLUME)
 			DepthCount = Header.Depth;
 
-		texture Texture(
-			get_target(Header, Header10), Format,
-			texture::extent_type(Header.Width, Header.Height, DepthCount),
-			std::max<texture::size_type>(Header10.ArraySize, 1), FaceCount, MipMapCount);
+		texture_header Result;
+		if(Format == static_cast<format>(gli::FORMAT_INVALID) || Header.Width == 0)
+			return Result;
 
-		std::size_t const SourceSize = Offset + Texture.size();
-		GLI_ASSERT(SourceSize == Size);
+		Result.Target = get_target(Header, Header10);
+		Result.Format = Format;
+		Result.Extent = texture::extent_type(Header.Width, std::max<std::uint32_t>(Header.Height, 1), std::max<size_t>(DepthCount, 1));
+		Result.Layers = std::max<texture::size_type>(Header10.ArraySize, 1);
+		Result.Faces = std::max<size_t>(FaceCount, 1);
+		Result.Levels = std::max<size_t>(MipMapCount, 1);
+		Result.MaxLevel = Result.Levels - 1;
 
-		std::memcpy(Texture.data(), Data + Offset, Texture.size());
+		// The images of a DDS file are laid out as in a texture storage
+		detail::linear_offsets(Result, Offset);
 
-		return Texture;
+		return Result;
 	}
 
-	inline texture load_dds(char const * Filename)
+	inline texture load_dds(char const * Data, std::size_t Size, std::shared_ptr<file_mapping> const& Mapping)
 	{
-		FILE* File = detail::open_file(Filename, "rb");
-		if(!File)
-			return texture();
-
-		long Beg = std::ftell(File);
-		std::fseek(File, 0, SEEK_END);
-		long End = std::ftell(File);
-		std::fseek(File, 0, SEEK_SET);
+		return load_texture(Data, Size, load_dds_header(Data, Size), Mapping);
+	}
+}//namespace detail
 
-		std::vector<char> Data(static_cast<std::size_t>(End - Beg));
+	inline texture load_dds(char const * Data, std::size_t Size)
+	{
+		return detail::load_dds(Data, Size, nullptr);
+	}
 
-		std::fread(&Data[0], 1, Data.size(), File);
-		std::fclose(File);
+	inline texture load_dds(char const * Filename)
+	{
+		detail::file_mapping File;
+		if(!File.open(Filename))
+			return texture();
 
-		return load_dds(&Data[0], Data.size());
+		return load_dds(File.data(), File.size());
 	}
 
 	inline texture load_dds(std::string const & Filename)
@@ -1,3 +1,4 @@
+#include "../texture_header.hpp"
 #include "file.hpp"
 #include <cstdio>
 #include <cassert>
@@ -27,73 +28,67 @@ namespace detail
 		std::uint32_t MaxLevel;
 	};
 
-	inline texture load_kmg100(char const * Data, std::size_t Size)
+	inline texture_header load_kmg_header(char const * Data, std::size_t Size)
 	{
-		detail::kmgHeader10 const & Header(*reinterpret_cast<detail::kmgHeader10 const *>(Data));
+		GLI_ASSERT(Data && (Size >= sizeof(detail::FOURCC_KMG100)));
 
-		size_t Offset = sizeof(detail::kmgHeader10);
-
-		texture Texture(
-			static_cast<target>(Header.Target),
-			static_cast<format>(Header.Format),
-			texture::extent_type(Header.PixelWidth, Header.PixelHeight, Header.PixelDepth),
-			Header.Layers,
-			Header.Faces,
-			Header.Levels,
-			texture::swizzles_type(Header.SwizzleRed, Header.SwizzleGreen, Header.SwizzleBlue, Header.SwizzleAlpha));
-
-		for(texture::size_type Layer = 0, Layers = Texture.layers(); Layer < Layers; ++Layer)
-		for(texture::size_type Level = 0, Levels = Texture.levels(); Level < Levels; ++Level)
+		// KMG100
+		if(Size < sizeof(detail::FOURCC_KMG100) + sizeof(detail::kmgHeader10) || memcmp(Data, detail::FOURCC_KMG100, sizeof(detail::FOURCC_KMG100)) != 0)
+			return texture_header();
+
+		detail::kmgHeader10 const & Header(*reinterpret_cast<detail::kmgHeader10 const *>(Data + sizeof(detail::FOURCC_KMG100)));
+
+		size_t Offset = sizeof(detail::FOURCC_KMG100) + sizeof(detail::kmgHeader10);
+
+		texture_header Result;
+		if(Header.Layers == 0 || Header.Faces == 0 || Header.Levels == 0 || Header.BaseLevel > Header.MaxLevel || Header.MaxLevel >= Header.Levels)
+			return Result;
+
+		Result.Target = static_cast<target>(Header.Target);
+		Result.Format = static_cast<format>(Header.Format);
+		Result.Extent = texture::extent_type(Header.PixelWidth, Header.PixelHeight, Header.PixelDepth);
+		Result.Layers = Header.Layers;
+		Result.Faces = Header.Faces;
+		Result.Levels = Header.Levels;
+		Result.BaseLevel = Header.BaseLevel;
+		Result.MaxLevel = Header.MaxLevel;
+		Result.Swizzles = texture::swizzles_type(Header.SwizzleRed, Header.SwizzleGreen, Header.SwizzleBlue, Header.SwizzleAlpha);
+		Result.Offsets.resize(Result.Layers * Result.Faces * Result.Levels);
+
+		// KMG stores the faces of each level of a layer
+		for(texture::size_type Layer = 0; Layer < Result.Layers; ++Layer)
+		for(texture::size_type Level = 0; Level < Result.Levels; ++Level)
 		{
-			texture::size_type const FaceSize = static_cast<texture::size_type>(Texture.size(Level));
-			for(texture::size_type Face = 0, Faces = Texture.faces(); Face < Faces; ++Face)
+			texture::size_type const FaceSize = Result.level_size(Level);
+			for(texture::size_type Face = 0; Face < Result.Faces; ++Face)
 			{
-				std::memcpy(Texture.data(Layer, Face, Level), Data + Offset, FaceSize);
+				Result.Offsets[((Layer * Result.Faces) + Face) * Result.Levels + Level] = Offset;
 
 				Offset += FaceSize;
-				GLI_ASSERT(Offset <= Size);
 			}
 		}
 
-		return texture(
-			Texture, Texture.target(), Texture.format(),
-			Texture.base_layer(), Texture.max_layer(),
-			Texture.base_face(), Texture.max_face(),
-			Header.BaseLevel, Header.MaxLevel, 
-			Texture.swizzles());
+		return Result;
+	}
+
+	inline texture load_kmg(char const * Data, std::size_t Size, std::shared_ptr<file_mapping> const& Mapping)
+	{
+		return load_texture(Data, Size, load_kmg_header(Data, Size), Mapping);
 	}
 }//namespace detail
 
 	inline texture load_kmg(char const * Data, std::size_t Size)
 	{
-		GLI_ASSERT(Data && (Size >= sizeof(detail::kmgHeader10)));
-
-		// KMG100
-		{
-			if(memcmp(Data, detail::FOURCC_KMG100, sizeof(detail::FOURCC_KMG100)) == 0)
-				return detail::load_kmg100(Data + sizeof(detail::FOURCC_KMG100), Size - sizeof(detail::FOURCC_KMG100));
-		}
-
-		return texture();
+		return detail::load_kmg(Data, Size, nullptr);
 	}
 
 	inline texture load_kmg(char const * Filename)
 	{
-		FILE* File = detail::open_file(Filename, "rb");
-		if(!File)
+		detail::file_mapping File;
+		if(!File.open(Filename))
 			return texture();
 
-		long Beg = std::ftell(File);
-		std::fseek(File, 0, SEEK_END);
-		long End = std::ftell(File);
-		std::fseek(File, 0, SEEK_SET);
-
-		std::vector<char> Data(static_cast<std::size_t>(End - Beg));
-
-		std::fread(&Data[0], 1, Data.size(), File);
-		std::fclose(File);
-
-		return load_kmg(&Data[0], Data.size());
+		return load_kmg(File.data(), File.size());
 	}
 
 	inline texture load_kmg(std::string const & Filename)
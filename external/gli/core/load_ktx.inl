@@ -1,4 +1,5 @@
 #include "../gl.hpp"
+#include "../texture_header.hpp"
 #include "file.hpp"
 #include <cstdio>
 #include <cassert>
@@ -50,11 +51,16 @@ namespace detail
 			return TARGET_2D;
 	}
 
-	inline texture load_ktx10(char const* Data, std::size_t Size)
+	inline texture_header load_ktx_header(char const* Data, std::size_t Size)
 	{
-		detail::ktx_header10 const & Header(*reinterpret_cast<detail::ktx_header10 const*>(Data));
+		GLI_ASSERT(Data && (Size >= sizeof(detail::FOURCC_KTX10)));
 
-		size_t Offset = sizeof(detail::ktx_header10);
+		if(Size < sizeof(detail::FOURCC_KTX10) + sizeof(detail::ktx_header10) || memcmp(Data, detail::FOURCC_KTX10, sizeof(detail::FOURCC_KTX10)) != 0)
+			return texture_header();
+
+		detail::ktx_header10 const & Header(*reinterpret_cast<detail::ktx_header10 const*>(Data + sizeof(detail::FOURCC_KTX10)));
+
+		size_t Offset = sizeof(detail::FOURCC_KTX10) + sizeof(detail::ktx_header10);
 
 		// Skip key value data
 		Offset += Header.BytesOfKeyValueData;
@@ -65,69 +71,62 @@ namespace detail
 			static_cast<gli::gl::external_format>(Header.GLFormat),
 			static_cast<gli::gl::type_format>(Header.GLType));
 		GLI_ASSERT(Format != static_cast<format>(gli::FORMAT_INVALID));
-		
+
+		texture_header Result;
+		if(Format == static_cast<format>(gli::FORMAT_INVALID) || Header.PixelWidth == 0)
+			return Result;
+
+		Result.Target = detail::get_target(Header);
+		Result.Format = Format;
+		Result.Extent = texture::extent_type(
+			Header.PixelWidth,
+			std::max<texture::size_type>(Header.PixelHeight, 1),
+			std::max<texture::size_type>(Header.PixelDepth, 1));
+		Result.Layers = std::max<texture::size_type>(Header.NumberOfArrayElements, 1);
+		Result.Faces = std::max<texture::size_type>(Header.NumberOfFaces, 1);
+		Result.Levels = std::max<texture::size_type>(Header.NumberOfMipmapLevels, 1);
+		Result.MaxLevel = Result.Levels - 1;
+		Result.Offsets.resize(Result.Layers * Result.Faces * Result.Levels);
+
 		texture::size_type const BlockSize = block_size(Format);
 
-		texture Texture(
-			detail::get_target(Header),
-			Format,
-			texture::extent_type(
-				Header.PixelWidth,
-				std::max<texture::size_type>(Header.PixelHeight, 1),
-				std::max<texture::size_type>(Header.PixelDepth, 1)),
-			std::max<texture::size_type>(Header.NumberOfArrayElements, 1),
-			std::max<texture::size_type>(Header.NumberOfFaces, 1),
-			std::max<texture::size_type>(Header.NumberOfMipmapLevels, 1));
-
-		for(texture::size_type Level = 0, Levels = Texture.levels(); Level < Levels; ++Level)
+		// Each level starts with its size, each image is padded to 4 bytes
+		for(texture::size_type Level = 0; Level < Result.Levels; ++Level)
 		{
 			Offset += sizeof(std::uint32_t);
 
-			for(texture::size_type Layer = 0, Layers = Texture.layers(); Layer < Layers; ++Layer)
-			for(texture::size_type Face = 0, Faces = Texture.faces(); Face < Faces; ++Face)
+			for(texture::size_type Layer = 0; Layer < Result.Layers; ++Layer)
+			for(texture::size_type Face = 0; Face < Result.Faces; ++Face)
 			{
-				texture::size_type const FaceSize = Texture.size(Level);
+				texture::size_type const FaceSize = Result.level_size(Level);
 
-				std::memcpy(Texture.data(Layer, Face, Level), Data + Offset, FaceSize);
+				Result.Offsets[((Layer * Result.Faces) + Face) * Result.Levels + Level] = Offset;
 
 				Offset += std::max(BlockSize, glm::ceilMultiple(FaceSize, static_cast<texture::size_type>(4)));
 			}
 		}
 
-		return Texture;
+		return Result;
+	}
+
+	inline texture load_ktx(char const* Data, std::size_t Size, std::shared_ptr<file_mapping> const& Mapping)
+	{
+		return load_texture(Data, Size, load_ktx_header(Data, Size), Mapping);
 	}
 }//namespace detail
 
 	inline texture load_ktx(char const* Data, std::size_t Size)
 	{
-		GLI_ASSERT(Data && (Size >= sizeof(detail::ktx_header10)));
-
-		// KTX10
-		{
-			if(memcmp(Data, detail::FOURCC_KTX10, sizeof(detail::FOURCC_KTX10)) == 0)
-				return detail::load_ktx10(Data + sizeof(detail::FOURCC_KTX10), Size - sizeof(detail::FOURCC_KTX10));
-		}
-
-		return texture();
+		return detail::load_ktx(Data, Size, nullptr);
 	}
 
 	inline texture load_ktx(char const* Filename)
 	{
-		FILE* File = detail::open_file(Filename, "rb");
-		if(!File)
+		detail::file_mapping File;
+		if(!File.open(Filename))
 			return texture();
 
-		long Beg = std::ftell(File);
-		std::fseek(File, 0, SEEK_END);
-		long End = std::ftell(File);
-		std::fseek(File, 0, SEEK_SET);
-
-		std::vector<char> Data(static_cast<std::size_t>(End - Beg));
-
-		std::fread(&Data[0], 1, Data.size(), File);
-		std::fclose(File);
-
-		return load_ktx(&Data[0], Data.size());
+		return load_ktx(File.data(), File.size());
 	}
 
 	inline texture load_ktx(std::string const& Filename)
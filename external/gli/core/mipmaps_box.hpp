@@ -0,0 +1,506 @@
+#pragma once
+
+#include "../texture.hpp"
+#include <glm/gtc/color_space.hpp>
+#include <glm/gtc/packing.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <functional>
+#include <thread>
+#include <vector>
+
+#if GLM_ARCH & GLM_ARCH_AVX2_BIT
+#	include <immintrin.h>
+#elif (GLM_ARCH & GLM_ARCH_AVX_BIT) || defined(__F16C__)
+#	include <immintrin.h>
+#elif GLM_ARCH & GLM_ARCH_SSE2_BIT
+#	include <emmintrin.h>
+#endif
+
+namespace gli{
+namespace detail
+{
+	/// Write DstWidth texels to Dst, each the average of a 1x1, 2x1, 1x2, 2x2, 1x2x2 or 2x2x2 box of source texels.
+	/// Rows are the RowCount source rows of the box, PairX when two source texels of each row are averaged.
+	typedef void (*reduce_row_func)(glm::u8 const* const* Rows, size_t RowCount, bool PairX, glm::u8* Dst, size_t DstWidth);
+
+	/// log2 of the number of texels of a box
+	inline unsigned box_shift(size_t RowCount, bool PairX)
+	{
+		return (RowCount == 4 ? 2u : RowCount == 2 ? 1u : 0u) + (PairX ? 1u : 0u);
+	}
+
+	template <size_t C>
+	inline void reduce_row_unorm8(glm::u8 const* const* Rows, size_t RowCount, bool PairX, glm::u8* Dst, size_t DstWidth)
+	{
+		unsigned const Shift = box_shift(RowCount, PairX);
+		unsigned const Bias = (1u << Shift) >> 1;
+		size_t DstTexel = 0;
+
+		// 16 bits sums of up to 8 bytes, rounded to nearest
+#		if GLM_ARCH & GLM_ARCH_AVX2_BIT
+			if(C == 4 && PairX)
+			{
+				__m256i const Zero = _mm256_setzero_si256();
+				__m256i const Bias256 = _mm256_set1_epi16(static_cast<short>(Bias));
+				__m128i const Shift128 = _mm_cvtsi32_si128(static_cast<int>(Shift));
+				for(; DstTexel + 4 <= DstWidth; DstTexel += 4)
+				{
+					__m256i Low = Zero;
+					__m256i High = Zero;
+					for(size_t Row = 0; Row < RowCount; ++Row)
+					{
+						__m256i const Texels = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(Rows[Row] + DstTexel * 8));
+						Low = _mm256_add_epi16(Low, _mm256_unpacklo_epi8(Texels, Zero));
+						High = _mm256_add_epi16(High, _mm256_unpackhi_epi8(Texels, Zero));
+					}
+
+					// Per 128 bits lane, Low holds the texels 0 and 1 and High the texels 2 and 3
+					__m256i Sum = _mm256_add_epi16(_mm256_unpacklo_epi64(Low, High), _mm256_unpackhi_epi64(Low, High));
+					Sum = _mm256_srl_epi16(_mm256_add_epi16(Sum, Bias256), Shift128);
+					__m256i const Packed = _mm256_permute4x64_epi64(_mm256_packus_epi16(Sum, Sum), 0x08);
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(Dst + DstTexel * 4), _mm256_castsi256_si128(Packed));
+				}
+			}
+#		endif
+
+#		if GLM_ARCH & GLM_ARCH_SSE2_BIT
+			if(C == 4 && PairX)
+			{
+				__m128i const Zero = _mm_setzero_si128();
+				__m128i const Bias128 = _mm_set1_epi16(static_cast<short>(Bias));
+				__m128i const Shift128 = _mm_cvtsi32_si128(static_cast<int>(Shift));
+				for(; DstTexel + 2 <= DstWidth; DstTexel += 2)
+				{
+					__m128i Low = Zero;
+					__m128i High = Zero;
+					for(size_t Row = 0; Row < RowCount; ++Row)
+					{
+						__m128i const Texels = _mm_loadu_si128(reinterpret_cast<__m128i const*>(Rows[Row] + DstTexel * 8));
+						Low = _mm_add_epi16(Low, _mm_unpacklo_epi8(Texels, Zero));
+						High = _mm_add_epi16(High, _mm_unpackhi_epi8(Texels, Zero));
+					}
+
+					__m128i Sum = _mm_add_epi16(_mm_unpacklo_epi64(Low, High), _mm_unpackhi_epi64(Low, High));
+					Sum = _mm_srl_epi16(_mm_add_epi16(Sum, Bias128), Shift128);
+					_mm_storel_epi64(reinterpret_cast<__m128i*>(Dst + DstTexel * 4), _mm_packus_epi16(Sum, Sum));
+				}
+			}
+			else if(C == 3 && PairX)
+			{
+				// Three bytes texels don't align with the registers, the rows are summed 96 bytes at a time and the pairs of
+				// texels are summed from the 16 bits sums
+				__m128i const Zero = _mm_setzero_si128();
+				for(; DstTexel + 16 <= DstWidth; DstTexel += 16)
+				{
+					glm::u16 Sums[96];
+					for(size_t Block = 0; Block < 6; ++Block)
+					{
+						__m128i Low = Zero;
+						__m128i High = Zero;
+						for(size_t Row = 0; Row < RowCount; ++Row)
+						{
+							__m128i const Bytes = _mm_loadu_si128(reinterpret_cast<__m128i const*>(Rows[Row] + DstTexel * 6 + Block * 16));
+							Low = _mm_add_epi16(Low, _mm_unpacklo_epi8(Bytes, Zero));
+							High = _mm_add_epi16(High, _mm_unpackhi_epi8(Bytes, Zero));
+						}
+						_mm_storeu_si128(reinterpret_cast<__m128i*>(Sums + Block * 16), Low);
+						_mm_storeu_si128(reinterpret_cast<__m128i*>(Sums + Block * 16 + 8), High);
+					}
+
+					for(size_t Texel = 0; Texel < 16; ++Texel)
+					for(size_t Channel = 0; Channel < 3; ++Channel)
+						Dst[(DstTexel + Texel) * 3 + Channel] = static_cast<glm::u8>((Sums[Texel * 6 + Channel] + Sums[Texel * 6 + 3 + Channel] + Bias) >> Shift);
+				}
+			}
+#		endif
+
+		for(; DstTexel < DstWidth; ++DstTexel)
+		for(size_t Channel = 0; Channel < C; ++Channel)
+		{
+			size_t const Src = (PairX ? DstTexel * 2 : DstTexel) * C + Channel;
+
+			unsigned Sum = 0;
+			for(size_t Row = 0; Row < RowCount; ++Row)
+				Sum += Rows[Row][Src] + (PairX ? Rows[Row][Src + C] : 0u);
+			Dst[DstTexel * C + Channel] = static_cast<glm::u8>((Sum + Bias) >> Shift);
+		}
+	}
+
+	/// Conversions of sRGB bytes, averaged in linear space
+	struct srgb8_table
+	{
+		srgb8_table()
+		{
+			for(size_t Value = 0; Value < 256; ++Value)
+				this->Linear[Value] = convertSRGBToLinear(vec1(static_cast<float>(Value) / 255.f)).x;
+
+			// Thresholds[Value] is the smallest linear value encoded to Value or more, found by bisection on the bits of
+			// the positive floats which are ordered as integers
+			this->Thresholds[0] = 0.f;
+			for(size_t Value = 1; Value < 256; ++Value)
+			{
+				glm::u32 Low = 0;
+				glm::u32 High = glm::floatBitsToUint(1.f);
+				while(Low < High)
+				{
+					glm::u32 const Middle = Low + (High - Low) / 2;
+					if(encode_exact(glm::uintBitsToFloat(Middle)) >= Value)
+						High = Middle;
+					else
+						Low = Middle + 1;
+				}
+				this->Thresholds[Value] = glm::uintBitsToFloat(Low);
+			}
+
+			// Smallest value of each bucket of linear values, the encoding scans the few thresholds above it
+			for(size_t Bucket = 0, Value = 0; Bucket < BUCKETS; ++Bucket)
+			{
+				while(Value < 255 && this->Thresholds[Value + 1] <= static_cast<float>(Bucket) / static_cast<float>(BUCKETS))
+					++Value;
+				this->Buckets[Bucket] = static_cast<glm::u8>(Value);
+			}
+		}
+
+		static size_t encode_exact(float Linear)
+		{
+			return static_cast<size_t>(convertLinearToSRGB(vec1(Linear)).x * 255.f + 0.5f);
+		}
+
+		glm::u8 encode(float Linear) const
+		{
+			size_t Value = this->Buckets[std::min(static_cast<size_t>(Linear * static_cast<float>(BUCKETS)), BUCKETS - 1)];
+			while(Value < 255 && this->Thresholds[Value + 1] <= Linear)
+				++Value;
+			return static_cast<glm::u8>(Value);
+		}
+
+		static size_t const BUCKETS = 4096;
+
+		float Linear[256];
+		float Thresholds[256];
+		glm::u8 Buckets[BUCKETS];
+	};
+
+	inline srgb8_table const& get_srgb8_table()
+	{
+		static srgb8_table const Table;
+		return Table;
+	}
+
+	template <size_t C>
+	inline void reduce_row_srgb8(glm::u8 const* const* Rows, size_t RowCount, bool PairX, glm::u8* Dst, size_t DstWidth)
+	{
+		srgb8_table const& Table = get_srgb8_table();
+		unsigned const Shift = box_shift(RowCount, PairX);
+		unsigned const Bias = (1u << Shift) >> 1;
+		float const Scale = 1.f / static_cast<float>(1u << Shift);
+
+		for(size_t DstTexel = 0; DstTexel < DstWidth; ++DstTexel)
+		{
+			size_t const Src = (PairX ? DstTexel * 2 : DstTexel) * C;
+
+			for(size_t Channel = 0; Channel < 3; ++Channel)
+			{
+				float Sum = 0.f;
+				for(size_t Row = 0; Row < RowCount; ++Row)
+					Sum += Table.Linear[Rows[Row][Src + Channel]] + (PairX ? Table.Linear[Rows[Row][Src + C + Channel]] : 0.f);
+				Dst[DstTexel * C + Channel] = Table.encode(Sum * Scale);
+			}
+
+			// Alpha is linear
+			if(C == 4)
+			{
+				unsigned Sum = 0;
+				for(size_t Row = 0; Row < RowCount; ++Row)
+					Sum += Rows[Row][Src + 3] + (PairX ? Rows[Row][Src + C + 3] : 0u);
+				Dst[DstTexel * C + 3] = static_cast<glm::u8>((Sum + Bias) >> Shift);
+			}
+		}
+	}
+
+	/// RGBA texels of 32 or 16 bits floats, summed in 32 bits floats: the rows of each texel first, then the pair of texels
+	template <typename component_type>
+	struct float4_texel
+	{
+#		if GLM_ARCH & GLM_ARCH_SSE2_BIT
+			static __m128 load(glm::u8 const* Texel)
+			{
+				return _mm_loadu_ps(reinterpret_cast<float const*>(Texel));
+			}
+
+			static void store(glm::u8* Texel, __m128 Value)
+			{
+				_mm_storeu_ps(reinterpret_cast<float*>(Texel), Value);
+			}
+#		else
+			static vec4 load(glm::u8 const* Texel)
+			{
+				vec4 Value;
+				std::memcpy(&Value[0], Texel, sizeof(Value));
+				return Value;
+			}
+
+			static void store(glm::u8* Texel, vec4 const& Value)
+			{
+				std::memcpy(Texel, &Value[0], sizeof(Value));
+			}
+#		endif
+	};
+
+	template <>
+	struct float4_texel<glm::u16>
+	{
+#		if GLM_ARCH & GLM_ARCH_SSE2_BIT
+			static __m128 load(glm::u8 const* Texel)
+			{
+#				if defined(__F16C__)
+					return _mm_cvtph_ps(_mm_loadl_epi64(reinterpret_cast<__m128i const*>(Texel)));
+#				else
+					glm::uint64 Packed;
+					std::memcpy(&Packed, Texel, sizeof(Packed));
+					vec4 const Value = unpackHalf4x16(Packed);
+					return _mm_loadu_ps(&Value[0]);
+#				endif
+			}
+
+			static void store(glm::u8* Texel, __m128 Value)
+			{
+				// Encoded by GLM whether F16C is available or not so that the levels don't depend on the build
+				vec4 Unpacked;
+				_mm_storeu_ps(&Unpacked[0], Value);
+				glm::uint64 const Packed = packHalf4x16(Unpacked);
+				std::memcpy(Texel, &Packed, sizeof(Packed));
+			}
+#		else
+			static vec4 load(glm::u8 const* Texel)
+			{
+				glm::uint64 Packed;
+				std::memcpy(&Packed, Texel, sizeof(Packed));
+				return unpackHalf4x16(Packed);
+			}
+
+			static void store(glm::u8* Texel, vec4 const& Value)
+			{
+				glm::uint64 const Packed = packHalf4x16(Value);
+				std::memcpy(Texel, &Packed, sizeof(Packed));
+			}
+#		endif
+	};
+
+	template <typename component_type>
+	inline void reduce_row_float4(glm::u8 const* const* Rows, size_t RowCount, bool PairX, glm::u8* Dst, size_t DstWidth)
+	{
+		typedef float4_texel<component_type> texel;
+		size_t const TexelSize = sizeof(component_type) * 4;
+		float const Scale = 1.f / static_cast<float>(1u << box_shift(RowCount, PairX));
+		size_t DstTexel = 0;
+
+#		if GLM_ARCH & GLM_ARCH_AVX_BIT
+			if(sizeof(component_type) == 4 && PairX)
+			{
+				// Two destination texels per iteration, each 256 bits register holds two source texels
+				__m256 const Scale256 = _mm256_set1_ps(Scale);
+				for(; DstTexel + 2 <= DstWidth; DstTexel += 2)
+				{
+					float const* Src = reinterpret_cast<float const*>(Rows[0]) + DstTexel * 8;
+					__m256 Texels01 = _mm256_loadu_ps(Src);
+					__m256 Texels23 = _mm256_loadu_ps(Src + 8);
+					for(size_t Row = 1; Row < RowCount; ++Row)
+					{
+						Src = reinterpret_cast<float const*>(Rows[Row]) + DstTexel * 8;
+						Texels01 = _mm256_add_ps(Texels01, _mm256_loadu_ps(Src));
+						Texels23 = _mm256_add_ps(Texels23, _mm256_loadu_ps(Src + 8));
+					}
+
+					__m256 const Texels02 = _mm256_permute2f128_ps(Texels01, Texels23, 0x20);
+					__m256 const Texels13 = _mm256_permute2f128_ps(Texels01, Texels23, 0x31);
+					_mm256_storeu_ps(reinterpret_cast<float*>(Dst) + DstTexel * 4, _mm256_mul_ps(_mm256_add_ps(Texels02, Texels13), Scale256));
+				}
+			}
+#		endif
+
+#		if GLM_ARCH & GLM_ARCH_SSE2_BIT
+			__m128 const Scale128 = _mm_set1_ps(Scale);
+			for(; DstTexel < DstWidth; ++DstTexel)
+			{
+				size_t const Src = (PairX ? DstTexel * 2 : DstTexel) * TexelSize;
+
+				__m128 Sum0 = texel::load(Rows[0] + Src);
+				for(size_t Row = 1; Row < RowCount; ++Row)
+					Sum0 = _mm_add_ps(Sum0, texel::load(Rows[Row] + Src));
+
+				if(PairX)
+				{
+					__m128 Sum1 = texel::load(Rows[0] + Src + TexelSize);
+					for(size_t Row = 1; Row < RowCount; ++Row)
+						Sum1 = _mm_add_ps(Sum1, texel::load(Rows[Row] + Src + TexelSize));
+					Sum0 = _mm_add_ps(Sum0, Sum1);
+				}
+
+				texel::store(Dst + DstTexel * TexelSize, _mm_mul_ps(Sum0, Scale128));
+			}
+#		else
+			for(; DstTexel < DstWidth; ++DstTexel)
+			{
+				size_t const Src = (PairX ? DstTexel * 2 : DstTexel) * TexelSize;
+
+				vec4 Sum0 = texel::load(Rows[0] + Src);
+				for(size_t Row = 1; Row < RowCount; ++Row)
+					Sum0 += texel::load(Rows[Row] + Src);
+
+				if(PairX)
+				{
+					vec4 Sum1 = texel::load(Rows[0] + Src + TexelSize);
+					for(size_t Row = 1; Row < RowCount; ++Row)
+						Sum1 += texel::load(Rows[Row] + Src + TexelSize);
+					Sum0 += Sum1;
+				}
+
+				texel::store(Dst + DstTexel * TexelSize, Sum0 * Scale);
+			}
+#		endif
+	}
+
+	/// Row kernel of the formats with a box filter fast path, nullptr for the others
+	inline reduce_row_func get_reduce_row(format Format)
+	{
+		switch(Format)
+		{
+		case FORMAT_RGB8_UNORM_PACK8:
+		case FORMAT_BGR8_UNORM_PACK8:
+			return reduce_row_unorm8<3>;
+		case FORMAT_RGBA8_UNORM_PACK8:
+		case FORMAT_BGRA8_UNORM_PACK8:
+			return reduce_row_unorm8<4>;
+		case FORMAT_RGB8_SRGB_PACK8:
+		case FORMAT_BGR8_SRGB_PACK8:
+			return reduce_row_srgb8<3>;
+		case FORMAT_RGBA8_SRGB_PACK8:
+		case FORMAT_BGRA8_SRGB_PACK8:
+			return reduce_row_srgb8<4>;
+		case FORMAT_RGBA16_SFLOAT_PACK16:
+			return reduce_row_float4<glm::u16>;
+		case FORMAT_RGBA32_SFLOAT_PACK32:
+			return reduce_row_float4<float>;
+		default:
+			return nullptr;
+		}
+	}
+
+	/// Call Job on WorkerCount threads, the calling thread included, and return once every call returned
+	typedef void (*parallel_run_func)(size_t WorkerCount, std::function<void()> const& Job);
+
+	/// Default parallel_run, the threads are started for each call
+	inline void run_threads(size_t WorkerCount, std::function<void()> const& Job)
+	{
+		std::vector<std::thread> Threads;
+		Threads.reserve(WorkerCount - 1);
+		for(size_t ThreadIndex = 1; ThreadIndex < WorkerCount; ++ThreadIndex)
+			Threads.push_back(std::thread(Job));
+		Job();
+
+		for(size_t ThreadIndex = 0; ThreadIndex < Threads.size(); ++ThreadIndex)
+			Threads[ThreadIndex].join();
+	}
+
+	/// Runs the rows of parallel_rows, set by gli::set_parallel_run
+	inline parallel_run_func& parallel_run()
+	{
+		static parallel_run_func Run = run_threads;
+		return Run;
+	}
+
+	/// Call Task(Begin, End) over [0, RowCount) from up to MaxThreadCount threads, 0 for the number of hardware threads,
+	/// when the rows hold enough bytes to pay for waking the threads, from the calling thread otherwise
+	template <typename task>
+	inline void parallel_rows(size_t RowCount, size_t RowSize, size_t MaxThreadCount, task const& Task)
+	{
+		size_t const MIN_THREAD_SIZE = 1 << 18;
+
+		if(MaxThreadCount == 0)
+			MaxThreadCount = std::max<unsigned>(std::thread::hardware_concurrency(), 1);
+
+		size_t const ThreadCount = std::min<size_t>(
+			std::min<size_t>(MaxThreadCount, RowCount),
+			std::max<size_t>(RowCount * RowSize / MIN_THREAD_SIZE, 1));
+
+		if(ThreadCount <= 1)
+		{
+			Task(0, RowCount);
+			return;
+		}
+
+		size_t const ChunkSize = std::max<size_t>(RowCount / (ThreadCount * 4), 1);
+		std::atomic<size_t> NextRow(0);
+
+		parallel_run()(ThreadCount, [&]()
+		{
+			for(size_t Begin = NextRow.fetch_add(ChunkSize); Begin < RowCount; Begin = NextRow.fetch_add(ChunkSize))
+				Task(Begin, std::min(Begin + ChunkSize, RowCount));
+		});
+	}
+
+	/// Generate the level Level + 1 of the layers and faces from the level Level with a box filter: each texel is the
+	/// average of the 2x2 or 2x2x2 texels it covers. Returns false without writing when the box filter doesn't apply: a
+	/// format without row kernel or a level not halving each dimension larger than 1.
+	inline bool generate_mipmap_box
+	(
+		texture& Texture,
+		size_t BaseLayer, size_t MaxLayer,
+		size_t BaseFace, size_t MaxFace,
+		size_t Level,
+		size_t ThreadCount
+	)
+	{
+		reduce_row_func const Reduce = get_reduce_row(Texture.format());
+		if(!Reduce)
+			return false;
+
+		texture::extent_type const SrcExtent = Texture.extent(Level);
+		texture::extent_type const DstExtent = Texture.extent(Level + 1);
+		for(texture::extent_type::length_type Axis = 0; Axis < SrcExtent.length(); ++Axis)
+			if(SrcExtent[Axis] != DstExtent[Axis] * 2 && !(SrcExtent[Axis] == 1 && DstExtent[Axis] == 1))
+				return false;
+
+		bool const PairX = SrcExtent.x == DstExtent.x * 2;
+		size_t const RowsY = SrcExtent.y == DstExtent.y * 2 ? 2 : 1;
+		size_t const RowsZ = SrcExtent.z == DstExtent.z * 2 ? 2 : 1;
+
+		size_t const TexelSize = block_size(Texture.format());
+		size_t const SrcRowPitch = SrcExtent.x * TexelSize;
+		size_t const SrcSlicePitch = SrcRowPitch * SrcExtent.y;
+		size_t const DstRowPitch = DstExtent.x * TexelSize;
+		size_t const DstSlicePitch = DstRowPitch * DstExtent.y;
+
+		size_t const Faces = MaxFace - BaseFace + 1;
+		size_t const ImageRows = DstExtent.y * DstExtent.z;
+		size_t const RowCount = (MaxLayer - BaseLayer + 1) * Faces * ImageRows;
+
+		parallel_rows(RowCount, DstRowPitch, ThreadCount, [&](size_t Begin, size_t End)
+		{
+			for(size_t Row = Begin; Row < End; ++Row)
+			{
+				size_t const Image = Row / ImageRows;
+				size_t const Layer = BaseLayer + Image / Faces;
+				size_t const Face = BaseFace + Image % Faces;
+				size_t const y = Row % DstExtent.y;
+				size_t const z = (Row / DstExtent.y) % DstExtent.z;
+
+				glm::u8 const* const Src = Texture.data<glm::u8>(Layer, Face, Level) + z * RowsZ * SrcSlicePitch + y * RowsY * SrcRowPitch;
+				glm::u8* const Dst = Texture.data<glm::u8>(Layer, Face, Level + 1) + z * DstSlicePitch + y * DstRowPitch;
+
+				glm::u8 const* Rows[4];
+				for(size_t SliceIndex = 0; SliceIndex < RowsZ; ++SliceIndex)
+				for(size_t RowIndex = 0; RowIndex < RowsY; ++RowIndex)
+					Rows[SliceIndex * RowsY + RowIndex] = Src + SliceIndex * SrcSlicePitch + RowIndex * SrcRowPitch;
+
+				Reduce(Rows, RowsY * RowsZ, PairX, Dst, DstExtent.x);
+			}
+		});
+
+		return true;
+	}
+}//namespace detail
+}//namespace gli
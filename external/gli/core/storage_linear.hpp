@@ -11,6 +11,7 @@
 
 #include "../type.hpp"
 #include "../format.hpp"
+#include "file.hpp"
 
 // GLM
 #include <glm/gtc/round.hpp>
@@ -42,7 +43,19 @@ namespace gli
 			size_type Faces,
 			size_type Levels);
 
+		/// Reference the images in a file mapping from Offset rather than allocating them.
+		/// The images must be laid out as in an allocated storage, the storage keeps the mapping alive.
+		storage_linear(
+			format_type Format,
+			extent_type const & Extent,
+			size_type Layers,
+			size_type Faces,
+			size_type Levels,
+			std::shared_ptr<detail::file_mapping> const& Mapping,
+			size_type Offset);
+
 		bool empty() const;
+		bool mapped() const;
 		size_type size() const; // Express is bytes
 		size_type layers() const;
 		size_type levels() const;
@@ -92,6 +105,8 @@ namespace gli
 		extent_type const BlockExtent;
 		extent_type const Extent;
 		std::vector<data_type> Data;
+		std::shared_ptr<detail::file_mapping> Mapping;
+		data_type* MappedData;
 	};
 }//namespace gli
 
@@ -8,6 +8,7 @@ namespace gli
 		, BlockCount(0)
 		, BlockExtent(0)
 		, Extent(0)
+		, MappedData(nullptr)
 	{}
 
 	inline storage_linear::storage_linear(format_type Format, extent_type const& Extent, size_type Layers, size_type Faces, size_type Levels)
@@ -18,6 +19,7 @@ namespace gli
 		, BlockCount(glm::ceilMultiple(Extent, gli::block_extent(Format)) / gli::block_extent(Format))
 		, BlockExtent(gli::block_extent(Format))
 		, Extent(Extent)
+		, MappedData(nullptr)
 	{
 		GLI_ASSERT(Layers > 0);
 		GLI_ASSERT(Faces > 0);
@@ -27,9 +29,31 @@ namespace gli
 		this->Data.resize(this->layer_size(0, Faces - 1, 0, Levels - 1) * Layers, 0);
 	}
 
+	inline storage_linear::storage_linear(format_type Format, extent_type const& Extent, size_type Layers, size_type Faces, size_type Levels, std::shared_ptr<detail::file_mapping> const& Mapping, size_type Offset)
+		: Layers(Layers)
+		, Faces(Faces)
+		, Levels(Levels)
+		, BlockSize(gli::block_size(Format))
+		, BlockCount(glm::ceilMultiple(Extent, gli::block_extent(Format)) / gli::block_extent(Format))
+		, BlockExtent(gli::block_extent(Format))
+		, Extent(Extent)
+		, Mapping(Mapping)
+		, MappedData(reinterpret_cast<data_type*>(Mapping->data()) + Offset)
+	{
+		GLI_ASSERT(Layers > 0);
+		GLI_ASSERT(Faces > 0);
+		GLI_ASSERT(Levels > 0);
+		GLI_ASSERT(glm::all(glm::greaterThan(Extent, extent_type(0))));
+	}
+
 	inline bool storage_linear::empty() const
 	{
-		return this->Data.empty();
+		return this->Data.empty() && this->MappedData == nullptr;
+	}
+
+	inline bool storage_linear::mapped() const
+	{
+		return this->MappedData != nullptr;
 	}
 
 	inline storage_linear::size_type storage_linear::layers() const
@@ -75,6 +99,8 @@ namespace gli
 	{
 		GLI_ASSERT(!this->empty());
 
+		if(this->mapped())
+			return this->layer_size(0, this->Faces - 1, 0, this->Levels - 1) * this->Layers;
 		return static_cast<size_type>(this->Data.size());
 	}
 
@@ -82,14 +108,14 @@ namespace gli
 	{
 		GLI_ASSERT(!this->empty());
 
-		return &this->Data[0];
+		return this->mapped() ? this->MappedData : &this->Data[0];
 	}
 
 	inline storage_linear::data_type const* const storage_linear::data() const
 	{
 		GLI_ASSERT(!this->empty());
 
-		return &this->Data[0];
+		return this->mapped() ? this->MappedData : &this->Data[0];
 	}
 
 	inline storage_linear::size_type storage_linear::base_offset(size_type Layer, size_type Face, size_type Level) const
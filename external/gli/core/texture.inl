@@ -93,6 +93,27 @@ namespace gli
 		GLI_ASSERT(Target != TARGET_CUBE_ARRAY || (Target == TARGET_CUBE_ARRAY && this->layers() >= 1 && this->faces() >= 1 && this->extent().y >= 1 && this->extent().z == 1));
 	}
 
+	inline texture::texture
+	(
+		std::shared_ptr<storage_type> const& Storage,
+		target_type Target,
+		format_type Format,
+		swizzles_type const& Swizzles
+	)
+		: Storage(Storage)
+		, Target(Target)
+		, Format(Format)
+		, BaseLayer(0), MaxLayer(Storage->layers() - 1)
+		, BaseFace(0), MaxFace(Storage->faces() - 1)
+		, BaseLevel(0), MaxLevel(Storage->levels() - 1)
+		, Swizzles(Swizzles)
+		, Cache(*Storage, Format, this->base_layer(), this->layers(), this->base_face(), this->max_face(), this->base_level(), this->max_level())
+	{
+		GLI_ASSERT(block_size(Format) == Storage->block_size());
+		GLI_ASSERT(Target != TARGET_CUBE || (Target == TARGET_CUBE && Storage->extent(0).x == Storage->extent(0).y));
+		GLI_ASSERT(Target != TARGET_CUBE_ARRAY || (Target == TARGET_CUBE_ARRAY && Storage->extent(0).x == Storage->extent(0).y));
+	}
+
 	inline bool texture::empty() const
 	{
 		if(this->Storage.get() == nullptr)
@@ -0,0 +1,182 @@
+#include "file.hpp"
+#include <cstring>
+
+namespace gli
+{
+	inline texture_header::texture_header()
+		: Target(static_cast<gli::target>(TARGET_INVALID))
+		, Format(static_cast<gli::format>(FORMAT_INVALID))
+		, Extent(0)
+		, Layers(0)
+		, Faces(0)
+		, Levels(0)
+		, BaseLevel(0)
+		, MaxLevel(0)
+		, Swizzles(SWIZZLE_RED, SWIZZLE_GREEN, SWIZZLE_BLUE, SWIZZLE_ALPHA)
+	{}
+
+	inline bool texture_header::empty() const
+	{
+		return this->Offsets.empty();
+	}
+
+	inline texture_header::extent_type texture_header::extent(size_type Level) const
+	{
+		GLI_ASSERT(Level < this->Levels);
+
+		return glm::max(this->Extent >> extent_type(static_cast<extent_type::value_type>(Level)), extent_type(1));
+	}
+
+	inline texture_header::size_type texture_header::level_size(size_type Level) const
+	{
+		extent_type const BlockExtent = block_extent(this->Format);
+
+		return block_size(this->Format) * glm::compMul(glm::ceilMultiple(this->extent(Level), BlockExtent) / BlockExtent);
+	}
+
+	inline texture_header::size_type texture_header::offset(size_type Layer, size_type Face, size_type Level) const
+	{
+		GLI_ASSERT(Layer < this->Layers && Face < this->Faces && Level < this->Levels);
+
+		return this->Offsets[((Layer * this->Faces) + Face) * this->Levels + Level];
+	}
+
+	inline texture_layout::texture_layout()
+		: Size(0)
+		, Layers(0)
+		, Faces(0)
+	{}
+
+	inline texture_layout::size_type texture_layout::offset(size_type Layer, size_type Face, size_type Level) const
+	{
+		GLI_ASSERT(Layer < this->Layers && Face < this->Faces && Level < this->LevelOffsets.size());
+
+		return this->LevelOffsets[Level] + (Layer * this->Faces + Face) * this->ImageSizes[Level];
+	}
+
+	inline texture_layout make_layout(texture_header const& Header, size_t RowAlignment, size_t LevelAlignment)
+	{
+		GLI_ASSERT(RowAlignment > 0 && LevelAlignment > 0);
+
+		texture_layout Layout;
+		if(Header.empty())
+			return Layout;
+
+		Layout.Layers = Header.Layers;
+		Layout.Faces = Header.Faces;
+		Layout.RowPitches.resize(Header.Levels);
+		Layout.ImageSizes.resize(Header.Levels);
+		Layout.LevelOffsets.resize(Header.Levels);
+
+		texture::extent_type const BlockExtent = block_extent(Header.Format);
+		for(size_t Level = 0; Level < Header.Levels; ++Level)
+		{
+			texture::extent_type const BlockCount = glm::ceilMultiple(Header.extent(Level), BlockExtent) / BlockExtent;
+
+			Layout.RowPitches[Level] = glm::ceilMultiple(block_size(Header.Format) * BlockCount.x, RowAlignment);
+			Layout.ImageSizes[Level] = Layout.RowPitches[Level] * BlockCount.y * BlockCount.z;
+			Layout.LevelOffsets[Level] = glm::ceilMultiple(Layout.Size, LevelAlignment);
+			Layout.Size = Layout.LevelOffsets[Level] + Layout.ImageSizes[Level] * Header.Layers * Header.Faces;
+		}
+
+		return Layout;
+	}
+
+	inline bool copy_images(char const* Data, std::size_t Size, texture_header const& Header, texture_layout const& Layout, void* Destination)
+	{
+		GLI_ASSERT(Layout.Layers == Header.Layers && Layout.Faces == Header.Faces && Layout.LevelOffsets.size() == Header.Levels);
+
+		for(size_t Index = 0; Index < Header.Offsets.size(); ++Index)
+			if(Header.Offsets[Index] > Size || Header.level_size(Index % Header.Levels) > Size - Header.Offsets[Index])
+				return false;
+
+		texture::extent_type const BlockExtent = block_extent(Header.Format);
+		glm::byte* const Dst = static_cast<glm::byte*>(Destination);
+
+		for(size_t Level = 0; Level < Header.Levels; ++Level)
+		{
+			texture::extent_type const BlockCount = glm::ceilMultiple(Header.extent(Level), BlockExtent) / BlockExtent;
+			size_t const RowSize = block_size(Header.Format) * BlockCount.x;
+			size_t const RowCount = BlockCount.y * BlockCount.z;
+
+			for(size_t Layer = 0; Layer < Header.Layers; ++Layer)
+			for(size_t Face = 0; Face < Header.Faces; ++Face)
+			{
+				char const* const ImageSrc = Data + Header.offset(Layer, Face, Level);
+				glm::byte* const ImageDst = Dst + Layout.offset(Layer, Face, Level);
+
+				if(Layout.RowPitches[Level] == RowSize)
+					std::memcpy(ImageDst, ImageSrc, RowSize * RowCount);
+				else for(size_t Row = 0; Row < RowCount; ++Row)
+					std::memcpy(ImageDst + Row * Layout.RowPitches[Level], ImageSrc + Row * RowSize, RowSize);
+			}
+		}
+
+		return true;
+	}
+
+namespace detail
+{
+	/// Offsets of the images in the order of a texture storage: layer, then face, then level
+	inline void linear_offsets(texture_header& Header, size_t Offset)
+	{
+		Header.Offsets.resize(Header.Layers * Header.Faces * Header.Levels);
+		for(size_t Layer = 0, Index = 0; Layer < Header.Layers; ++Layer)
+		for(size_t Face = 0; Face < Header.Faces; ++Face)
+		for(size_t Level = 0; Level < Header.Levels; ++Level, ++Index)
+		{
+			Header.Offsets[Index] = Offset;
+			Offset += Header.level_size(Level);
+		}
+	}
+
+	/// Texture holding the images described by Header. If Mapping holds Data and the images are laid out in the order of a
+	/// texture storage, the texture references the mapping rather than a copy of the images.
+	inline texture load_texture(char const* Data, std::size_t Size, texture_header const& Header, std::shared_ptr<file_mapping> const& Mapping)
+	{
+		if(Header.empty())
+			return texture();
+
+		for(size_t Index = 0; Index < Header.Offsets.size(); ++Index)
+			if(Header.Offsets[Index] > Size || Header.level_size(Index % Header.Levels) > Size - Header.Offsets[Index])
+				return texture();
+
+		texture Texture;
+
+		if(Mapping)
+		{
+			std::shared_ptr<storage_linear> Storage = std::make_shared<storage_linear>(
+				Header.Format, Header.Extent, Header.Layers, Header.Faces, Header.Levels, Mapping, static_cast<std::size_t>(Data - Mapping->data()) + Header.Offsets[0]);
+
+			bool Linear = true;
+			for(size_t Layer = 0; Layer < Header.Layers && Linear; ++Layer)
+			for(size_t Face = 0; Face < Header.Faces && Linear; ++Face)
+			for(size_t Level = 0; Level < Header.Levels && Linear; ++Level)
+				Linear = Header.offset(Layer, Face, Level) == Header.Offsets[0] + Storage->base_offset(Layer, Face, Level);
+
+			if(Linear)
+				Texture = texture(Storage, Header.Target, Header.Format, Header.Swizzles);
+		}
+
+		if(Texture.empty())
+		{
+			Texture = texture(Header.Target, Header.Format, Header.Extent, Header.Layers, Header.Faces, Header.Levels, Header.Swizzles);
+
+			for(size_t Layer = 0; Layer < Header.Layers; ++Layer)
+			for(size_t Face = 0; Face < Header.Faces; ++Face)
+			for(size_t Level = 0; Level < Header.Levels; ++Level)
+				std::memcpy(Texture.data(Layer, Face, Level), Data + Header.offset(Layer, Face, Level), Texture.size(Level));
+		}
+
+		if(Header.BaseLevel == 0 && Header.MaxLevel == Header.Levels - 1)
+			return Texture;
+
+		return texture(
+			Texture, Texture.target(), Texture.format(),
+			Texture.base_layer(), Texture.max_layer(),
+			Texture.base_face(), Texture.max_face(),
+			Header.BaseLevel, Header.MaxLevel,
+			Texture.swizzles());
+	}
+}//namespace detail
+}//namespace gli
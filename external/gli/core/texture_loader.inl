@@ -0,0 +1,204 @@
+#include "../levels.hpp"
+#include <cstring>
+
+namespace gli{
+namespace detail
+{
+	template <typename texture_type>
+	inline texture process_texture(texture_type const& Texture, load_options const& Options)
+	{
+		texture_type Result(Texture);
+
+		if(Options.Format != FORMAT_UNDEFINED && Options.Format != Result.format())
+			Result = gli::convert(Result, Options.Format);
+
+		if(Options.Mipmaps != FILTER_NONE && Result.levels() == 1)
+		{
+			texture Storage(
+				Result.target(), Result.format(), Result.texture::extent(),
+				Result.layers(), Result.faces(), static_cast<size_t>(gli::levels(Result.texture::extent())),
+				Result.swizzles());
+
+			for(size_t Layer = 0; Layer < Result.layers(); ++Layer)
+			for(size_t Face = 0; Face < Result.faces(); ++Face)
+				std::memcpy(Storage.data(Layer, Face, 0), Result.data(Layer, Face, 0), Result.size(0));
+
+			// The loader threads already process several textures at once, the levels of one are generated on its thread
+			if(Options.Mipmaps == FILTER_LINEAR)
+				Result = gli::generate_mipmaps_box(texture_type(Storage), 1);
+			else
+				Result = gli::generate_mipmaps(texture_type(Storage), Options.Mipmaps);
+		}
+
+		return Result;
+	}
+
+	/// Apply Options to Texture, returns an empty texture if Options require to process a compressed texture
+	inline texture process_texture(texture const& Texture, load_options const& Options)
+	{
+		bool const Convert = Options.Format != FORMAT_UNDEFINED && Options.Format != Texture.format();
+		bool const Mipmaps = Options.Mipmaps != FILTER_NONE && Texture.levels() == 1;
+		if(Texture.empty() || (!Convert && !Mipmaps))
+			return Texture;
+
+		if(is_compressed(Texture.format()) || (Convert && is_compressed(Options.Format)))
+			return texture();
+
+		switch(Texture.target())
+		{
+		case TARGET_1D:
+			return process_texture(texture1d(Texture), Options);
+		case TARGET_1D_ARRAY:
+			return process_texture(texture1d_array(Texture), Options);
+		case TARGET_2D:
+			return process_texture(texture2d(Texture), Options);
+		case TARGET_2D_ARRAY:
+			return process_texture(texture2d_array(Texture), Options);
+		case TARGET_3D:
+			return process_texture(texture3d(Texture), Options);
+		case TARGET_CUBE:
+			return process_texture(texture_cube(Texture), Options);
+		case TARGET_CUBE_ARRAY:
+			return process_texture(texture_cube_array(Texture), Options);
+		default:
+			GLI_ASSERT(0);
+			return texture();
+		}
+	}
+}//namespace detail
+
+	inline load_options::load_options()
+		: Format(FORMAT_UNDEFINED)
+		, Mipmaps(FILTER_NONE)
+	{}
+
+	inline load_options::load_options(format Format, filter Mipmaps)
+		: Format(Format)
+		, Mipmaps(Mipmaps)
+	{}
+
+	inline texture_loader::texture_loader(size_type ThreadCount)
+		: Pending(0)
+		, Stop(false)
+	{
+		if(ThreadCount == 0)
+			ThreadCount = std::max<size_type>(std::thread::hardware_concurrency(), 1);
+
+		this->Threads.reserve(ThreadCount);
+		for(size_type ThreadIndex = 0; ThreadIndex < ThreadCount; ++ThreadIndex)
+			this->Threads.push_back(std::thread(&texture_loader::work, this));
+	}
+
+	inline texture_loader::~texture_loader()
+	{
+		{
+			std::lock_guard<std::mutex> Lock(this->Mutex);
+			this->Stop = true;
+		}
+		this->Queued.notify_all();
+
+		for(size_type ThreadIndex = 0; ThreadIndex < this->Threads.size(); ++ThreadIndex)
+			this->Threads[ThreadIndex].join();
+	}
+
+	inline std::future<texture> texture_loader::load(std::string const& Path, load_options const& Options)
+	{
+		return this->load(Path, Options, completion());
+	}
+
+	inline std::future<texture> texture_loader::load(std::string const& Path, load_options const& Options, completion const& Completion)
+	{
+		request Request;
+		Request.Path = Path;
+		Request.Options = Options;
+		Request.Completion = Completion;
+		Request.Promise = std::make_shared<std::promise<texture> >();
+
+		std::future<texture> Future = Request.Promise->get_future();
+		{
+			std::lock_guard<std::mutex> Lock(this->Mutex);
+			this->Requests.push_back(Request);
+			++this->Pending;
+		}
+		this->Queued.notify_one();
+
+		return Future;
+	}
+
+	inline texture_loader::size_type texture_loader::dispatch()
+	{
+		std::deque<done> Completions;
+		{
+			std::lock_guard<std::mutex> Lock(this->Mutex);
+			Completions.swap(this->Completions);
+		}
+
+		// Called without the lock, completions may queue other loads
+		for(size_type CompletionIndex = 0; CompletionIndex < Completions.size(); ++CompletionIndex)
+			Completions[CompletionIndex].Completion(Completions[CompletionIndex].Texture);
+
+		return Completions.size();
+	}
+
+	inline texture_loader::size_type texture_loader::finish()
+	{
+		size_type Count = 0;
+		for(;;)
+		{
+			{
+				std::unique_lock<std::mutex> Lock(this->Mutex);
+				this->Done.wait(Lock, [this]{return this->Pending == 0 || !this->Completions.empty();});
+				if(this->Pending == 0 && this->Completions.empty())
+					return Count;
+			}
+
+			// Dispatch while waiting so that uploads overlap the loads still running
+			Count += this->dispatch();
+		}
+	}
+
+	inline texture_loader::size_type texture_loader::pending() const
+	{
+		std::lock_guard<std::mutex> Lock(this->Mutex);
+		return this->Pending;
+	}
+
+	inline texture_loader::size_type texture_loader::threads() const
+	{
+		return this->Threads.size();
+	}
+
+	inline void texture_loader::work()
+	{
+		for(;;)
+		{
+			request Request;
+			{
+				std::unique_lock<std::mutex> Lock(this->Mutex);
+				this->Queued.wait(Lock, [this]{return this->Stop || !this->Requests.empty();});
+				if(this->Requests.empty())
+					return;
+				Request = this->Requests.front();
+				this->Requests.pop_front();
+			}
+
+			// load() rather than load_mapped() so that the file is read by the loader thread rather than on first access
+			texture const Texture = detail::process_texture(gli::load(Request.Path), Request.Options);
+
+			{
+				// The completion is queued before the future is ready so that a dispatch() after get() calls it
+				std::lock_guard<std::mutex> Lock(this->Mutex);
+				if(Request.Completion)
+				{
+					done Done;
+					Done.Completion = Request.Completion;
+					Done.Texture = Texture;
+					this->Completions.push_back(Done);
+				}
+				Request.Promise->set_value(Texture);
+				--this->Pending;
+			}
+			this->Done.notify_all();
+		}
+	}
+}//namespace gli
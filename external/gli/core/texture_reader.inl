@@ -0,0 +1,207 @@
+#include "file.hpp"
+#include <algorithm>
+#include <vector>
+
+namespace gli{
+namespace detail
+{
+	static std::size_t const DDS_HEADER_SIZE = sizeof(FOURCC_DDS) + sizeof(dds_header) + sizeof(dds_header10);
+	static std::size_t const KTX_HEADER_SIZE = sizeof(FOURCC_KTX10) + sizeof(ktx_header10);
+	static std::size_t const KMG_HEADER_SIZE = sizeof(FOURCC_KMG100) + sizeof(kmgHeader10);
+
+	/// Largest header read by load_header, the images of every container start after it
+	static std::size_t const MAX_HEADER_SIZE =
+		DDS_HEADER_SIZE > KTX_HEADER_SIZE ?
+			(DDS_HEADER_SIZE > KMG_HEADER_SIZE ? DDS_HEADER_SIZE : KMG_HEADER_SIZE) :
+			(KTX_HEADER_SIZE > KMG_HEADER_SIZE ? KTX_HEADER_SIZE : KMG_HEADER_SIZE);
+
+	/// Bytes of the file to read into memory
+	struct read_range
+	{
+		std::size_t Offset;
+		std::size_t Size;
+		glm::byte* Destination;
+	};
+
+	inline bool operator<(read_range const& A, read_range const& B)
+	{
+		return A.Offset < B.Offset;
+	}
+}//namespace detail
+
+	inline texture_subset::texture_subset(texture_header const& Header, size_type BaseLevel, size_type MaxLevel)
+		: BaseLayer(0), MaxLayer(Header.Layers - 1)
+		, BaseFace(0), MaxFace(Header.Faces - 1)
+		, BaseLevel(BaseLevel), MaxLevel(MaxLevel)
+	{}
+
+	inline texture_subset::texture_subset
+	(
+		size_type BaseLayer, size_type MaxLayer,
+		size_type BaseFace, size_type MaxFace,
+		size_type BaseLevel, size_type MaxLevel
+	)
+		: BaseLayer(BaseLayer), MaxLayer(MaxLayer)
+		, BaseFace(BaseFace), MaxFace(MaxFace)
+		, BaseLevel(BaseLevel), MaxLevel(MaxLevel)
+	{}
+
+	inline texture_subset::size_type texture_subset::layers() const
+	{
+		return this->MaxLayer - this->BaseLayer + 1;
+	}
+
+	inline texture_subset::size_type texture_subset::faces() const
+	{
+		return this->MaxFace - this->BaseFace + 1;
+	}
+
+	inline texture_subset::size_type texture_subset::levels() const
+	{
+		return this->MaxLevel - this->BaseLevel + 1;
+	}
+
+	inline texture_reader::texture_reader()
+		: File(nullptr)
+	{}
+
+	inline texture_reader::~texture_reader()
+	{
+		this->close();
+	}
+
+	inline bool texture_reader::open(char const* Filename)
+	{
+		this->close();
+
+		this->File = detail::open_file(Filename, "rb");
+		if(!this->File)
+			return false;
+
+		std::size_t const Size = detail::file_size(this->File);
+
+		char Data[detail::MAX_HEADER_SIZE];
+		std::size_t const HeaderSize = std::min(Size, sizeof(Data));
+		if(detail::seek_file(this->File, 0) && std::fread(Data, 1, HeaderSize, this->File) == HeaderSize)
+			this->Header = load_header(Data, HeaderSize);
+
+		// Check once that every image is in the file, loads only check the subsets
+		bool Valid = !this->Header.empty();
+		for(size_t Index = 0; Valid && Index < this->Header.Offsets.size(); ++Index)
+			Valid = this->Header.Offsets[Index] <= Size && this->Header.level_size(Index % this->Header.Levels) <= Size - this->Header.Offsets[Index];
+
+		if(!Valid)
+			this->close();
+		return Valid;
+	}
+
+	inline bool texture_reader::open(std::string const& Filename)
+	{
+		return this->open(Filename.c_str());
+	}
+
+	inline void texture_reader::close()
+	{
+		if(this->File)
+			std::fclose(this->File);
+		this->File = nullptr;
+		this->Header = texture_header();
+	}
+
+	inline bool texture_reader::empty() const
+	{
+		return this->File == nullptr;
+	}
+
+	inline texture_header const& texture_reader::header() const
+	{
+		return this->Header;
+	}
+
+	inline texture texture_reader::allocate() const
+	{
+		if(this->empty())
+			return texture();
+
+		return texture(
+			this->Header.Target, this->Header.Format, this->Header.Extent,
+			this->Header.Layers, this->Header.Faces, this->Header.Levels,
+			this->Header.Swizzles);
+	}
+
+	inline texture texture_reader::load(texture_subset const& Subset)
+	{
+		if(this->empty())
+			return texture();
+
+		GLI_ASSERT(Subset.BaseLevel <= Subset.MaxLevel && Subset.MaxLevel < this->Header.Levels);
+		if(Subset.BaseLevel > Subset.MaxLevel || Subset.MaxLevel >= this->Header.Levels)
+			return texture();
+
+		texture Texture(
+			this->Header.Target, this->Header.Format, this->Header.extent(Subset.BaseLevel),
+			Subset.layers(), Subset.faces(), Subset.levels(),
+			this->Header.Swizzles);
+
+		if(!this->read(Subset, Texture, Subset.BaseLayer, Subset.BaseFace, Subset.BaseLevel))
+			return texture();
+		return Texture;
+	}
+
+	inline bool texture_reader::load(texture_subset const& Subset, texture& Texture)
+	{
+		if(this->empty())
+			return false;
+
+		GLI_ASSERT(Texture.format() == this->Header.Format);
+		GLI_ASSERT(Texture.layers() == this->Header.Layers && Texture.faces() == this->Header.Faces && Texture.levels() == this->Header.Levels);
+		if(Texture.format() != this->Header.Format || Texture.layers() != this->Header.Layers || Texture.faces() != this->Header.Faces || Texture.levels() != this->Header.Levels)
+			return false;
+
+		return this->read(Subset, Texture, 0, 0, 0);
+	}
+
+	inline bool texture_reader::read(texture_subset const& Subset, texture& Texture, size_type BaseLayer, size_type BaseFace, size_type BaseLevel)
+	{
+		GLI_ASSERT(Subset.BaseLayer <= Subset.MaxLayer && Subset.MaxLayer < this->Header.Layers);
+		GLI_ASSERT(Subset.BaseFace <= Subset.MaxFace && Subset.MaxFace < this->Header.Faces);
+		GLI_ASSERT(Subset.BaseLevel <= Subset.MaxLevel && Subset.MaxLevel < this->Header.Levels);
+		if(Subset.BaseLayer > Subset.MaxLayer || Subset.MaxLayer >= this->Header.Layers ||
+			Subset.BaseFace > Subset.MaxFace || Subset.MaxFace >= this->Header.Faces ||
+			Subset.BaseLevel > Subset.MaxLevel || Subset.MaxLevel >= this->Header.Levels)
+			return false;
+
+		std::vector<detail::read_range> Ranges;
+		Ranges.reserve(Subset.layers() * Subset.faces() * Subset.levels());
+
+		for(size_type Layer = Subset.BaseLayer; Layer <= Subset.MaxLayer; ++Layer)
+		for(size_type Face = Subset.BaseFace; Face <= Subset.MaxFace; ++Face)
+		for(size_type Level = Subset.BaseLevel; Level <= Subset.MaxLevel; ++Level)
+		{
+			detail::read_range Range;
+			Range.Offset = this->Header.offset(Layer, Face, Level);
+			Range.Size = this->Header.level_size(Level);
+			Range.Destination = Texture.data<glm::byte>(Layer - BaseLayer, Face - BaseFace, Level - BaseLevel);
+			Ranges.push_back(Range);
+		}
+
+		// Read in file order, merging images contiguous both in the file and in the texture
+		std::sort(Ranges.begin(), Ranges.end());
+
+		for(std::size_t Index = 0; Index < Ranges.size();)
+		{
+			detail::read_range Range = Ranges[Index++];
+			for(; Index < Ranges.size(); ++Index)
+			{
+				if(Ranges[Index].Offset != Range.Offset + Range.Size || Ranges[Index].Destination != Range.Destination + Range.Size)
+					break;
+				Range.Size += Ranges[Index].Size;
+			}
+
+			if(!detail::seek_file(this->File, Range.Offset) || std::fread(Range.Destination, 1, Range.Size, this->File) != Range.Size)
+				return false;
+		}
+
+		return true;
+	}
+}//namespace gli
@@ -11,6 +11,7 @@
 #include "texture_cube.hpp"
 #include "texture_cube_array.hpp"
 #include "sampler.hpp"
+#include <functional>
 
 namespace gli
 {
@@ -64,6 +65,66 @@ namespace gli
 		texture_cube_array::size_type BaseFace, texture_cube_array::size_type MaxFace,
 		texture_cube_array::size_type BaseLevel, texture_cube_array::size_type MaxLevel,
 		filter Minification);
+
+	/// Allocate a texture and generate all the mipmaps of the texture with a box filter: each texel is the average, rounded
+	/// to nearest, of the 2x2 texels it covers, 2 texels for 1d textures and 2x2x2 texels for 3d textures. Available for RGB8, RGBA8, BGR8 and BGRA8
+	/// UNORM and SRGB, RGBA16_SFLOAT and RGBA32_SFLOAT textures, sRGB texels are averaged in linear space. The levels of
+	/// other formats and the levels which don't halve each dimension larger than 1 are generated with FILTER_LINEAR.
+	/// The rows of a level are split across ThreadCount threads, 0 for the number of hardware threads.
+	template <typename texture_type>
+	texture_type generate_mipmaps_box(texture_type const& Texture, size_t ThreadCount = 0);
+
+	/// Allocate a texture and generate the mipmaps of the texture from the BaseLevel to the MaxLevel included with a box filter.
+	texture1d generate_mipmaps_box(
+		texture1d const& Texture,
+		texture1d::size_type BaseLevel, texture1d::size_type MaxLevel,
+		size_t ThreadCount = 0);
+
+	/// Allocate a texture and generate the mipmaps of the texture from the BaseLayer to the MaxLayer and from the BaseLevel to the MaxLevel included levels with a box filter.
+	texture1d_array generate_mipmaps_box(
+		texture1d_array const& Texture,
+		texture1d_array::size_type BaseLayer, texture1d_array::size_type MaxLayer,
+		texture1d_array::size_type BaseLevel, texture1d_array::size_type MaxLevel,
+		size_t ThreadCount = 0);
+
+	/// Allocate a texture and generate the mipmaps of the texture from the BaseLevel to the MaxLevel included with a box filter.
+	texture2d generate_mipmaps_box(
+		texture2d const& Texture,
+		texture2d::size_type BaseLevel, texture2d::size_type MaxLevel,
+		size_t ThreadCount = 0);
+
+	/// Allocate a texture and generate the mipmaps of the texture from the BaseLayer to the MaxLayer and from the BaseLevel to the MaxLevel included levels with a box filter.
+	texture2d_array generate_mipmaps_box(
+		texture2d_array const& Texture,
+		texture2d_array::size_type BaseLayer, texture2d_array::size_type MaxLayer,
+		texture2d_array::size_type BaseLevel, texture2d_array::size_type MaxLevel,
+		size_t ThreadCount = 0);
+
+	/// Allocate a texture and generate the mipmaps of the texture from the BaseLevel to the MaxLevel included with a box filter.
+	texture3d generate_mipmaps_box(
+		texture3d const& Texture,
+		texture3d::size_type BaseLevel, texture3d::size_type MaxLevel,
+		size_t ThreadCount = 0);
+
+	/// Allocate a texture and generate the mipmaps of the texture from the BaseFace to the MaxFace and from the BaseLevel to the MaxLevel included levels with a box filter.
+	texture_cube generate_mipmaps_box(
+		texture_cube const& Texture,
+		texture_cube::size_type BaseFace, texture_cube::size_type MaxFace,
+		texture_cube::size_type BaseLevel, texture_cube::size_type MaxLevel,
+		size_t ThreadCount = 0);
+
+	/// Allocate a texture and generate the mipmaps of the texture from the BaseLayer to the MaxLayer, from the BaseFace to the MaxFace and from the BaseLevel to the MaxLevel included levels with a box filter.
+	texture_cube_array generate_mipmaps_box(
+		texture_cube_array const& Texture,
+		texture_cube_array::size_type BaseLayer, texture_cube_array::size_type MaxLayer,
+		texture_cube_array::size_type BaseFace, texture_cube_array::size_type MaxFace,
+		texture_cube_array::size_type BaseLevel, texture_cube_array::size_type MaxLevel,
+		size_t ThreadCount = 0);
+
+	/// Run the threads of generate_mipmaps_box on an application thread pool instead of starting them for each level.
+	/// Run(WorkerCount, Job) calls Job on up to WorkerCount threads, the calling thread included, and returns once every
+	/// call returned.
+	void set_parallel_run(void (*Run)(size_t WorkerCount, std::function<void()> const& Job));
 }//namespace gli
 
 #include "./core/generate_mipmaps.inl"
@@ -67,6 +67,8 @@ namespace gli
 #include "transform.hpp"
 
 #include "load.hpp"
+#include "texture_reader.hpp"
+#include "texture_loader.hpp"
 #include "save.hpp"
 
 #include "gl.hpp"
@@ -4,6 +4,7 @@
 #pragma once
 
 #include "texture.hpp"
+#include "texture_header.hpp"
 
 namespace gli
 {
@@ -22,6 +23,26 @@ namespace gli
 	/// @param Data Data of a texture
 	/// @param Size Size of the data
 	texture load(char const* Data, std::size_t Size);
+
+	/// Reads the header of a texture from memory without accessing the images. Returns an empty header in case of failure.
+	/// Used with make_layout and copy_images to copy the images straight to their destination, e.g. a mapped buffer.
+	///
+	/// @param Data Data of a texture
+	/// @param Size Size of the data
+	texture_header load_header(char const* Data, std::size_t Size);
+
+	/// Loads a texture from a file mapping rather than a copy of the file. Returns an empty texture in case of failure.
+	/// When the images are laid out in the file as in a texture storage, the texture references the mapping: loading takes
+	/// the same time whatever the size of the file, and pages are only read when accessed. Otherwise the images are copied
+	/// from the mapping. Writes to a mapped texture are private to the process.
+	///
+	/// @param Path Path of the file to open including filaname and filename extension
+	texture load_mapped(char const* Path);
+
+	/// Loads a texture from a file mapping rather than a copy of the file. Returns an empty texture in case of failure.
+	///
+	/// @param Path Path of the file to open including filaname and filename extension
+	texture load_mapped(std::string const& Path);
 }//namespace gli
 
 #include "./core/load.inl"
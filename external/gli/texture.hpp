@@ -65,6 +65,13 @@ namespace gli
 			format_type Format,
 			swizzles_type const& Swizzles = swizzles_type(SWIZZLE_RED, SWIZZLE_GREEN, SWIZZLE_BLUE, SWIZZLE_ALPHA));
 
+		/// Create a texture object from an existing texture storage_type, for example a storage referencing a file mapping.
+		texture(
+			std::shared_ptr<storage_type> const& Storage,
+			target_type Target,
+			format_type Format,
+			swizzles_type const& Swizzles = swizzles_type(SWIZZLE_RED, SWIZZLE_GREEN, SWIZZLE_BLUE, SWIZZLE_ALPHA));
+
 		virtual ~texture(){}
 
 		/// Return whether the texture instance is empty, no storage_type or description have been assigned to the instance.
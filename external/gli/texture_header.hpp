@@ -0,0 +1,83 @@
+/// @brief Include to describe the images of DDS, KTX or KMG textures without loading them and to copy them to caller memory.
+/// @file gli/texture_header.hpp
+
+#pragma once
+
+#include "texture.hpp"
+
+namespace gli
+{
+	/// Description of the texture stored in a DDS, KTX or KMG container, read from its header without accessing the images.
+	struct texture_header
+	{
+		typedef size_t size_type;
+		typedef texture::extent_type extent_type;
+
+		texture_header();
+
+		/// Return whether the header couldn't be read
+		bool empty() const;
+
+		/// Return the extent in texels of the images of a level
+		extent_type extent(size_type Level) const;
+
+		/// Return the size in bytes of a tightly packed image of a level
+		size_type level_size(size_type Level) const;
+
+		/// Return the offset in bytes of an image from the beginning of the container
+		size_type offset(size_type Layer, size_type Face, size_type Level) const;
+
+		target Target;
+		format Format;
+		extent_type Extent;
+		size_type Layers;
+		size_type Faces;
+		size_type Levels;
+		/// Levels exposed by the texture, KMG containers may store more levels
+		size_type BaseLevel;
+		size_type MaxLevel;
+		swizzles Swizzles;
+		/// Offset of each image in the container, indexed by ((Layer * Faces) + Face) * Levels + Level
+		std::vector<size_type> Offsets;
+	};
+
+	/// Layout of the images of a texture in caller memory.
+	/// Images are ordered by level, then layer, then face: all the images of a level are contiguous so that a level of an
+	/// array or cube map texture can be uploaded with a single call.
+	struct texture_layout
+	{
+		typedef size_t size_type;
+
+		texture_layout();
+
+		/// Return the offset in bytes of an image from the beginning of the destination
+		size_type offset(size_type Layer, size_type Face, size_type Level) const;
+
+		/// Size in bytes of the whole destination
+		size_type Size;
+		/// Bytes from the beginning of a row of blocks to the next one, per level
+		std::vector<size_type> RowPitches;
+		/// Bytes from the beginning of an image to the next one, per level
+		std::vector<size_type> ImageSizes;
+		/// Offset of the first image of each level
+		std::vector<size_type> LevelOffsets;
+		size_type Layers;
+		size_type Faces;
+	};
+
+	/// Compute the layout of the images described by Header in caller memory.
+	///
+	/// @param RowAlignment Each row of blocks starts at a multiple of RowAlignment bytes, e.g. GL_UNPACK_ALIGNMENT
+	/// @param LevelAlignment Each level starts at a multiple of LevelAlignment bytes
+	texture_layout make_layout(texture_header const& Header, size_t RowAlignment = 1, size_t LevelAlignment = 1);
+
+	/// Copy the images of a container to Destination, which must hold at least Layout.Size bytes.
+	/// Every byte of the images is read once and written once, Destination can be a mapped buffer. Returns false if the
+	/// container is too small for Header.
+	///
+	/// @param Data Data of the container Header was read from
+	/// @param Size Size of the data
+	bool copy_images(char const* Data, std::size_t Size, texture_header const& Header, texture_layout const& Layout, void* Destination);
+}//namespace gli
+
+#include "./core/texture_header.inl"
@@ -0,0 +1,106 @@
+/// @brief Include to load textures on a pool of threads and consume them on another thread, e.g. to upload them with OpenGL.
+/// @file gli/texture_loader.hpp
+
+#pragma once
+
+#include "load.hpp"
+#include "convert.hpp"
+#include "generate_mipmaps.hpp"
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace gli
+{
+	/// Work done by the loader threads after reading a texture
+	struct load_options
+	{
+		/// Read the texture as stored
+		load_options();
+
+		/// @param Format Format the texture is converted to, FORMAT_UNDEFINED to keep the stored format
+		/// @param Mipmaps Filter generating the mipmaps of textures stored with a single level, FILTER_NONE to keep a single level.
+		/// FILTER_LINEAR averages the texels with generate_mipmaps_box.
+		load_options(format Format, filter Mipmaps);
+
+		format Format;
+		filter Mipmaps;
+	};
+
+	/// Bounded pool of threads loading textures. Reading the files and processing the textures of several loads overlap.
+	/// A load returns a future of the texture, an empty texture in case of failure. A completion can also be given for
+	/// each load: completions are queued when the loads are done and called by dispatch() on the thread consuming the
+	/// textures, typically the thread of the OpenGL context to upload them.
+	class texture_loader
+	{
+	public:
+		typedef size_t size_type;
+		typedef std::function<void(texture const&)> completion;
+
+		/// @param ThreadCount Number of loader threads, 0 for the number of hardware threads
+		explicit texture_loader(size_type ThreadCount = 0);
+
+		/// Wait for the queued loads, completions not dispatched yet are dropped
+		~texture_loader();
+
+		/// Queue the load of a DDS, KTX or KMG file
+		///
+		/// @param Path Path of the file to open including filaname and filename extension
+		std::future<texture> load(std::string const& Path, load_options const& Options = load_options());
+
+		/// Queue the load of a DDS, KTX or KMG file, Completion is called by dispatch() once the texture is loaded
+		///
+		/// @param Path Path of the file to open including filaname and filename extension
+		std::future<texture> load(std::string const& Path, load_options const& Options, completion const& Completion);
+
+		/// Call the completions of the loads done so far, on the calling thread and in the order the loads are done.
+		/// Returns the number of completions called.
+		size_type dispatch();
+
+		/// Wait for all the queued loads and call their completions. Returns the number of completions called.
+		size_type finish();
+
+		/// Return the number of loads queued or running
+		size_type pending() const;
+
+		/// Return the number of loader threads
+		size_type threads() const;
+
+	private:
+		texture_loader(texture_loader const&);
+		texture_loader& operator=(texture_loader const&);
+
+		struct request
+		{
+			std::string Path;
+			load_options Options;
+			completion Completion;
+			std::shared_ptr<std::promise<texture> > Promise;
+		};
+
+		struct done
+		{
+			completion Completion;
+			texture Texture;
+		};
+
+		void work();
+
+		mutable std::mutex Mutex;
+		/// Signaled when a load is queued or the loader is destroyed
+		std::condition_variable Queued;
+		/// Signaled when a load is done
+		std::condition_variable Done;
+		std::deque<request> Requests;
+		std::deque<done> Completions;
+		size_type Pending;
+		bool Stop;
+		std::vector<std::thread> Threads;
+	};
+}//namespace gli
+
+#include "./core/texture_loader.inl"
@@ -0,0 +1,82 @@
+/// @brief Include to read subsets of the images of DDS, KTX or KMG files, e.g. the smallest levels first for streaming.
+/// @file gli/texture_reader.hpp
+
+#pragma once
+
+#include "load.hpp"
+
+namespace gli
+{
+	/// Layers, faces and levels of a texture to read. Levels are indexed as stored in the container.
+	struct texture_subset
+	{
+		typedef size_t size_type;
+
+		/// All the layers and faces of the levels BaseLevel to MaxLevel
+		texture_subset(texture_header const& Header, size_type BaseLevel, size_type MaxLevel);
+
+		texture_subset(
+			size_type BaseLayer, size_type MaxLayer,
+			size_type BaseFace, size_type MaxFace,
+			size_type BaseLevel, size_type MaxLevel);
+
+		size_type layers() const;
+		size_type faces() const;
+		size_type levels() const;
+
+		size_type BaseLayer;
+		size_type MaxLayer;
+		size_type BaseFace;
+		size_type MaxFace;
+		size_type BaseLevel;
+		size_type MaxLevel;
+	};
+
+	/// Reader of a DDS, KTX or KMG file which only reads the header when opened. Each load seeks to the images of the
+	/// requested subset and reads them, contiguous images with a single read. The file stays open so that finer levels can
+	/// be loaded later on, e.g. the smallest levels for a preview and the largest ones when they are needed.
+	class texture_reader
+	{
+	public:
+		typedef size_t size_type;
+
+		texture_reader();
+		~texture_reader();
+
+		/// Open Filename and read its header. Returns false in case of failure.
+		///
+		/// @param Filename Path of the file to open including filaname and filename extension
+		bool open(char const* Filename);
+		bool open(std::string const& Filename);
+		void close();
+
+		/// Return whether no file is open
+		bool empty() const;
+
+		/// Return the header of the open file
+		texture_header const& header() const;
+
+		/// Return a texture holding all the layers, faces and levels of the file, for loading them incrementally with
+		/// load(Subset, Texture). Images are left uninitialized until loaded.
+		texture allocate() const;
+
+		/// Load the images of Subset in a texture holding only them: its first level is the level Subset.BaseLevel of the
+		/// file. Returns an empty texture in case of failure.
+		texture load(texture_subset const& Subset);
+
+		/// Load the images of Subset in Texture, which holds all the layers, faces and levels of the file as returned by
+		/// allocate(). Images outside of Subset are left unchanged. Returns false in case of failure.
+		bool load(texture_subset const& Subset, texture& Texture);
+
+	private:
+		texture_reader(texture_reader const&);
+		texture_reader& operator=(texture_reader const&);
+
+		bool read(texture_subset const& Subset, texture& Texture, size_type BaseLayer, size_type BaseFace, size_type BaseLevel);
+
+		FILE* File;
+		texture_header Header;
+	};
+}//namespace gli
+
+#include "./core/texture_reader.inl"
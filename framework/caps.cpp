@@ -1,7 +1,72 @@
 #include "caps.hpp"
+#include "extension_set.hpp"
+#include "hash.hpp"
+
+#include <cstdio>
+#include <memory>
+
+namespace
+{
+	glm::u32 const SNAPSHOT_MAGIC = 0x53434C47; // "GLCS"
+	glm::u32 const SNAPSHOT_VERSION = 1;
+
+	/// Reads or writes the fields of a snapshot in the same order
+	class snapshot_stream
+	{
+	public:
+		snapshot_stream(FILE* File, bool Write) :
+			File(File),
+			Write(Write),
+			Valid(File != nullptr)
+		{}
+
+		bool valid() const {return this->Valid;}
+
+		template <typename genType>
+		void operator()(genType & Value)
+		{
+			this->bytes(&Value, sizeof(Value));
+		}
+
+		void operator()(std::string & Value)
+		{
+			glm::u32 Size = static_cast<glm::u32>(Value.size());
+			(*this)(Size);
+			if(!this->Write)
+				Value.resize(this->Valid && Size < (1 << 16) ? Size : 0);
+			if(!Value.empty())
+				this->bytes(&Value[0], Value.size());
+		}
+
+		void bytes(void* Data, std::size_t Size)
+		{
+			if(this->Valid)
+				this->Valid = (this->Write ? fwrite(Data, Size, 1, this->File) : fread(Data, Size, 1, this->File)) == 1;
+		}
+
+	private:
+		FILE* File;
+		bool Write;
+		bool Valid;
+	};
+
+	std::string context_string(GLenum Name)
+	{
+		char const* String = reinterpret_cast<char const*>(glGetString(Name));
+		return String ? String : "";
+	}
+
+	bool& snapshot_enabled()
+	{
+		static bool Enabled = true;
+		return Enabled;
+	}
+}//namespace
 
 bool caps::check(GLint MajorVersionRequire, GLint MinorVersionRequire)
 {
+	this->Version.get();
+
 	return (VersionData.MAJOR_VERSION * 100 + VersionData.MINOR_VERSION * 10)
 		>= (MajorVersionRequire * 100 + MinorVersionRequire * 10);
 }
@@ -70,713 +135,228 @@ void caps::initVersion()
 				VersionData.GLSL450Core = true;
 		}
 	}
+
+	if(this->check(4, 3) || this->Extensions->KHR_debug)
+		glGetIntegerv(GL_CONTEXT_FLAGS, &VersionData.CONTEXT_FLAGS);
 }
 
+
 void caps::initExtensions()
 {
+	this->Version.get();
+
 	memset(&ExtensionData, 0, sizeof(ExtensionData));
 
 	glGetIntegerv(GL_NUM_EXTENSIONS, &VersionData.NUM_EXTENSIONS);
 
 	if((this->VersionData.PROFILE == CORE) || (this->VersionData.PROFILE == COMPATIBILITY))
 	{
-		for (GLint i = 0; i < VersionData.NUM_EXTENSIONS; ++i)
-		{
-			const char* Extension = reinterpret_cast<const char*>(glGetStringi(GL_EXTENSIONS, i));
-			if(!strcmp("GL_ARB_multitexture", Extension)) {
-				ExtensionData.ARB_multitexture = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_transpose_matrix", Extension)) {
-				ExtensionData.ARB_transpose_matrix = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_multisample", Extension)) {
-				ExtensionData.ARB_multisample = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_texture_env_add", Extension)) {
-				ExtensionData.ARB_texture_env_add = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_texture_cube_map", Extension)) {
-				ExtensionData.ARB_texture_cube_map = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_texture_compression", Extension)) {
-				ExtensionData.ARB_texture_compression = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_texture_border_clamp", Extension)) {
-				ExtensionData.ARB_texture_border_clamp = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_point_parameters", Extension)) {
-				ExtensionData.ARB_point_parameters = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_vertex_blend", Extension)) {
-				ExtensionData.ARB_vertex_blend = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_matrix_palette", Extension)) {
-				ExtensionData.ARB_matrix_palette = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_texture_env_combine", Extension)) {
-				ExtensionData.ARB_texture_env_combine = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_texture_env_crossbar", Extension)) {
-				ExtensionData.ARB_texture_env_crossbar = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_texture_env_dot3", Extension)) {
-				ExtensionData.ARB_texture_env_dot3 = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_texture_mirrored_repeat", Extension)) { 
-				ExtensionData.ARB_texture_mirrored_repeat = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_depth_texture", Extension)) {
-				ExtensionData.ARB_depth_texture = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_shadow", Extension)) {
-				ExtensionData.ARB_shadow = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_shadow_ambient", Extension)) {
-				ExtensionData.ARB_shadow_ambient = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_window_pos", Extension)) {
-				ExtensionData.ARB_window_pos = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_vertex_program", Extension)) {
-				ExtensionData.ARB_vertex_program = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_fragment_program", Extension)) {
-				ExtensionData.ARB_fragment_program = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_vertex_buffer_object", Extension)) {
-				ExtensionData.ARB_vertex_buffer_object = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_occlusion_query", Extension)) {
-				ExtensionData.ARB_occlusion_query = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_shader_objects", Extension)) {
-				ExtensionData.ARB_shader_objects = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_vertex_shader", Extension)) {
-				ExtensionData.ARB_vertex_shader = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_fragment_shader", Extension)) {
-				ExtensionData.ARB_fragment_shader = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_shading_language_100", Extension)) {
-				ExtensionData.ARB_shading_language_100 = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_texture_non_power_of_two", Extension)) {
-				ExtensionData.ARB_texture_non_power_of_two = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_point_sprite", Extension)) {
-				ExtensionData.ARB_point_sprite = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_fragment_program_shadow", Extension)) {
-				ExtensionData.ARB_fragment_program_shadow = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_draw_buffers", Extension)) {
-				ExtensionData.ARB_draw_buffers = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_texture_rectangle", Extension)) {
-				ExtensionData.ARB_texture_rectangle = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_color_buffer_float", Extension)) {
-				ExtensionData.ARB_color_buffer_float = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_half_float_pixel", Extension)) {
-				ExtensionData.ARB_half_float_pixel = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_texture_float", Extension)) {
-				ExtensionData.ARB_texture_float = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_pixel_buffer_object", Extension)) {
-				ExtensionData.ARB_pixel_buffer_object = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_depth_buffer_float", Extension)) {
-				ExtensionData.ARB_depth_buffer_float = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_draw_instanced", Extension)) {
-				ExtensionData.ARB_draw_instanced = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_framebuffer_object", Extension)) {
-				ExtensionData.ARB_framebuffer_object = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_framebuffer_sRGB", Extension)) {
-				ExtensionData.ARB_framebuffer_sRGB = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_geometry_shader4", Extension)) {
-				ExtensionData.ARB_geometry_shader4 = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_half_float_vertex", Extension)) {
-				ExtensionData.ARB_half_float_vertex = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_instanced_arrays", Extension)) {
-				ExtensionData.ARB_instanced_arrays = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_map_buffer_range", Extension)) {
-				ExtensionData.ARB_map_buffer_range = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_texture_buffer_object", Extension)) {
-				ExtensionData.ARB_texture_buffer_object = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_texture_compression_rgtc", Extension)) {
-				ExtensionData.ARB_texture_compression_rgtc = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_texture_rg", Extension)) {
-				ExtensionData.ARB_texture_rg = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_vertex_array_object", Extension)) {
-				ExtensionData.ARB_vertex_array_object = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_uniform_buffer_object", Extension)) {
-				ExtensionData.ARB_uniform_buffer_object = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_compatibility", Extension)) {
-				ExtensionData.ARB_compatibility = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_copy_buffer", Extension)) {
-				ExtensionData.ARB_copy_buffer = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_shader_texture_lod", Extension)) {
-				ExtensionData.ARB_shader_texture_lod = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_depth_clamp", Extension)) {
-				ExtensionData.ARB_depth_clamp = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_draw_elements_base_vertex", Extension)) {
-				ExtensionData.ARB_draw_elements_base_vertex = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_fragment_coord_conventions", Extension)) {
-				ExtensionData.ARB_fragment_coord_conventions = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_provoking_vertex", Extension)) {
-				ExtensionData.ARB_provoking_vertex = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_seamless_cube_map", Extension)) {
-				ExtensionData.ARB_seamless_cube_map = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_sync", Extension)) {
-				ExtensionData.ARB_sync = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_texture_multisample", Extension)) {
-				ExtensionData.ARB_texture_multisample = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_vertex_array_bgra", Extension)) {
-				ExtensionData.ARB_vertex_array_bgra = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_draw_buffers_blend", Extension)) {
-				ExtensionData.ARB_draw_buffers_blend = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_sample_shading", Extension)) {
-				ExtensionData.ARB_sample_shading = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_texture_cube_map_array", Extension)) {
-				ExtensionData.ARB_texture_cube_map_array = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_texture_gather", Extension)) {
-				ExtensionData.ARB_texture_gather = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_texture_query_lod", Extension)) {
-				ExtensionData.ARB_texture_query_lod = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_shading_language_include", Extension)) {
-				ExtensionData.ARB_shading_language_include = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_texture_compression_bptc", Extension)) {
-				ExtensionData.ARB_texture_compression_bptc = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_blend_func_extended", Extension)) {
-				ExtensionData.ARB_blend_func_extended = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_explicit_attrib_location", Extension)) {
-				ExtensionData.ARB_explicit_attrib_location = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_occlusion_query2", Extension)) {
-				ExtensionData.ARB_occlusion_query2 = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_sampler_objects", Extension)) {
-				ExtensionData.ARB_sampler_objects = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_shader_bit_encoding", Extension)) {
-				ExtensionData.ARB_shader_bit_encoding = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_texture_rgb10_a2ui", Extension)) {
-				ExtensionData.ARB_texture_rgb10_a2ui = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_texture_swizzle", Extension)) {
-				ExtensionData.ARB_texture_swizzle = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_timer_query", Extension)) {
-				ExtensionData.ARB_timer_query = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_vertex_type_2_10_10_10_rev", Extension)) {
-				ExtensionData.ARB_vertex_type_2_10_10_10_rev = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_draw_indirect", Extension)) {
-				ExtensionData.ARB_draw_indirect = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_gpu_shader5", Extension)) {
-				ExtensionData.ARB_gpu_shader5 = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_gpu_shader_fp64", Extension)) {
-				ExtensionData.ARB_gpu_shader_fp64 = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_shader_subroutine", Extension)) {
-				ExtensionData.ARB_shader_subroutine = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_tessellation_shader", Extension)) {
-				ExtensionData.ARB_tessellation_shader = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_texture_buffer_object_rgb32", Extension)) {
-				ExtensionData.ARB_texture_buffer_object_rgb32 = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_transform_feedback2", Extension)) {
-				ExtensionData.ARB_transform_feedback2 = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_transform_feedback3", Extension)) {
-				ExtensionData.ARB_transform_feedback3 = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_ES2_compatibility", Extension)) {
-				ExtensionData.ARB_ES2_compatibility = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_get_program_binary", Extension)) {
-				ExtensionData.ARB_get_program_binary = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_separate_shader_objects", Extension)) {
-				ExtensionData.ARB_separate_shader_objects = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_shader_precision", Extension)) {
-				ExtensionData.ARB_shader_precision = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_vertex_attrib_64bit", Extension)) {
-				ExtensionData.ARB_vertex_attrib_64bit = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_viewport_array", Extension)) {
-				ExtensionData.ARB_viewport_array = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_cl_event", Extension)) {
-				ExtensionData.ARB_cl_event = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_debug_output", Extension)) {
-				ExtensionData.ARB_debug_output = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_robustness", Extension)) {
-				ExtensionData.ARB_robustness = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_shader_stencil_export", Extension)) {
-				ExtensionData.ARB_shader_stencil_export = true;
-				continue;
-			}
-			if(!strcmp("GL_ARB_base_instance", Extension)) {
-				ExtensionData.ARB_base_instance = true;
-				continue;
-			}
-			else if(!strcmp("GL_ARB_shading_language_420pack", Extension)) {
-				ExtensionData.ARB_shading_language_420pack = true;
-				continue;
-			}
-			else if(!strcmp("GL_ARB_transform_feedback_instanced", Extension)) {
-				ExtensionData.ARB_transform_feedback_instanced = true;
-				continue;
-			}
-			else if(!strcmp("GL_ARB_compressed_texture_pixel_storage", Extension)) {
-				ExtensionData.ARB_compressed_texture_pixel_storage = true;
-				continue;
-			}
-			else if(!strcmp("GL_ARB_conservative_depth", Extension)) {
-				ExtensionData.ARB_conservative_depth = true;
-				continue;
-			}
-			else if(!strcmp("GL_ARB_internalformat_query", Extension)) {
-				ExtensionData.ARB_internalformat_query = true;
-				continue;
-			}
-			else if(!strcmp("GL_ARB_map_buffer_alignment", Extension)) {
-				ExtensionData.ARB_map_buffer_alignment = true;
-				continue;
-			}
-			else if(!strcmp("GL_ARB_shader_atomic_counters", Extension)) {
-				ExtensionData.ARB_shader_atomic_counters = true;
-				continue;
-			}
-			else if(!strcmp("GL_ARB_shader_image_load_store", Extension)) {
-				ExtensionData.ARB_shader_image_load_store = true;
-				continue;
-			}
-			else if(!strcmp("GL_ARB_shading_language_packing", Extension)) {
-				ExtensionData.ARB_shading_language_packing = true;
-				continue;
-			}
-			else if(!strcmp("GL_ARB_texture_storage", Extension)) {
-				ExtensionData.ARB_texture_storage = true;
-				continue;
-			}
-			else if(!strcmp("GL_KHR_texture_compression_astc_hdr", Extension)) {
-				ExtensionData.KHR_texture_compression_astc_hdr = true;
-				continue;
-			}
-			else if(!strcmp("GL_KHR_texture_compression_astc_ldr", Extension)) {
-				ExtensionData.KHR_texture_compression_astc_ldr = true;
-				continue;
-			}
-			else if(!strcmp("GL_KHR_debug", Extension)) {
-				ExtensionData.KHR_debug = true;
-				continue;
-			}
-			else if(!strcmp("GL_ARB_arrays_of_arrays", Extension)) {
-				ExtensionData.ARB_arrays_of_arrays = true;
-				continue;
-			}
-			else if(!strcmp("GL_ARB_clear_buffer_object", Extension))
-				ExtensionData.ARB_clear_buffer_object = true;
-			else if(!strcmp("GL_ARB_compute_shader", Extension))
-				ExtensionData.ARB_compute_shader = true;
-			else if(!strcmp("GL_ARB_copy_image", Extension))
-				ExtensionData.ARB_copy_image = true;
-			else if(!strcmp("GL_ARB_texture_view", Extension))
-				ExtensionData.ARB_texture_view = true;
-			else if(!strcmp("GL_ARB_vertex_attrib_binding", Extension))
-				ExtensionData.ARB_vertex_attrib_binding = true;
-			else if(!strcmp("GL_ARB_robustness_isolation", Extension))
-				ExtensionData.ARB_robustness_isolation = true;
-			else if(!strcmp("GL_ARB_ES3_compatibility", Extension))
-				ExtensionData.ARB_ES3_compatibility = true;
-			else if(!strcmp("GL_ARB_explicit_uniform_location", Extension))
-				ExtensionData.ARB_explicit_uniform_location = true;
-			else if(!strcmp("GL_ARB_fragment_layer_viewport", Extension))
-				ExtensionData.ARB_fragment_layer_viewport = true;
-			else if(!strcmp("GL_ARB_framebuffer_no_attachments", Extension))
-				ExtensionData.ARB_framebuffer_no_attachments = true;
-			else if(!strcmp("GL_ARB_internalformat_query2", Extension))
-				ExtensionData.ARB_internalformat_query2 = true;
-			else if(!strcmp("GL_ARB_invalidate_subdata", Extension))
-				ExtensionData.ARB_invalidate_subdata = true;
-			else if(!strcmp("GL_ARB_multi_draw_indirect", Extension))
-				ExtensionData.ARB_multi_draw_indirect = true;
-			else if(!strcmp("GL_ARB_program_interface_query", Extension))
-				ExtensionData.ARB_program_interface_query = true;
-			else if(!strcmp("GL_ARB_robust_buffer_access_behavior", Extension))
-				ExtensionData.ARB_robust_buffer_access_behavior = true;
-			else if(!strcmp("GL_ARB_shader_image_size", Extension))
-				ExtensionData.ARB_shader_image_size = true;
-			else if(!strcmp("GL_ARB_shader_storage_buffer_object", Extension))
-				ExtensionData.ARB_shader_storage_buffer_object = true;
-			else if(!strcmp("GL_ARB_stencil_texturing", Extension))
-				ExtensionData.ARB_stencil_texturing = true;
-			else if(!strcmp("GL_ARB_texture_buffer_range", Extension))
-				ExtensionData.ARB_texture_buffer_range = true;
-			else if(!strcmp("GL_ARB_texture_query_levels", Extension))
-				ExtensionData.ARB_texture_query_levels = true;
-			else if(!strcmp("GL_ARB_texture_storage_multisample", Extension))
-				ExtensionData.ARB_texture_storage_multisample = true;
-			else if(!strcmp("GL_ARB_buffer_storage", Extension))
-				ExtensionData.ARB_buffer_storage = true;
-			else if(!strcmp("GL_ARB_clear_texture", Extension))
-				ExtensionData.ARB_clear_texture = true;
-			else if(!strcmp("GL_ARB_enhanced_layouts", Extension))
-				ExtensionData.ARB_enhanced_layouts = true;
-			else if(!strcmp("GL_ARB_multi_bind", Extension))
-				ExtensionData.ARB_multi_bind = true;
-			else if(!strcmp("GL_ARB_query_buffer_object", Extension))
-				ExtensionData.ARB_query_buffer_object = true;
-			else if(!strcmp("GL_ARB_texture_mirror_clamp_to_edge", Extension))
-				ExtensionData.ARB_texture_mirror_clamp_to_edge = true;
-			else if(!strcmp("GL_ARB_texture_stencil8", Extension))
-				ExtensionData.ARB_texture_stencil8 = true;
-			else if(!strcmp("GL_ARB_vertex_type_10f_11f_11f_rev", Extension))
-				ExtensionData.ARB_vertex_type_10f_11f_11f_rev = true;
-			else if(!strcmp("GL_ARB_bindless_texture", Extension))
-				ExtensionData.ARB_bindless_texture = true;
-			else if(!strcmp("GL_ARB_compute_variable_group_size", Extension))
-				ExtensionData.ARB_compute_variable_group_size = true;
-			else if(!strcmp("GL_ARB_indirect_parameters", Extension))
-				ExtensionData.ARB_indirect_parameters = true;
-			else if(!strcmp("GL_ARB_seamless_cubemap_per_texture", Extension))
-				ExtensionData.ARB_seamless_cubemap_per_texture = true;
-			else if(!strcmp("GL_ARB_shader_draw_parameters", Extension))
-				ExtensionData.ARB_shader_draw_parameters = true;
-			else if(!strcmp("GL_ARB_shader_group_vote", Extension))
-				ExtensionData.ARB_shader_group_vote = true;
-			else if(!strcmp("GL_ARB_sparse_texture", Extension))
-				ExtensionData.ARB_sparse_texture = true;
-			else if(!strcmp("GL_ARB_ES3_1_compatibility", Extension))
-				ExtensionData.ARB_ES3_1_compatibility = true;
-			else if(!strcmp("GL_ARB_clip_control", Extension))
-				ExtensionData.ARB_clip_control = true;
-			else if(!strcmp("GL_ARB_conditional_render_inverted", Extension))
-				ExtensionData.ARB_conditional_render_inverted = true;
-			else if(!strcmp("GL_ARB_derivative_control", Extension))
-				ExtensionData.ARB_derivative_control = true;
-			else if(!strcmp("GL_ARB_direct_state_access", Extension))
-				ExtensionData.ARB_direct_state_access = true;
-			else if(!strcmp("GL_ARB_get_texture_sub_image", Extension))
-				ExtensionData.ARB_get_texture_sub_image = true;
-			else if(!strcmp("GL_ARB_shader_texture_image_samples", Extension))
-				ExtensionData.ARB_shader_texture_image_samples = true;
-			else if(!strcmp("GL_ARB_texture_barrier", Extension))
-				ExtensionData.ARB_texture_barrier = true;
-			else if(!strcmp("GL_KHR_context_flush_control", Extension))
-				ExtensionData.KHR_context_flush_control = true;
-			else if(!strcmp("GL_KHR_robust_buffer_access_behavior", Extension))
-				ExtensionData.KHR_robust_buffer_access_behavior = true;
-			else if(!strcmp("GL_KHR_robustness", Extension))
-				ExtensionData.KHR_robustness = true;
-			else if(!strcmp("GL_ARB_pipeline_statistics_query", Extension))
-				ExtensionData.ARB_pipeline_statistics_query = true;
-			else if(!strcmp("GL_ARB_sparse_buffer", Extension))
-				ExtensionData.ARB_sparse_buffer = true;
-			else if(!strcmp("GL_ARB_transform_feedback_overflow_query", Extension))
-				ExtensionData.ARB_transform_feedback_overflow_query = true;
-
-			// EXT
-			if(!strcmp("GL_EXT_texture_compression_s3tc", Extension)) {
-				ExtensionData.EXT_texture_compression_s3tc = true;
-				continue;
-			}
-			if(!strcmp("GL_EXT_texture_compression_latc", Extension)) {
-				ExtensionData.EXT_texture_compression_latc = true;
-				continue;
-			}
-			if(!strcmp("GL_EXT_transform_feedback", Extension)) {
-				ExtensionData.EXT_transform_feedback = true;
-				continue;
-			}
-			if(!strcmp("GL_EXT_direct_state_access", Extension)) {
-				ExtensionData.EXT_direct_state_access = true;
-				continue;
-			}
-			if(!strcmp("GL_EXT_texture_filter_anisotropic", Extension)) {
-				ExtensionData.EXT_texture_filter_anisotropic = true;
-				continue;
-			}
-			if(!strcmp("GL_EXT_texture_array", Extension)) {
-				ExtensionData.EXT_texture_array = true;
-				continue;
-			}
-			if(!strcmp("GL_EXT_texture_snorm", Extension)) {
-				ExtensionData.EXT_texture_snorm = true;
-				continue;
-			}
-			if(!strcmp("GL_EXT_texture_sRGB_decode", Extension)) {
-				ExtensionData.EXT_texture_sRGB_decode = true;
-				continue;
-			}
-			if(!strcmp("GL_EXT_framebuffer_multisample_blit_scaled", Extension)) {
-				ExtensionData.EXT_framebuffer_multisample_blit_scaled = true;
-				continue;
-			}
-			if(!strcmp("GL_EXT_shader_integer_mix", Extension)) {
-				ExtensionData.EXT_shader_integer_mix = true;
-				continue;
-			}
-			if(!strcmp("GL_EXT_polygon_offset_clamp", Extension)) {
-				ExtensionData.EXT_polygon_offset_clamp = true;
-				continue;
-			}
-
-			// NV
-			if(!strcmp("GL_NV_explicit_multisample", Extension)) {
-				ExtensionData.NV_explicit_multisample = true;
-				continue;
-			}
-			if(!strcmp("GL_NV_shader_buffer_load", Extension)) {
-				ExtensionData.NV_shader_buffer_load = true;
-				continue;
-			}
-			if(!strcmp("GL_NV_vertex_buffer_unified_memory", Extension)) {
-				ExtensionData.NV_vertex_buffer_unified_memory = true;
-				continue;
-			}
-			if(!strcmp("GL_NV_shader_buffer_store", Extension)) {
-				ExtensionData.NV_shader_buffer_store = true;
-				continue;
-			}
-			if(!strcmp("GL_NV_bindless_multi_draw_indirect", Extension)) {
-				ExtensionData.NV_bindless_multi_draw_indirect = true;
-				continue;
-			}
-			if(!strcmp("GL_NV_blend_equation_advanced", Extension)) {
-				ExtensionData.NV_blend_equation_advanced = true;
-				continue;
-			}
-			if(!strcmp("GL_NV_deep_texture3D", Extension)) {
-				ExtensionData.NV_deep_texture3D = true;
-				continue;
-			}
-			if(!strcmp("GL_NV_shader_thread_group", Extension)) {
-				ExtensionData.NV_shader_thread_group = true;
-				continue;
-			}
-			if(!strcmp("GL_NV_shader_thread_shuffle", Extension)) {
-				ExtensionData.NV_shader_thread_shuffle = true;
-				continue;
-			}
-			if(!strcmp("GL_NV_shader_atomic_int64", Extension)) {
-				ExtensionData.NV_shader_atomic_int64 = true;
-				continue;
-			}
-			if(!strcmp("GL_NV_bindless_multi_draw_indirect_count", Extension)) {
-				ExtensionData.NV_bindless_multi_draw_indirect_count = true;
-				continue;
-			}
-			if(!strcmp("GL_NV_uniform_buffer_unified_memory", Extension)) {
-				ExtensionData.NV_uniform_buffer_unified_memory = true;
-				continue;
-			}
-
-			// AMD
-
-			if(!strcmp("GL_ATI_texture_compression_3dc", Extension)) {
-				ExtensionData.ATI_texture_compression_3dc = true;
-				continue;
-			}
-			if(!strcmp("GL_AMD_depth_clamp_separate", Extension)) {
-				ExtensionData.AMD_depth_clamp_separate = true;
-				continue;
-			}
-			if(!strcmp("GL_AMD_stencil_operation_extended", Extension)) {
-				ExtensionData.AMD_stencil_operation_extended = true;
-				continue;
-			}
-			if(!strcmp("GL_AMD_vertex_shader_viewport_index", Extension)) {
-				ExtensionData.AMD_vertex_shader_viewport_index = true;
-				continue;
-			}
-			if(!strcmp("GL_AMD_vertex_shader_layer", Extension)) {
-				ExtensionData.AMD_vertex_shader_layer = true;
-				continue;
-			}
-			if(!strcmp("GL_AMD_shader_trinary_minmax", Extension)) {
-				ExtensionData.AMD_shader_trinary_minmax = true;
-				continue;
-			}
-			if(!strcmp("GL_AMD_interleaved_elements", Extension)) {
-				ExtensionData.AMD_interleaved_elements = true;
-				continue;
-			}
-			if(!strcmp("GL_AMD_shader_atomic_counter_ops", Extension)) {
-				ExtensionData.AMD_shader_atomic_counter_ops = true;
-				continue;
-			}
-			if(!strcmp("GL_AMD_shader_stencil_value_export", Extension)) {
-				ExtensionData.AMD_shader_stencil_value_export = true;
-				continue;
-			}
-			if(!strcmp("GL_AMD_transform_feedback4", Extension)) {
-				ExtensionData.AMD_transform_feedback4 = true;
-				continue;
-			}
-			if(!strcmp("GL_AMD_gpu_shader_int64", Extension)) {
-				ExtensionData.AMD_gpu_shader_int64 = true;
-				continue;
-			}
-			if(!strcmp("GL_AMD_gcn_shader", Extension)) {
-				ExtensionData.AMD_gcn_shader = true;
-				continue;
-			}
-
-			// Intel
-			if(!strcmp("GL_INTEL_map_texture", Extension)) {
-				ExtensionData.INTEL_map_texture = true;
-				continue;
-			}
-			if(!strcmp("GL_INTEL_fragment_shader_ordering", Extension)) {
-				ExtensionData.INTEL_fragment_shader_ordering = true;
-				continue;
-			}
-			if(!strcmp("GL_INTEL_performance_query", Extension)) {
-				ExtensionData.INTEL_performance_query = true;
-				continue;
-			}
-		}
+		extension_set const & Supported = get_extension_set();
+
+		ExtensionData.ARB_multitexture = Supported.contains("GL_ARB_multitexture");
+		ExtensionData.ARB_transpose_matrix = Supported.contains("GL_ARB_transpose_matrix");
+		ExtensionData.ARB_multisample = Supported.contains("GL_ARB_multisample");
+		ExtensionData.ARB_texture_env_add = Supported.contains("GL_ARB_texture_env_add");
+		ExtensionData.ARB_texture_cube_map = Supported.contains("GL_ARB_texture_cube_map");
+		ExtensionData.ARB_texture_compression = Supported.contains("GL_ARB_texture_compression");
+		ExtensionData.ARB_texture_border_clamp = Supported.contains("GL_ARB_texture_border_clamp");
+		ExtensionData.ARB_point_parameters = Supported.contains("GL_ARB_point_parameters");
+		ExtensionData.ARB_vertex_blend = Supported.contains("GL_ARB_vertex_blend");
+		ExtensionData.ARB_matrix_palette = Supported.contains("GL_ARB_matrix_palette");
+		ExtensionData.ARB_texture_env_combine = Supported.contains("GL_ARB_texture_env_combine");
+		ExtensionData.ARB_texture_env_crossbar = Supported.contains("GL_ARB_texture_env_crossbar");
+		ExtensionData.ARB_texture_env_dot3 = Supported.contains("GL_ARB_texture_env_dot3");
+		ExtensionData.ARB_texture_mirrored_repeat = Supported.contains("GL_ARB_texture_mirrored_repeat");
+		ExtensionData.ARB_depth_texture = Supported.contains("GL_ARB_depth_texture");
+		ExtensionData.ARB_shadow = Supported.contains("GL_ARB_shadow");
+		ExtensionData.ARB_shadow_ambient = Supported.contains("GL_ARB_shadow_ambient");
+		ExtensionData.ARB_window_pos = Supported.contains("GL_ARB_window_pos");
+		ExtensionData.ARB_vertex_program = Supported.contains("GL_ARB_vertex_program");
+		ExtensionData.ARB_fragment_program = Supported.contains("GL_ARB_fragment_program");
+		ExtensionData.ARB_vertex_buffer_object = Supported.contains("GL_ARB_vertex_buffer_object");
+		ExtensionData.ARB_occlusion_query = Supported.contains("GL_ARB_occlusion_query");
+		ExtensionData.ARB_shader_objects = Supported.contains("GL_ARB_shader_objects");
+		ExtensionData.ARB_vertex_shader = Supported.contains("GL_ARB_vertex_shader");
+		ExtensionData.ARB_fragment_shader = Supported.contains("GL_ARB_fragment_shader");
+		ExtensionData.ARB_shading_language_100 = Supported.contains("GL_ARB_shading_language_100");
+		ExtensionData.ARB_texture_non_power_of_two = Supported.contains("GL_ARB_texture_non_power_of_two");
+		ExtensionData.ARB_point_sprite = Supported.contains("GL_ARB_point_sprite");
+		ExtensionData.ARB_fragment_program_shadow = Supported.contains("GL_ARB_fragment_program_shadow");
+		ExtensionData.ARB_draw_buffers = Supported.contains("GL_ARB_draw_buffers");
+		ExtensionData.ARB_texture_rectangle = Supported.contains("GL_ARB_texture_rectangle");
+		ExtensionData.ARB_color_buffer_float = Supported.contains("GL_ARB_color_buffer_float");
+		ExtensionData.ARB_half_float_pixel = Supported.contains("GL_ARB_half_float_pixel");
+		ExtensionData.ARB_texture_float = Supported.contains("GL_ARB_texture_float");
+		ExtensionData.ARB_pixel_buffer_object = Supported.contains("GL_ARB_pixel_buffer_object");
+		ExtensionData.ARB_depth_buffer_float = Supported.contains("GL_ARB_depth_buffer_float");
+		ExtensionData.ARB_draw_instanced = Supported.contains("GL_ARB_draw_instanced");
+		ExtensionData.ARB_framebuffer_object = Supported.contains("GL_ARB_framebuffer_object");
+		ExtensionData.ARB_framebuffer_sRGB = Supported.contains("GL_ARB_framebuffer_sRGB");
+		ExtensionData.ARB_geometry_shader4 = Supported.contains("GL_ARB_geometry_shader4");
+		ExtensionData.ARB_half_float_vertex = Supported.contains("GL_ARB_half_float_vertex");
+		ExtensionData.ARB_instanced_arrays = Supported.contains("GL_ARB_instanced_arrays");
+		ExtensionData.ARB_map_buffer_range = Supported.contains("GL_ARB_map_buffer_range");
+		ExtensionData.ARB_texture_buffer_object = Supported.contains("GL_ARB_texture_buffer_object");
+		ExtensionData.ARB_texture_compression_rgtc = Supported.contains("GL_ARB_texture_compression_rgtc");
+		ExtensionData.ARB_texture_rg = Supported.contains("GL_ARB_texture_rg");
+		ExtensionData.ARB_vertex_array_object = Supported.contains("GL_ARB_vertex_array_object");
+		ExtensionData.ARB_uniform_buffer_object = Supported.contains("GL_ARB_uniform_buffer_object");
+		ExtensionData.ARB_compatibility = Supported.contains("GL_ARB_compatibility");
+		ExtensionData.ARB_copy_buffer = Supported.contains("GL_ARB_copy_buffer");
+		ExtensionData.ARB_shader_texture_lod = Supported.contains("GL_ARB_shader_texture_lod");
+		ExtensionData.ARB_depth_clamp = Supported.contains("GL_ARB_depth_clamp");
+		ExtensionData.ARB_draw_elements_base_vertex = Supported.contains("GL_ARB_draw_elements_base_vertex");
+		ExtensionData.ARB_fragment_coord_conventions = Supported.contains("GL_ARB_fragment_coord_conventions");
+		ExtensionData.ARB_provoking_vertex = Supported.contains("GL_ARB_provoking_vertex");
+		ExtensionData.ARB_seamless_cube_map = Supported.contains("GL_ARB_seamless_cube_map");
+		ExtensionData.ARB_sync = Supported.contains("GL_ARB_sync");
+		ExtensionData.ARB_texture_multisample = Supported.contains("GL_ARB_texture_multisample");
+		ExtensionData.ARB_vertex_array_bgra = Supported.contains("GL_ARB_vertex_array_bgra");
+		ExtensionData.ARB_draw_buffers_blend = Supported.contains("GL_ARB_draw_buffers_blend");
+		ExtensionData.ARB_sample_shading = Supported.contains("GL_ARB_sample_shading");
+		ExtensionData.ARB_texture_cube_map_array = Supported.contains("GL_ARB_texture_cube_map_array");
+		ExtensionData.ARB_texture_gather = Supported.contains("GL_ARB_texture_gather");
+		ExtensionData.ARB_texture_query_lod = Supported.contains("GL_ARB_texture_query_lod");
+		ExtensionData.ARB_shading_language_include = Supported.contains("GL_ARB_shading_language_include");
+		ExtensionData.ARB_texture_compression_bptc = Supported.contains("GL_ARB_texture_compression_bptc");
+		ExtensionData.ARB_blend_func_extended = Supported.contains("GL_ARB_blend_func_extended");
+		ExtensionData.ARB_explicit_attrib_location = Supported.contains("GL_ARB_explicit_attrib_location");
+		ExtensionData.ARB_occlusion_query2 = Supported.contains("GL_ARB_occlusion_query2");
+		ExtensionData.ARB_sampler_objects = Supported.contains("GL_ARB_sampler_objects");
+		ExtensionData.ARB_shader_bit_encoding = Supported.contains("GL_ARB_shader_bit_encoding");
+		ExtensionData.ARB_texture_rgb10_a2ui = Supported.contains("GL_ARB_texture_rgb10_a2ui");
+		ExtensionData.ARB_texture_swizzle = Supported.contains("GL_ARB_texture_swizzle");
+		ExtensionData.ARB_timer_query = Supported.contains("GL_ARB_timer_query");
+		ExtensionData.ARB_vertex_type_2_10_10_10_rev = Supported.contains("GL_ARB_vertex_type_2_10_10_10_rev");
+		ExtensionData.ARB_draw_indirect = Supported.contains("GL_ARB_draw_indirect");
+		ExtensionData.ARB_gpu_shader5 = Supported.contains("GL_ARB_gpu_shader5");
+		ExtensionData.ARB_gpu_shader_fp64 = Supported.contains("GL_ARB_gpu_shader_fp64");
+		ExtensionData.ARB_shader_subroutine = Supported.contains("GL_ARB_shader_subroutine");
+		ExtensionData.ARB_tessellation_shader = Supported.contains("GL_ARB_tessellation_shader");
+		ExtensionData.ARB_texture_buffer_object_rgb32 = Supported.contains("GL_ARB_texture_buffer_object_rgb32");
+		ExtensionData.ARB_transform_feedback2 = Supported.contains("GL_ARB_transform_feedback2");
+		ExtensionData.ARB_transform_feedback3 = Supported.contains("GL_ARB_transform_feedback3");
+		ExtensionData.ARB_ES2_compatibility = Supported.contains("GL_ARB_ES2_compatibility");
+		ExtensionData.ARB_get_program_binary = Supported.contains("GL_ARB_get_program_binary");
+		ExtensionData.ARB_separate_shader_objects = Supported.contains("GL_ARB_separate_shader_objects");
+		ExtensionData.ARB_shader_precision = Supported.contains("GL_ARB_shader_precision");
+		ExtensionData.ARB_vertex_attrib_64bit = Supported.contains("GL_ARB_vertex_attrib_64bit");
+		ExtensionData.ARB_viewport_array = Supported.contains("GL_ARB_viewport_array");
+		ExtensionData.ARB_cl_event = Supported.contains("GL_ARB_cl_event");
+		ExtensionData.ARB_debug_output = Supported.contains("GL_ARB_debug_output");
+		ExtensionData.ARB_robustness = Supported.contains("GL_ARB_robustness");
+		ExtensionData.ARB_shader_stencil_export = Supported.contains("GL_ARB_shader_stencil_export");
+		ExtensionData.ARB_base_instance = Supported.contains("GL_ARB_base_instance");
+		ExtensionData.ARB_shading_language_420pack = Supported.contains("GL_ARB_shading_language_420pack");
+		ExtensionData.ARB_transform_feedback_instanced = Supported.contains("GL_ARB_transform_feedback_instanced");
+		ExtensionData.ARB_compressed_texture_pixel_storage = Supported.contains("GL_ARB_compressed_texture_pixel_storage");
+		ExtensionData.ARB_conservative_depth = Supported.contains("GL_ARB_conservative_depth");
+		ExtensionData.ARB_internalformat_query = Supported.contains("GL_ARB_internalformat_query");
+		ExtensionData.ARB_map_buffer_alignment = Supported.contains("GL_ARB_map_buffer_alignment");
+		ExtensionData.ARB_shader_atomic_counters = Supported.contains("GL_ARB_shader_atomic_counters");
+		ExtensionData.ARB_shader_image_load_store = Supported.contains("GL_ARB_shader_image_load_store");
+		ExtensionData.ARB_shading_language_packing = Supported.contains("GL_ARB_shading_language_packing");
+		ExtensionData.ARB_texture_storage = Supported.contains("GL_ARB_texture_storage");
+		ExtensionData.KHR_texture_compression_astc_hdr = Supported.contains("GL_KHR_texture_compression_astc_hdr");
+		ExtensionData.KHR_texture_compression_astc_ldr = Supported.contains("GL_KHR_texture_compression_astc_ldr");
+		ExtensionData.KHR_debug = Supported.contains("GL_KHR_debug");
+		ExtensionData.ARB_arrays_of_arrays = Supported.contains("GL_ARB_arrays_of_arrays");
+		ExtensionData.ARB_clear_buffer_object = Supported.contains("GL_ARB_clear_buffer_object");
+		ExtensionData.ARB_compute_shader = Supported.contains("GL_ARB_compute_shader");
+		ExtensionData.ARB_copy_image = Supported.contains("GL_ARB_copy_image");
+		ExtensionData.ARB_texture_view = Supported.contains("GL_ARB_texture_view");
+		ExtensionData.ARB_vertex_attrib_binding = Supported.contains("GL_ARB_vertex_attrib_binding");
+		ExtensionData.ARB_robustness_isolation = Supported.contains("GL_ARB_robustness_isolation");
+		ExtensionData.ARB_ES3_compatibility = Supported.contains("GL_ARB_ES3_compatibility");
+		ExtensionData.ARB_explicit_uniform_location = Supported.contains("GL_ARB_explicit_uniform_location");
+		ExtensionData.ARB_fragment_layer_viewport = Supported.contains("GL_ARB_fragment_layer_viewport");
+		ExtensionData.ARB_framebuffer_no_attachments = Supported.contains("GL_ARB_framebuffer_no_attachments");
+		ExtensionData.ARB_internalformat_query2 = Supported.contains("GL_ARB_internalformat_query2");
+		ExtensionData.ARB_invalidate_subdata = Supported.contains("GL_ARB_invalidate_subdata");
+		ExtensionData.ARB_multi_draw_indirect = Supported.contains("GL_ARB_multi_draw_indirect");
+		ExtensionData.ARB_program_interface_query = Supported.contains("GL_ARB_program_interface_query");
+		ExtensionData.ARB_robust_buffer_access_behavior = Supported.contains("GL_ARB_robust_buffer_access_behavior");
+		ExtensionData.ARB_shader_image_size = Supported.contains("GL_ARB_shader_image_size");
+		ExtensionData.ARB_shader_storage_buffer_object = Supported.contains("GL_ARB_shader_storage_buffer_object");
+		ExtensionData.ARB_stencil_texturing = Supported.contains("GL_ARB_stencil_texturing");
+		ExtensionData.ARB_texture_buffer_range = Supported.contains("GL_ARB_texture_buffer_range");
+		ExtensionData.ARB_texture_query_levels = Supported.contains("GL_ARB_texture_query_levels");
+		ExtensionData.ARB_texture_storage_multisample = Supported.contains("GL_ARB_texture_storage_multisample");
+		ExtensionData.ARB_buffer_storage = Supported.contains("GL_ARB_buffer_storage");
+		ExtensionData.ARB_clear_texture = Supported.contains("GL_ARB_clear_texture");
+		ExtensionData.ARB_enhanced_layouts = Supported.contains("GL_ARB_enhanced_layouts");
+		ExtensionData.ARB_multi_bind = Supported.contains("GL_ARB_multi_bind");
+		ExtensionData.ARB_query_buffer_object = Supported.contains("GL_ARB_query_buffer_object");
+		ExtensionData.ARB_texture_mirror_clamp_to_edge = Supported.contains("GL_ARB_texture_mirror_clamp_to_edge");
+		ExtensionData.ARB_texture_stencil8 = Supported.contains("GL_ARB_texture_stencil8");
+		ExtensionData.ARB_vertex_type_10f_11f_11f_rev = Supported.contains("GL_ARB_vertex_type_10f_11f_11f_rev");
+		ExtensionData.ARB_bindless_texture = Supported.contains("GL_ARB_bindless_texture");
+		ExtensionData.ARB_compute_variable_group_size = Supported.contains("GL_ARB_compute_variable_group_size");
+		ExtensionData.ARB_indirect_parameters = Supported.contains("GL_ARB_indirect_parameters");
+		ExtensionData.ARB_seamless_cubemap_per_texture = Supported.contains("GL_ARB_seamless_cubemap_per_texture");
+		ExtensionData.ARB_shader_draw_parameters = Supported.contains("GL_ARB_shader_draw_parameters");
+		ExtensionData.ARB_shader_group_vote = Supported.contains("GL_ARB_shader_group_vote");
+		ExtensionData.ARB_sparse_texture = Supported.contains("GL_ARB_sparse_texture");
+		ExtensionData.ARB_ES3_1_compatibility = Supported.contains("GL_ARB_ES3_1_compatibility");
+		ExtensionData.ARB_clip_control = Supported.contains("GL_ARB_clip_control");
+		ExtensionData.ARB_conditional_render_inverted = Supported.contains("GL_ARB_conditional_render_inverted");
+		ExtensionData.ARB_derivative_control = Supported.contains("GL_ARB_derivative_control");
+		ExtensionData.ARB_direct_state_access = Supported.contains("GL_ARB_direct_state_access");
+		ExtensionData.ARB_get_texture_sub_image = Supported.contains("GL_ARB_get_texture_sub_image");
+		ExtensionData.ARB_shader_texture_image_samples = Supported.contains("GL_ARB_shader_texture_image_samples");
+		ExtensionData.ARB_texture_barrier = Supported.contains("GL_ARB_texture_barrier");
+		ExtensionData.KHR_context_flush_control = Supported.contains("GL_KHR_context_flush_control");
+		ExtensionData.KHR_robust_buffer_access_behavior = Supported.contains("GL_KHR_robust_buffer_access_behavior");
+		ExtensionData.KHR_robustness = Supported.contains("GL_KHR_robustness");
+		ExtensionData.ARB_pipeline_statistics_query = Supported.contains("GL_ARB_pipeline_statistics_query");
+		ExtensionData.ARB_sparse_buffer = Supported.contains("GL_ARB_sparse_buffer");
+		ExtensionData.ARB_transform_feedback_overflow_query = Supported.contains("GL_ARB_transform_feedback_overflow_query");
+
+		// EXT
+		ExtensionData.EXT_texture_compression_s3tc = Supported.contains("GL_EXT_texture_compression_s3tc");
+		ExtensionData.EXT_texture_compression_latc = Supported.contains("GL_EXT_texture_compression_latc");
+		ExtensionData.EXT_transform_feedback = Supported.contains("GL_EXT_transform_feedback");
+		ExtensionData.EXT_direct_state_access = Supported.contains("GL_EXT_direct_state_access");
+		ExtensionData.EXT_texture_filter_anisotropic = Supported.contains("GL_EXT_texture_filter_anisotropic");
+		ExtensionData.EXT_texture_array = Supported.contains("GL_EXT_texture_array");
+		ExtensionData.EXT_texture_snorm = Supported.contains("GL_EXT_texture_snorm");
+		ExtensionData.EXT_texture_sRGB_decode = Supported.contains("GL_EXT_texture_sRGB_decode");
+		ExtensionData.EXT_framebuffer_multisample_blit_scaled = Supported.contains("GL_EXT_framebuffer_multisample_blit_scaled");
+		ExtensionData.EXT_shader_integer_mix = Supported.contains("GL_EXT_shader_integer_mix");
+		ExtensionData.EXT_polygon_offset_clamp = Supported.contains("GL_EXT_polygon_offset_clamp");
+
+		// NV
+		ExtensionData.NV_explicit_multisample = Supported.contains("GL_NV_explicit_multisample");
+		ExtensionData.NV_shader_buffer_load = Supported.contains("GL_NV_shader_buffer_load");
+		ExtensionData.NV_vertex_buffer_unified_memory = Supported.contains("GL_NV_vertex_buffer_unified_memory");
+		ExtensionData.NV_shader_buffer_store = Supported.contains("GL_NV_shader_buffer_store");
+		ExtensionData.NV_bindless_multi_draw_indirect = Supported.contains("GL_NV_bindless_multi_draw_indirect");
+		ExtensionData.NV_blend_equation_advanced = Supported.contains("GL_NV_blend_equation_advanced");
+		ExtensionData.NV_deep_texture3D = Supported.contains("GL_NV_deep_texture3D");
+		ExtensionData.NV_shader_thread_group = Supported.contains("GL_NV_shader_thread_group");
+		ExtensionData.NV_shader_thread_shuffle = Supported.contains("GL_NV_shader_thread_shuffle");
+		ExtensionData.NV_shader_atomic_int64 = Supported.contains("GL_NV_shader_atomic_int64");
+		ExtensionData.NV_bindless_multi_draw_indirect_count = Supported.contains("GL_NV_bindless_multi_draw_indirect_count");
+		ExtensionData.NV_uniform_buffer_unified_memory = Supported.contains("GL_NV_uniform_buffer_unified_memory");
+
+		// AMD
+		ExtensionData.ATI_texture_compression_3dc = Supported.contains("GL_ATI_texture_compression_3dc");
+		ExtensionData.AMD_depth_clamp_separate = Supported.contains("GL_AMD_depth_clamp_separate");
+		ExtensionData.AMD_stencil_operation_extended = Supported.contains("GL_AMD_stencil_operation_extended");
+		ExtensionData.AMD_vertex_shader_viewport_index = Supported.contains("GL_AMD_vertex_shader_viewport_index");
+		ExtensionData.AMD_vertex_shader_layer = Supported.contains("GL_AMD_vertex_shader_layer");
+		ExtensionData.AMD_shader_trinary_minmax = Supported.contains("GL_AMD_shader_trinary_minmax");
+		ExtensionData.AMD_interleaved_elements = Supported.contains("GL_AMD_interleaved_elements");
+		ExtensionData.AMD_shader_atomic_counter_ops = Supported.contains("GL_AMD_shader_atomic_counter_ops");
+		ExtensionData.AMD_shader_stencil_value_export = Supported.contains("GL_AMD_shader_stencil_value_export");
+		ExtensionData.AMD_transform_feedback4 = Supported.contains("GL_AMD_transform_feedback4");
+		ExtensionData.AMD_gpu_shader_int64 = Supported.contains("GL_AMD_gpu_shader_int64");
+		ExtensionData.AMD_gcn_shader = Supported.contains("GL_AMD_gcn_shader");
+
+		// Intel
+		ExtensionData.INTEL_map_texture = Supported.contains("GL_INTEL_map_texture");
+		ExtensionData.INTEL_fragment_shader_ordering = Supported.contains("GL_INTEL_fragment_shader_ordering");
+		ExtensionData.INTEL_performance_query = Supported.contains("GL_INTEL_performance_query");
 	}
 }
 
@@ -792,6 +372,8 @@ void caps::initDebug()
 
 void caps::initLimits()
 {
+	this->Extensions.get();
+
 	memset(&LimitsData, 0, sizeof(LimitsData));
 
 	if(check(4, 3) || ExtensionData.ARB_compute_shader)
@@ -1014,6 +596,8 @@ void caps::initLimits()
 
 void caps::initValues()
 {
+	this->Extensions.get();
+
 	memset(&ValuesData, 0, sizeof(ValuesData));
 
 	if(check(2, 1))
@@ -1338,23 +922,165 @@ void caps::initFormats()
 	}
 }
 
+caps::caps(profile const & Profile, no_snapshot) :
+	VersionData(Profile),
+	Loaded(false),
+	Version(*this, VersionData, &caps::initVersion),
+	Extensions(*this, ExtensionData, &caps::initExtensions),
+	Debug(*this, DebugData, &caps::initDebug),
+	Limits(*this, LimitsData, &caps::initLimits),
+	Values(*this, ValuesData, &caps::initValues),
+	Formats(*this, FormatsData, &caps::initFormats)
+{}
+
 caps::caps(profile const & Profile) :
 	VersionData(Profile),
-	Version(VersionData),
-	Extensions(ExtensionData),
-	Debug(DebugData),
-	Limits(LimitsData),
-	Values(ValuesData),
-	Formats(FormatsData)
+	Loaded(false),
+	Version(*this, VersionData, &caps::initVersion),
+	Extensions(*this, ExtensionData, &caps::initExtensions),
+	Debug(*this, DebugData, &caps::initDebug),
+	Limits(*this, LimitsData, &caps::initLimits),
+	Values(*this, ValuesData, &caps::initValues),
+	Formats(*this, FormatsData, &caps::initFormats)
 {
-	this->initVersion();
-	this->initExtensions();
+	if(!snapshot_enabled())
+		return;
 
-	if(this->check(4, 3) || Extensions.KHR_debug)
-		glGetIntegerv(GL_CONTEXT_FLAGS, &VersionData.CONTEXT_FLAGS);
+	std::string const Path = getBinaryDirectory() + this->snapshotName();
+	if(!this->load(Path))
+		this->save(Path);
+}
+
+caps::caps(profile const & Profile, std::string const & Snapshot) :
+	VersionData(Profile),
+	Loaded(false),
+	Version(*this, VersionData, &caps::initVersion),
+	Extensions(*this, ExtensionData, &caps::initExtensions),
+	Debug(*this, DebugData, &caps::initDebug),
+	Limits(*this, LimitsData, &caps::initLimits),
+	Values(*this, ValuesData, &caps::initValues),
+	Formats(*this, FormatsData, &caps::initFormats)
+{
+	if(this->load(Snapshot, false))
+		return;
+
+	// Without a context, an access to a group must not query it
+	this->ExtensionData = extensions();
+	this->DebugData = debug();
+	this->LimitsData = limits();
+	this->ValuesData = values();
+	this->FormatsData = formats();
+
+	this->Version.Loaded = true;
+	this->Extensions.Loaded = true;
+	this->Debug.Loaded = true;
+	this->Limits.Loaded = true;
+	this->Values.Loaded = true;
+	this->Formats.Loaded = true;
+}
 
-	this->initDebug();
-	this->initLimits();
-	this->initValues();
-	this->initFormats();
+void caps::setSnapshotEnabled(bool Enabled)
+{
+	snapshot_enabled() = Enabled;
+}
+
+std::string caps::snapshotName() const
+{
+	std::string const Context = context_string(GL_RENDERER) + "\n" + context_string(GL_VERSION);
+	glm::u64 const Hash = hash64(Context.data(), Context.size(), static_cast<glm::u64>(VersionData.PROFILE));
+	return format("caps-%016llx.bin", static_cast<unsigned long long>(Hash));
+}
+
+bool caps::save(std::string const & Filename) const
+{
+	caps & Caps = const_cast<caps &>(*this);
+	Caps.Version.get();
+	Caps.Extensions.get();
+	Caps.Debug.get();
+	Caps.Limits.get();
+	Caps.Values.get();
+	Caps.Formats.get();
+
+	FILE* File = fopen(Filename.c_str(), "wb");
+	snapshot_stream Stream(File, true);
+	Caps.transfer(Stream);
+
+	bool const Written = Stream.valid();
+	return File && fclose(File) == 0 && Written;
+}
+
+bool caps::load(std::string const & Filename, bool MatchContext)
+{
+	FILE* File = fopen(Filename.c_str(), "rb");
+	if(!File)
+		return false;
+
+	// Loaded in a copy so that a truncated or mismatching snapshot leaves the groups untouched
+	std::unique_ptr<caps> Snapshot(new caps(this->VersionData.PROFILE, no_snapshot()));
+	snapshot_stream Stream(File, false);
+	bool const Valid = Snapshot->transfer(Stream) && Stream.valid();
+	fclose(File);
+
+	if(!Valid || Snapshot->VersionData.PROFILE != this->VersionData.PROFILE)
+		return false;
+	if(MatchContext && (Snapshot->VersionData.RENDERER != context_string(GL_RENDERER) || Snapshot->VersionData.VERSION != context_string(GL_VERSION)))
+		return false;
+
+	this->VersionData = Snapshot->VersionData;
+	this->ExtensionData = Snapshot->ExtensionData;
+	this->DebugData = Snapshot->DebugData;
+	this->LimitsData = Snapshot->LimitsData;
+	this->ValuesData = Snapshot->ValuesData;
+	this->FormatsData = Snapshot->FormatsData;
+
+	this->Version.Loaded = true;
+	this->Extensions.Loaded = true;
+	this->Debug.Loaded = true;
+	this->Limits.Loaded = true;
+	this->Values.Loaded = true;
+	this->Formats.Loaded = true;
+	this->Loaded = true;
+
+	return true;
+}
+
+template <typename stream>
+bool caps::transfer(stream & Stream)
+{
+	glm::u32 Header[] = {SNAPSHOT_MAGIC, SNAPSHOT_VERSION,
+		sizeof(extensions), sizeof(debug), sizeof(limits), sizeof(values), sizeof(formats)};
+	glm::u32 const Expected[] = {SNAPSHOT_MAGIC, SNAPSHOT_VERSION,
+		sizeof(extensions), sizeof(debug), sizeof(limits), sizeof(values), sizeof(formats)};
+	Stream(Header);
+	if(!Stream.valid() || memcmp(Header, Expected, sizeof(Header)) != 0)
+		return false;
+
+	version & Data = this->VersionData;
+	Stream(Data.PROFILE);
+	Stream(Data.MINOR_VERSION);
+	Stream(Data.MAJOR_VERSION);
+	Stream(Data.CONTEXT_FLAGS);
+	Stream(Data.NUM_EXTENSIONS);
+	Stream(Data.RENDERER);
+	Stream(Data.VENDOR);
+	Stream(Data.VERSION);
+	Stream(Data.SHADING_LANGUAGE_VERSION);
+	Stream(Data.NUM_SHADING_LANGUAGE_VERSIONS);
+	bool* GLSL[] = {
+		&Data.GLSL100, &Data.GLSL110, &Data.GLSL120, &Data.GLSL130, &Data.GLSL140,
+		&Data.GLSL150Core, &Data.GLSL150Comp, &Data.GLSL300ES, &Data.GLSL330Core, &Data.GLSL330Comp,
+		&Data.GLSL400Core, &Data.GLSL400Comp, &Data.GLSL410Core, &Data.GLSL410Comp,
+		&Data.GLSL420Core, &Data.GLSL420Comp, &Data.GLSL430Core, &Data.GLSL430Comp,
+		&Data.GLSL440Core, &Data.GLSL440Comp, &Data.GLSL450Core, &Data.GLSL450Comp};
+	for(std::size_t Index = 0; Index < sizeof(GLSL) / sizeof(GLSL[0]); ++Index)
+		Stream(*GLSL[Index]);
+
+	// The other groups only hold plain values
+	Stream(this->ExtensionData);
+	Stream(this->DebugData);
+	Stream(this->LimitsData);
+	Stream(this->ValuesData);
+	Stream(this->FormatsData);
+
+	return Stream.valid();
 }
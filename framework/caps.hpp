@@ -12,6 +12,43 @@ struct caps
 		ES = 0x00000004
 	};
 
+	/// Group of capabilities queried on first access, e.g. Caps.Limits->MAX_VERTEX_ATTRIBS
+	template <typename data>
+	class group
+	{
+	public:
+		group(caps & Caps, data & Data, void (caps::*Init)()) :
+			Caps(Caps),
+			Data(Data),
+			Init(Init),
+			Loaded(false)
+		{}
+
+		data const * operator->() const {return &this->get();}
+		data const & operator*() const {return this->get();}
+
+		data const & get() const
+		{
+			// Set first, the queries of a group may check the group itself
+			if(!this->Loaded)
+			{
+				this->Loaded = true;
+				(this->Caps.*this->Init)();
+			}
+			return this->Data;
+		}
+
+		bool loaded() const {return this->Loaded;}
+
+	private:
+		friend struct caps;
+
+		caps & Caps;
+		data & Data;
+		void (caps::*Init)();
+		mutable bool Loaded;
+	};
+
 private:
 	bool check(GLint MajorVersionRequire, GLint MinorVersionRequire);
 
@@ -22,7 +59,30 @@ private:
 			MINOR_VERSION(0),
 			MAJOR_VERSION(0),
 			CONTEXT_FLAGS(0),
-			NUM_EXTENSIONS(0)
+			NUM_EXTENSIONS(0),
+			NUM_SHADING_LANGUAGE_VERSIONS(0),
+			GLSL100(false),
+			GLSL110(false),
+			GLSL120(false),
+			GLSL130(false),
+			GLSL140(false),
+			GLSL150Core(false),
+			GLSL150Comp(false),
+			GLSL300ES(false),
+			GLSL330Core(false),
+			GLSL330Comp(false),
+			GLSL400Core(false),
+			GLSL400Comp(false),
+			GLSL410Core(false),
+			GLSL410Comp(false),
+			GLSL420Core(false),
+			GLSL420Comp(false),
+			GLSL430Core(false),
+			GLSL430Comp(false),
+			GLSL440Core(false),
+			GLSL440Comp(false),
+			GLSL450Core(false),
+			GLSL450Comp(false)
 		{}
 		profile PROFILE;
 		GLint MINOR_VERSION;
@@ -524,14 +584,47 @@ private:
 
 	void initFormats();
 
+	/// Reads or writes every group, in the snapshot order
+	template <typename stream>
+	bool transfer(stream & Stream);
+
+	struct no_snapshot {};
+	/// Lazy groups without the snapshot of the binary directory
+	caps(profile const & Profile, no_snapshot);
+
+	caps(caps const &);
+	caps& operator=(caps const &);
+
+	bool Loaded;
+
 public:
+	/// Loads the snapshot of the current context from the binary directory. Without one, every group is queried once
+	/// and the snapshot is written for the next runs. When snapshots are disabled, no query is issued until a group is
+	/// accessed.
 	caps(profile const & Profile);
-
-	version const & Version;
-	extensions const & Extensions;
-	debug const & Debug;
-	limits const & Limits;
-	values const & Values;
-	formats const & Formats;
+	/// Capabilities recorded by save(), no OpenGL context is required. When the snapshot can't be loaded, loaded()
+	/// returns false and the groups are left empty rather than queried.
+	caps(profile const & Profile, std::string const & Snapshot);
+
+	/// Enabled by default, --no-caps-snapshot disables it
+	static void setSnapshotEnabled(bool Enabled);
+
+	/// The groups were read from a snapshot
+	bool loaded() const {return this->Loaded;}
+
+	/// Queries every group and writes them with the GL_RENDERER and GL_VERSION strings they were queried with
+	bool save(std::string const & Filename) const;
+	/// Replaces the groups with a snapshot. With MatchContext, the snapshot is only loaded when it was recorded with
+	/// the GL_RENDERER and GL_VERSION of the current context.
+	bool load(std::string const & Filename, bool MatchContext = true);
+	/// File name of the snapshot of the current context, a hash of GL_RENDERER, GL_VERSION and the profile
+	std::string snapshotName() const;
+
+	group<version> const Version;
+	group<extensions> const Extensions;
+	group<debug> const Debug;
+	group<limits> const Limits;
+	group<values> const Values;
+	group<formats> const Formats;
 };
 
@@ -0,0 +1,93 @@
+#include "compare.hpp"
+#include "hash.hpp"
+#include <glm/integer.hpp>
+
+#if GLM_ARCH & GLM_ARCH_AVX2_BIT
+#	include <immintrin.h>
+#elif GLM_ARCH & GLM_ARCH_SSE2_BIT
+#	include <emmintrin.h>
+#endif
+
+namespace
+{
+#	if GLM_ARCH & GLM_ARCH_SSE2_BIT
+		// Bytes of the returned mask are set where |A - B| <= Threshold
+		inline int within_mask(__m128i A, __m128i B, __m128i Threshold)
+		{
+			__m128i const Diff = _mm_or_si128(_mm_subs_epu8(A, B), _mm_subs_epu8(B, A));
+			return _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_max_epu8(Diff, Threshold), Threshold));
+		}
+#	endif
+
+#	if GLM_ARCH & GLM_ARCH_AVX2_BIT
+		inline int within_mask(__m256i A, __m256i B, __m256i Threshold)
+		{
+			__m256i const Diff = _mm256_or_si256(_mm256_subs_epu8(A, B), _mm256_subs_epu8(B, A));
+			return _mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_max_epu8(Diff, Threshold), Threshold));
+		}
+#	endif
+}//namespace
+
+std::size_t find_absolute_difference(glm::u8 const* A, glm::u8 const* B, std::size_t Offset, std::size_t Size, glm::u8 Threshold)
+{
+#	if GLM_ARCH & GLM_ARCH_AVX2_BIT
+	{
+		__m256i const Threshold256 = _mm256_set1_epi8(static_cast<char>(Threshold));
+		for(; Offset + 32 <= Size; Offset += 32)
+		{
+			__m256i const RowA = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(A + Offset));
+			__m256i const RowB = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(B + Offset));
+			int const Mask = within_mask(RowA, RowB, Threshold256);
+			if(Mask != -1)
+				return Offset + glm::findLSB(~Mask);
+		}
+	}
+#	endif
+
+#	if GLM_ARCH & GLM_ARCH_SSE2_BIT
+	{
+		__m128i const Threshold128 = _mm_set1_epi8(static_cast<char>(Threshold));
+		for(; Offset + 16 <= Size; Offset += 16)
+		{
+			__m128i const RowA = _mm_loadu_si128(reinterpret_cast<__m128i const*>(A + Offset));
+			__m128i const RowB = _mm_loadu_si128(reinterpret_cast<__m128i const*>(B + Offset));
+			int const Mask = within_mask(RowA, RowB, Threshold128);
+			if(Mask != 0xFFFF)
+				return Offset + glm::findLSB(~Mask);
+		}
+	}
+#	endif
+
+	return find_absolute_difference_scalar(A, B, Offset, Size, Threshold);
+}
+
+std::size_t find_absolute_difference_scalar(glm::u8 const* A, glm::u8 const* B, std::size_t Offset, std::size_t Size, glm::u8 Threshold)
+{
+	for(; Offset < Size; ++Offset)
+	{
+		glm::u8 const Diff = A[Offset] > B[Offset] ? A[Offset] - B[Offset] : B[Offset] - A[Offset];
+		if(Diff > Threshold)
+			return Offset;
+	}
+
+	return Size;
+}
+
+glm::ivec2 tile_count(glm::ivec2 const & Extent)
+{
+	int const TileSize = static_cast<int>(TEMPLATE_TILE_SIZE);
+	return (Extent + glm::ivec2(TileSize - 1)) / TileSize;
+}
+
+glm::u64 hash_tile(image_rgb8 const & Image, glm::ivec2 const & TileCoord)
+{
+	int const TileSize = static_cast<int>(TEMPLATE_TILE_SIZE);
+	glm::ivec2 const Begin = TileCoord * TileSize;
+	glm::ivec2 const End = glm::min(Begin + TileSize, Image.Extent);
+	std::size_t const RowSize = (End.x - Begin.x) * sizeof(glm::u8vec3);
+
+	glm::u64 Hash = 0;
+	for(int Y = Begin.y; Y < End.y; ++Y)
+		Hash = hash64(Image.row(Y) + Begin.x * sizeof(glm::u8vec3), RowSize, Hash);
+	return Hash;
+}
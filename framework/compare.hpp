@@ -0,0 +1,49 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <glm/gtc/type_precision.hpp>
+#include <cstddef>
+
+/// Width and height in texels of the tiles hashed by the template pack
+std::size_t const TEMPLATE_TILE_SIZE = 32;
+
+/// Read-only view of a packed RGB8 image, rows stored bottom-up without padding as returned by glReadPixels.
+/// The data may belong to a gli texture or to a mapped template pack.
+struct image_rgb8
+{
+	image_rgb8() :
+		Data(nullptr),
+		Extent(0)
+	{}
+
+	image_rgb8(glm::u8 const* Data, glm::ivec2 const & Extent) :
+		Data(Data),
+		Extent(Extent)
+	{}
+
+	bool empty() const {return this->Data == nullptr;}
+	std::size_t size() const {return static_cast<std::size_t>(this->Extent.x) * this->Extent.y * sizeof(glm::u8vec3);}
+	glm::u8 const* row(int Y) const {return this->Data + static_cast<std::size_t>(Y) * this->Extent.x * sizeof(glm::u8vec3);}
+
+	glm::u8vec3 load(glm::ivec2 const & TexelCoord) const
+	{
+		glm::u8 const* Texel = this->row(TexelCoord.y) + TexelCoord.x * sizeof(glm::u8vec3);
+		return glm::u8vec3(Texel[0], Texel[1], Texel[2]);
+	}
+
+	glm::u8 const* Data;
+	glm::ivec2 Extent;
+};
+
+/// Offset of the first byte in [Offset, Size) for which the absolute difference between A and B is above Threshold.
+/// Returns Size when every byte is within Threshold. Rows are packed bytes so RGB8 rows are scanned as is.
+std::size_t find_absolute_difference(glm::u8 const* A, glm::u8 const* B, std::size_t Offset, std::size_t Size, glm::u8 Threshold);
+
+/// Byte by byte find_absolute_difference, used for the bytes left after the SIMD blocks and as the benchmark reference
+std::size_t find_absolute_difference_scalar(glm::u8 const* A, glm::u8 const* B, std::size_t Offset, std::size_t Size, glm::u8 Threshold);
+
+/// Number of TEMPLATE_TILE_SIZE tiles covering the image, partial tiles included
+glm::ivec2 tile_count(glm::ivec2 const & Extent);
+
+/// Hash of the texels of one tile of the image, partial border tiles only hash the texels inside the image
+glm::u64 hash_tile(image_rgb8 const & Image, glm::ivec2 const & TileCoord);
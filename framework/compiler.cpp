@@ -10,16 +10,153 @@
 //**********************************
 
 #include "compiler.hpp"
+#include "compiler_telemetry.hpp"
+#include "source_cache.hpp"
+#include "program_cache.hpp"
+#include "shader_watcher.hpp"
 
 #include <glm/gtc/random.hpp>
 
-#include <string>
-#include <sstream>
-#include <fstream>
+#include <algorithm>
+#include <cctype>
 #include <cstdarg>
+#include <cstdlib>
+#include <cstring>
+#include <sstream>
+#include <string>
 
 std::string getDataDirectory();
 
+namespace
+{
+	variant_statistics& get_variant_statistics()
+	{
+		static variant_statistics Statistics;
+		return Statistics;
+	}
+
+	enum directive
+	{
+		DIRECTIVE_NONE,
+		DIRECTIVE_VERSION,
+		DIRECTIVE_INCLUDE,
+		DIRECTIVE_PRAGMA_ONCE
+	};
+
+	inline bool is_blank(char Character)
+	{
+		return Character == ' ' || Character == '\t' || Character == '\r';
+	}
+
+	inline bool is_identifier(char Character)
+	{
+		return std::isalnum(static_cast<unsigned char>(Character)) || Character == '_';
+	}
+
+	inline char const* skip_blank(char const* First, char const* Last)
+	{
+		while(First < Last && is_blank(*First))
+			++First;
+		return First;
+	}
+
+	inline bool match_identifier(char const* & First, char const* Last, char const* Identifier)
+	{
+		std::size_t const Length = std::strlen(Identifier);
+		if(static_cast<std::size_t>(Last - First) < Length || std::memcmp(First, Identifier, Length) != 0)
+			return false;
+		if(First + Length < Last && is_identifier(First[Length]))
+			return false;
+		First += Length;
+		return true;
+	}
+
+	// Directives the parser handles, Argument points after the directive name
+	directive parse_directive(char const* First, char const* Last, char const* & Argument)
+	{
+		First = skip_blank(First, Last);
+		if(First == Last || *First != '#')
+			return DIRECTIVE_NONE;
+		First = skip_blank(First + 1, Last);
+
+		if(match_identifier(First, Last, "version"))
+		{
+			Argument = skip_blank(First, Last);
+			return DIRECTIVE_VERSION;
+		}
+		if(match_identifier(First, Last, "include"))
+		{
+			Argument = First;
+			return DIRECTIVE_INCLUDE;
+		}
+		if(match_identifier(First, Last, "pragma"))
+		{
+			First = skip_blank(First, Last);
+			if(match_identifier(First, Last, "once") && skip_blank(First, Last) == Last)
+				return DIRECTIVE_PRAGMA_ONCE;
+		}
+		return DIRECTIVE_NONE;
+	}
+
+	// Tracks the block comments opened or closed on a line
+	void scan_comments(char const* First, char const* Last, bool & InComment)
+	{
+		for(; First + 1 < Last; ++First)
+		{
+			if(InComment)
+			{
+				if(First[0] == '*' && First[1] == '/')
+				{
+					InComment = false;
+					++First;
+				}
+			}
+			else if(First[0] == '/' && First[1] == '/')
+				return;
+			else if(First[0] == '/' && First[1] == '*')
+			{
+				InComment = true;
+				++First;
+			}
+		}
+	}
+
+	// First #version directive of Source outside of block comments, Line is empty when there is none
+	void find_version(std::string const & Source, std::string & Line, int & Version, bool & ES)
+	{
+		bool InComment = false;
+		char const* Cursor = Source.data();
+		char const* const Last = Cursor + Source.size();
+		while(Cursor < Last)
+		{
+			char const* EndOfLine = static_cast<char const*>(std::memchr(Cursor, '\n', static_cast<std::size_t>(Last - Cursor)));
+			char const* const LineFirst = Cursor;
+			char const* const LineLast = EndOfLine ? EndOfLine : Last;
+			Cursor = EndOfLine ? EndOfLine + 1 : Last;
+
+			char const* Argument = LineLast;
+			if(!InComment && parse_directive(LineFirst, LineLast, Argument) == DIRECTIVE_VERSION)
+			{
+				Line.assign(LineFirst, LineLast).append(1, '\n');
+				Version = std::atoi(Argument);
+				ES = std::strstr(std::string(Argument, LineLast).c_str(), "es") != nullptr;
+				return;
+			}
+			scan_comments(LineFirst, LineLast, InComment);
+		}
+	}
+
+	// Files in the order of their source string numbers, as recorded by the parser
+	std::vector<std::string> source_strings(source_cache::dependencies const & Dependencies)
+	{
+		std::vector<std::string> Files;
+		for(std::size_t DependencyIndex = 0; DependencyIndex < Dependencies.size(); ++DependencyIndex)
+			if(Dependencies[DependencyIndex].second.Exists && std::find(Files.begin(), Files.end(), Dependencies[DependencyIndex].first) == Files.end())
+				Files.push_back(Dependencies[DependencyIndex].first);
+		return Files;
+	}
+}//namespace
+
 compiler::commandline::commandline(std::string const & Filename, std::string const & Arguments) :
 	Profile("core"),
 	Version(-1)
@@ -90,16 +227,37 @@ std::string compiler::commandline::getDefines() const
 	return Result;
 }
 
+std::string compiler::commandline::getKey(std::string const & Filename) const
+{
+	// Macros sorted by name, only their last definition matters
+	std::map<std::string, std::string> Macros;
+	for(std::size_t i = 0; i < this->Defines.size(); ++i)
+		Macros[this->Defines[i].substr(0, this->Defines[i].find_first_of(" =("))] = this->Defines[i];
+
+	std::string Key = format("%s\n%d %s\n", Filename.c_str(), this->Version, this->Profile.c_str());
+	for(std::map<std::string, std::string>::const_iterator Iterator = Macros.begin(); Iterator != Macros.end(); ++Iterator)
+		Key.append("-D").append(Iterator->second).append(1, '\n');
+	for(std::size_t i = 0; i < this->Includes.size(); ++i)
+		Key.append("-I").append(this->Includes[i]).append(1, '\n');
+	return Key;
+}
+
 // compiler::parser
 
-std::string compiler::parser::operator()(commandline const & CommandLine, std::string const & Filename) const
+compiler::parser::parser(commandline const & CommandLine, source_cache::dependencies & Dependencies) :
+	CommandLine(CommandLine),
+	Dependencies(Dependencies),
+	Version(CommandLine.getVersion()),
+	ES(CommandLine.getProfile() == "es")
+{}
+
+std::string compiler::parser::operator()(std::string const & Filename)
 {
-	std::string Source = load_file(Filename);
-	assert(!Source.empty());
+	std::shared_ptr<std::string const> Source = get_source_cache().loadFile(Filename, &this->Dependencies);
+	assert(Source && !Source->empty());
 
-	std::stringstream Stream;
-	Stream << Source;
-	std::string Line, Text;
+	std::string Text;
+	Text.reserve(Source ? Source->size() * 2 + 1024 : 1024);
 
 	// Handle command line version and profile arguments
 	if(CommandLine.getVersion() != -1)
@@ -108,67 +266,184 @@ std::string compiler::parser::operator()(commandline const & CommandLine, std::s
 	// Handle command line defines
 	Text += CommandLine.getDefines();
 
-	while(std::getline(Stream, Line))
-	{
-		std::size_t Offset = 0;
+	// The version selects the form of the #line directives, it is known before the first one is emitted
+	if(Source && CommandLine.getVersion() == -1)
+		find_version(*Source, this->VersionLine, this->Version, this->ES);
 
-		// Version
-		Offset = Line.find("#version");
-		if(Offset != std::string::npos)
-		{
-			std::size_t CommentOffset = Line.find("//");
-			if(CommentOffset != std::string::npos && CommentOffset < Offset)
-				continue;
-
-			// Reorder so that the #version line is always the first of a shader text
-			if(CommandLine.getVersion() == -1)
-				Text = Line + std::string("\n") + Text;
-			// else skip is version is only mentionned
-			continue;
-		}
+	if(Source)
+		this->parseFile(Filename, *Source, Text);
 
-		// Include
-		Offset = Line.find("#include");
-		if(Offset != std::string::npos)
+	// Reorder so that the #version line is always the first of a shader text
+	Text.insert(0, this->VersionLine);
+
+	return Text;
+}
+
+void compiler::parser::parseFile(std::string const & Filename, std::string const & Source, std::string & Text)
+{
+	std::size_t const FileIndex = std::find(this->Files.begin(), this->Files.end(), Filename) - this->Files.begin();
+	if(FileIndex == this->Files.size())
+		this->Files.push_back(Filename);
+	this->Stack.push_back(Filename);
+
+	bool InComment = false;
+	bool LineDirective = true;
+	std::size_t LineNumber = 0;
+
+	char const* Cursor = Source.data();
+	char const* const Last = Cursor + Source.size();
+	while(Cursor < Last)
+	{
+		char const* EndOfLine = static_cast<char const*>(std::memchr(Cursor, '\n', static_cast<std::size_t>(Last - Cursor)));
+		char const* const LineFirst = Cursor;
+		char const* const LineLast = EndOfLine ? EndOfLine : Last;
+		Cursor = EndOfLine ? EndOfLine + 1 : Last;
+		++LineNumber;
+
+		// Directives are only recognized outside of block comments
+		directive Directive = DIRECTIVE_NONE;
+		char const* Argument = LineLast;
+		if(!InComment)
+			Directive = parse_directive(LineFirst, LineLast, Argument);
+		scan_comments(LineFirst, LineLast, InComment);
+
+		switch(Directive)
 		{
-			std::size_t CommentOffset = Line.find("//");
-			if(CommentOffset != std::string::npos && CommentOffset < Offset)
-				continue;
+		case DIRECTIVE_VERSION:
+			// The version of the root file is moved first by operator(), it is overridden by the command line and the
+			// directives of included files are ignored
+			if(this->Stack.size() > 1)
+				fprintf(stderr, "%s(%d): #version ignored in an included file\n", Filename.c_str(), static_cast<int>(LineNumber));
+			LineDirective = true;
+			break;
+		case DIRECTIVE_PRAGMA_ONCE:
+			this->OnceFiles.insert(Filename);
+			LineDirective = true;
+			break;
+		case DIRECTIVE_INCLUDE:
+			this->parseInclude(Filename, LineNumber, Argument, LineLast, Text);
+			LineDirective = true;
+			break;
+		default:
+			if(LineDirective)
+				this->emitLine(LineNumber, FileIndex, Text);
+			LineDirective = false;
+			Text.append(LineFirst, LineLast).append(1, '\n');
+			break;
+		}
+	}
 
-			std::string Include = parseInclude(Line, Offset);
+	this->Stack.pop_back();
+}
 
-			std::vector<std::string> Includes = CommandLine.getIncludes();
+void compiler::parser::parseInclude(std::string const & Filename, std::size_t LineNumber, char const* First, char const* Last, std::string & Text)
+{
+	// #include "file" or #include <file>
+	First = skip_blank(First, Last);
+	char const Close = First < Last && *First == '<' ? '>' : '"';
+	char const* NameLast = First < Last ? std::find(First + 1, Last, Close) : Last;
+	if(First == Last || (*First != '"' && *First != '<') || NameLast == Last)
+	{
+		Text += format("#error %s(%d): malformed #include\n", Filename.c_str(), static_cast<int>(LineNumber));
+		return;
+	}
+	std::string const Name(First + 1, NameLast);
 
-			for(std::size_t i = 0; i < Includes.size(); ++i)
-			{
-				std::string PathName = Includes[i] + Include;
-				std::string IncludeSource = load_file(PathName);
-				if (!IncludeSource.empty())
-				{
-					Text += IncludeSource;
-					break;
-				}
-			}
+	// The directory of the including file first, then the include paths of the command line
+	std::string const Directory = Filename.substr(0, Filename.find_last_of("/\\") + 1);
+	std::vector<std::string> const & Includes = CommandLine.getIncludes();
 
+	std::string Path;
+	std::shared_ptr<std::string const> Source;
+	for(std::size_t i = 0; i <= Includes.size() && !Source; ++i)
+	{
+		if(i > 0 && Includes[i - 1] == Directory)
 			continue;
-		} 
+		Path = (i == 0 ? Directory : Includes[i - 1]) + Name;
+		Source = get_source_cache().loadFile(Path, &this->Dependencies);
+	}
 
-		Text += Line + "\n";
+	if(!Source)
+	{
+		fprintf(stderr, "%s(%d): #include \"%s\" not found\n", Filename.c_str(), static_cast<int>(LineNumber), Name.c_str());
+		Text += format("#error %s(%d): #include \"%s\" not found\n", Filename.c_str(), static_cast<int>(LineNumber), Name.c_str());
+		return;
 	}
 
-	//Text += glf::format("\nconst float G_TRUC_GNI = %f;\n", glm::linearRand(0.0f, 1.0f));
+	if(this->OnceFiles.find(Path) != this->OnceFiles.end())
+		return;
 
-	return Text;
+	if(std::find(this->Stack.begin(), this->Stack.end(), Path) != this->Stack.end())
+	{
+		fprintf(stderr, "%s(%d): recursive #include \"%s\"\n", Filename.c_str(), static_cast<int>(LineNumber), Name.c_str());
+		Text += format("#error %s(%d): recursive #include \"%s\"\n", Filename.c_str(), static_cast<int>(LineNumber), Name.c_str());
+		return;
+	}
+
+	this->parseFile(Path, *Source, Text);
 }
 
-std::string compiler::parser::parseInclude(std::string const & Line, std::size_t const & Offset) const
+void compiler::parser::emitLine(std::size_t LineNumber, std::size_t FileIndex, std::string & Text) const
 {
-	std::string Result;
+	// Before GLSL 3.30 and GLSL ES 3.00, the line following "#line N" is the line N + 1
+	bool const NextLine = this->ES ? this->Version < 300 : this->Version < 330;
+
+	char Directive[64];
+	std::sprintf(Directive, "#line %d %d\n", static_cast<int>(LineNumber) - (NextLine ? 1 : 0), static_cast<int>(FileIndex));
+	Text += Directive;
+}
 
-	std::string::size_type IncludeFirstQuote = Line.find("\"", Offset);
-	std::string::size_type IncludeSecondQuote = Line.find("\"", IncludeFirstQuote + 1);
+// compile_future
 
-	return Line.substr(IncludeFirstQuote + 1, IncludeSecondQuote - IncludeFirstQuote - 1);
+bool is_parallel_compile_supported()
+{
+	return GLEW_KHR_parallel_shader_compile || GLEW_ARB_parallel_shader_compile;
+}
+
+compile_future::compile_future() :
+	Type(SHADER),
+	Name(0)
+{}
+
+compile_future::compile_future(type Type, GLuint Name) :
+	Type(Type),
+	Name(Name)
+{}
+
+bool compile_future::ready() const
+{
+	if(!this->valid() || !is_parallel_compile_supported())
+		return true;
+
+	// Compilation deferred by the program cache, nothing is in flight
+	if(this->Type == SHADER && get_program_cache().isDeferred(this->Name))
+		return true;
+
+	GLint Completed = GL_TRUE;
+	if(this->Type == SHADER)
+		glGetShaderiv(this->Name, GL_COMPLETION_STATUS_KHR, &Completed);
+	else
+		glGetProgramiv(this->Name, GL_COMPLETION_STATUS_KHR, &Completed);
+	return Completed == GL_TRUE;
+}
+
+bool compile_future::get() const
+{
+	if(!this->valid())
+		return false;
+
+	if(this->Type == SHADER && get_program_cache().isDeferred(this->Name))
+		return true;
+
+	GLint Status = GL_FALSE;
+	if(this->Type == SHADER)
+	{
+		glGetShaderiv(this->Name, GL_COMPILE_STATUS, &Status);
+		get_compiler_telemetry().recordCompileStatus(this->Name, Status == GL_TRUE);
+	}
+	else
+		glGetProgramiv(this->Name, GL_LINK_STATUS, &Status);
+	return Status == GL_TRUE;
 }
 
 // compiler
@@ -182,27 +457,117 @@ GLuint compiler::create(GLenum Type, std::string const & Filename, std::string c
 	assert(!Filename.empty());
 	
 	commandline CommandLine(Filename, Arguments);
+	std::string const VariantKey = getVariantKey(Type, Filename, CommandLine);
 
-	std::string PreprocessedSource = parser()(CommandLine, Filename);
-	assert(!PreprocessedSource.empty());
-	char const* PreprocessedSourcePointer = PreprocessedSource.c_str();
+	++get_variant_statistics().Requests;
 
-	fprintf(stdout, "%s\n", PreprocessedSource.c_str());
+	names_map::const_iterator Variant = this->ShaderNames.find(VariantKey);
+	if(Variant != this->ShaderNames.end())
+	{
+		++get_variant_statistics().Deduplicated;
+		return Variant->second;
+	}
 
 	GLuint Name = glCreateShader(Type);
-	glShaderSource(Name, 1, &PreprocessedSourcePointer, NULL);
-	glCompileShader(Name);
+	this->compileSource(Name, variant(Type, Filename, Arguments), CommandLine);
 
-	std::pair<files_map::iterator, bool> ResultFiles = this->ShaderFiles.insert(std::make_pair(Name, Filename));
+	++get_variant_statistics().Compiles;
+
+	std::pair<files_map::iterator, bool> ResultFiles = this->ShaderFiles.insert(std::make_pair(Name, VariantKey));
 	assert(ResultFiles.second);
-	std::pair<names_map::iterator, bool> ResultNames = this->ShaderNames.insert(std::make_pair(Filename, Name));
+	std::pair<names_map::iterator, bool> ResultNames = this->ShaderNames.insert(std::make_pair(VariantKey, Name));
 	assert(ResultNames.second);
-	std::pair<names_map::iterator, bool> ResultChecks = this->PendingChecks.insert(std::make_pair(Filename, Name));
+	std::pair<names_map::iterator, bool> ResultChecks = this->PendingChecks.insert(std::make_pair(VariantKey, Name));
 	assert(ResultChecks.second);
 
 	return Name;
 }
 
+std::size_t compiler::prewarm(std::vector<variant> const & Variants)
+{
+	std::size_t const Compiles = get_variant_statistics().Compiles;
+
+	for(std::size_t VariantIndex = 0; VariantIndex < Variants.size(); ++VariantIndex)
+		this->create(Variants[VariantIndex].Type, Variants[VariantIndex].Filename, Variants[VariantIndex].Arguments);
+
+	return get_variant_statistics().Compiles - Compiles;
+}
+
+void compiler::compileSource(GLuint ShaderName, variant const & Variant, commandline const & CommandLine)
+{
+	compiler_telemetry::shader_record Record;
+	Record.Filename = Variant.Filename;
+	Record.Arguments = Variant.Arguments;
+	Record.Type = Variant.Type;
+	Record.Name = ShaderName;
+
+	double const PreprocessStart = telemetry_time();
+
+	source_cache& Cache = get_source_cache();
+	std::string const Key = CommandLine.getKey(Variant.Filename);
+	std::string PreprocessedSource;
+	source_cache::dependencies Dependencies;
+	Record.SourceCacheHit = Cache.findPreprocessed(Key, PreprocessedSource, &Dependencies);
+	if(!Record.SourceCacheHit)
+	{
+		PreprocessedSource = parser(CommandLine, Dependencies)(Variant.Filename);
+		Cache.storePreprocessed(Key, PreprocessedSource, Dependencies);
+	}
+	assert(!PreprocessedSource.empty());
+	char const* PreprocessedSourcePointer = PreprocessedSource.c_str();
+
+	this->ShaderSources[ShaderName] = source_strings(Dependencies);
+
+	Record.PreprocessTime = telemetry_time() - PreprocessStart;
+	Record.SourceSize = PreprocessedSource.size();
+	Record.IncludeCount = this->ShaderSources[ShaderName].empty() ? 0 : this->ShaderSources[ShaderName].size() - 1;
+
+	glShaderSource(ShaderName, 1, &PreprocessedSourcePointer, NULL);
+	Record.IssueTime = telemetry_time();
+	Record.Deferred = get_program_cache().deferCompile(ShaderName, Variant.Type, PreprocessedSource);
+	if(!Record.Deferred)
+		glCompileShader(ShaderName);
+
+	get_compiler_telemetry().recordShader(Record, PreprocessedSource);
+
+	shader_watcher& Watcher = get_shader_watcher();
+	if(Watcher.isEnabled())
+		Watcher.addShader(ShaderName, Variant, Dependencies);
+}
+
+void compiler::recompile(GLuint ShaderName, variant const & Variant)
+{
+	this->compileSource(ShaderName, Variant, commandline(Variant.Filename, Variant.Arguments));
+}
+
+std::string compiler::getVariantKey(GLenum Type, std::string const & Filename, commandline const & CommandLine)
+{
+	return format("%x\n", Type) + CommandLine.getKey(Filename);
+}
+
+std::string compiler::preprocess(std::string const & Filename, std::string const & Arguments, source_cache::dependencies* Dependencies)
+{
+	commandline CommandLine(Filename, Arguments);
+	source_cache::dependencies Files;
+	return parser(CommandLine, Dependencies ? *Dependencies : Files)(Filename);
+}
+
+variant_statistics compiler::getVariantStatistics()
+{
+	return get_variant_statistics();
+}
+
+compile_future compiler::createAsync(GLenum Type, std::string const & Filename, std::string const & Arguments)
+{
+	return compile_future(compile_future::SHADER, this->create(Type, Filename, Arguments));
+}
+
+compile_future compiler::link(GLuint ProgramName)
+{
+	glLinkProgram(ProgramName);
+	return compile_future(compile_future::PROGRAM, ProgramName);
+}
+
 bool compiler::destroy(GLuint const & Name)
 {
 	files_map::iterator NameIterator = this->ShaderFiles.find(Name);
@@ -210,6 +575,7 @@ bool compiler::destroy(GLuint const & Name)
 		return false; // Shader name not found
 	std::string File = NameIterator->second;
 	this->ShaderFiles.erase(NameIterator);
+	this->ShaderSources.erase(Name);
 
 	// Remove from the pending checks list
 	names_map::iterator PendingIterator = this->PendingChecks.find(File);
@@ -285,26 +651,52 @@ bool compiler::check()
 		++ShaderIterator
 	)
 	{
-		GLuint ShaderName = ShaderIterator->second;
-		GLint Result = GL_FALSE;
-		glGetShaderiv(ShaderName, GL_COMPILE_STATUS, &Result);
+		Success = this->checkShader(ShaderIterator->second) && Success;
+	}
+	
+	return Success; 
+}
 
-		if(Result == GL_TRUE)
-			continue;
+bool compiler::check(GLuint const & Name)
+{
+	return this->checkShader(Name);
+}
 
-		int InfoLogLength;
-		glGetShaderiv(ShaderName, GL_INFO_LOG_LENGTH, &InfoLogLength);
-		if(InfoLogLength > 0)
-		{
-			std::vector<char> Buffer(InfoLogLength);
-			glGetShaderInfoLog(ShaderName, InfoLogLength, NULL, &Buffer[0]);
-			fprintf(stdout, "%s\n", &Buffer[0]);
-		}
+bool compiler::checkShader(GLuint ShaderName)
+{
+	// Known to compile, glCompileShader runs at link time if the program binary cache misses
+	if(get_program_cache().isDeferred(ShaderName))
+		return true;
 
-		Success = Success && Result == GL_TRUE;
+	GLint Result = GL_FALSE;
+	glGetShaderiv(ShaderName, GL_COMPILE_STATUS, &Result);
+	get_compiler_telemetry().recordCompileStatus(ShaderName, Result == GL_TRUE);
+
+	if(Result == GL_TRUE)
+		return true;
+
+	int InfoLogLength;
+	glGetShaderiv(ShaderName, GL_INFO_LOG_LENGTH, &InfoLogLength);
+	if(InfoLogLength > 0)
+	{
+		std::vector<char> Buffer(InfoLogLength);
+		glGetShaderInfoLog(ShaderName, InfoLogLength, NULL, &Buffer[0]);
+		fprintf(stdout, "%s\n", &Buffer[0]);
 	}
-	
-	return Success; 
+
+	std::vector<std::string> const & Sources = this->ShaderSources[ShaderName];
+	for(std::size_t SourceIndex = 0; SourceIndex < Sources.size(); ++SourceIndex)
+		fprintf(stdout, "%d: %s\n", static_cast<int>(SourceIndex), Sources[SourceIndex].c_str());
+
+	return false;
+}
+
+bool compiler::ready() const
+{
+	for(names_map::const_iterator ShaderIterator = PendingChecks.begin(); ShaderIterator != PendingChecks.end(); ++ShaderIterator)
+		if(!compile_future(compile_future::SHADER, ShaderIterator->second).ready())
+			return false;
+	return true;
 }
 
 void compiler::clear()
@@ -317,26 +709,15 @@ void compiler::clear()
 
 	this->ShaderNames.clear();
 	this->ShaderFiles.clear();
+	this->ShaderSources.clear();
 	this->PendingChecks.clear();
 }
 
 std::string load_file(std::string const & Filename)
 {
-	std::string Result;
-		
-	std::ifstream Stream(Filename.c_str());
-	if(!Stream.is_open())
-		return Result;
-
-	Stream.seekg(0, std::ios::end);
-	Result.reserve(Stream.tellg());
-	Stream.seekg(0, std::ios::beg);
-		
-	Result.assign(
-		(std::istreambuf_iterator<char>(Stream)),
-		std::istreambuf_iterator<char>());
-
-	return Result;
+	// Through the source cache so that the files of the shader pack are never opened
+	std::shared_ptr<std::string const> Content = get_source_cache().loadFile(Filename);
+	return Content ? *Content : std::string();
 }
 
 bool load_binary
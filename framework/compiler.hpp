@@ -1,15 +1,63 @@
 #pragma once
 
+#include "source_cache.hpp"
+
 #include <GL/glew.h>
 #include <glm/gtc/type_precision.hpp>
 
 #include <map>
+#include <set>
 #include <string>
 #include <vector>
 
 std::string format(const char* Message, ...);
 bool checkError(const char* Title);
 
+/// Completion of a shader compilation or of a program link that may run on driver threads.
+/// ready() polls GL_COMPLETION_STATUS_KHR when GL_KHR_parallel_shader_compile or GL_ARB_parallel_shader_compile is
+/// supported and never blocks, without the extension the work is considered done once issued.
+class compile_future
+{
+public:
+	enum type
+	{
+		SHADER,
+		PROGRAM
+	};
+
+	compile_future();
+	compile_future(type Type, GLuint Name);
+
+	GLuint name() const {return this->Name;}
+	bool valid() const {return this->Name != 0;}
+
+	bool ready() const;
+	/// Waits for the completion and returns the compile or link status
+	bool get() const;
+
+private:
+	type Type;
+	GLuint Name;
+};
+
+/// True when the current context can report the completion of compilations without blocking
+bool is_parallel_compile_supported();
+
+/// Shader requests of all the compilers of the process, a deduplicated request returned the shader already created
+/// for the same type, file and normalized arguments
+struct variant_statistics
+{
+	variant_statistics() :
+		Requests(0),
+		Compiles(0),
+		Deduplicated(0)
+	{}
+
+	std::size_t Requests;
+	std::size_t Compiles;
+	std::size_t Deduplicated;
+};
+
 class compiler
 {
 	typedef std::map<std::string, GLuint> names_map;
@@ -31,7 +79,9 @@ class compiler
 		int getVersion() const {return this->Version;}
 		std::string getProfile() const {return this->Profile;}
 		std::string getDefines() const;
-		std::vector<std::string> getIncludes() const {return this->Includes;}
+		std::vector<std::string> const & getIncludes() const {return this->Includes;}
+		/// Identifies the text preprocessed from a file with this command line, whatever the order of the defines
+		std::string getKey(std::string const & Filename) const;
 
 	private:
 		std::string Profile;
@@ -40,33 +90,89 @@ class compiler
 		std::vector<std::string> Includes;
 	};
 
+	/// Single pass preprocessor: moves #version first, expands #include recursively with #pragma once and cycle
+	/// detection, and emits #line directives so that compiler messages refer to the lines of the original files.
+	/// The source string number of a #line directive indexes the files in inclusion order, 0 being Filename.
 	class parser
 	{
 	public:
-		std::string operator() (commandline const & CommandLine, std::string const & Filename) const;
+		parser(commandline const & CommandLine, source_cache::dependencies & Dependencies);
+
+		std::string operator() (std::string const & Filename);
 
 	private:
-		std::string parseInclude(std::string const & Line, std::size_t const & Offset) const;
+		void parseFile(std::string const & Filename, std::string const & Source, std::string & Text);
+		void parseInclude(std::string const & Filename, std::size_t LineNumber, char const* First, char const* Last, std::string & Text);
+		void emitLine(std::size_t LineNumber, std::size_t FileIndex, std::string & Text) const;
+
+		commandline const & CommandLine;
+		source_cache::dependencies & Dependencies;
+		std::vector<std::string> Files;
+		std::vector<std::string> Stack;
+		std::set<std::string> OnceFiles;
+		std::string VersionLine;
+		int Version;
+		bool ES;
 	};
 
 public:
+	struct variant
+	{
+		variant(GLenum Type, std::string const & Filename, std::string const & Arguments = std::string()) :
+			Type(Type),
+			Filename(Filename),
+			Arguments(Arguments)
+		{}
+
+		GLenum Type;
+		std::string Filename;
+		std::string Arguments;
+	};
+
 	~compiler();
 
+	/// Returns the shader already created by this compiler for the same variant, otherwise compiles a new one
 	GLuint create(GLenum Type, std::string const & Filename, std::string const & Arguments = std::string());
+	/// Issues the compilation of the variants not created yet, e.g. every permutation a sample will use, without
+	/// waiting for them. Returns the number of compilations issued.
+	std::size_t prewarm(std::vector<variant> const & Variants);
+	/// Issues the compilation without waiting for it, the shader name is the name of the future
+	compile_future createAsync(GLenum Type, std::string const & Filename, std::string const & Arguments = std::string());
+	/// Issues the link of ProgramName without waiting for it
+	static compile_future link(GLuint ProgramName);
 	bool destroy(GLuint const & Name);
 
 	bool check_program(GLuint ProgramName) const;
 	bool validate_program(GLuint ProgramName) const;
 
 	bool check();
-	// TODO: Not defined
+	/// True when all the pending shaders completed their compilation, never blocks
+	bool ready() const;
+	/// Checks the compilation of a shader this compiler created or recompiled, printing its errors
 	bool check(GLuint const & Name);
 	void clear();
 
+	/// Preprocesses the variant again and issues the compilation of ShaderName without waiting for it, see shader_watcher
+	void recompile(GLuint ShaderName, variant const & Variant);
+
+	static variant_statistics getVariantStatistics();
+	/// Text create() compiles for Filename, always preprocessed and never stored in the source cache.
+	/// The files read, include candidates not found included, are appended to Dependencies when it isn't nullptr.
+	static std::string preprocess(std::string const & Filename, std::string const & Arguments = std::string(), source_cache::dependencies* Dependencies = nullptr);
+
 private:
+	/// Key of ShaderNames and PendingChecks
+	static std::string getVariantKey(GLenum Type, std::string const & Filename, commandline const & CommandLine);
+	/// Preprocesses the variant, sets the source of ShaderName and issues its compilation
+	void compileSource(GLuint ShaderName, variant const & Variant, commandline const & CommandLine);
+	/// Prints the info log and the source strings of a shader that failed to compile
+	bool checkShader(GLuint ShaderName);
+
 	names_map ShaderNames;
 	files_map ShaderFiles;
 	names_map PendingChecks;
+	/// Files of each shader indexed by #line source string number, listed with the compilation errors
+	std::map<GLuint, std::vector<std::string> > ShaderSources;
 };
 
 std::string load_file(std::string const & Filename);
@@ -0,0 +1,177 @@
+#include "compiler_telemetry.hpp"
+
+#include <chrono>
+#include <cstdio>
+
+std::string format(const char* Message, ...);
+
+namespace
+{
+	std::string escape_json(std::string const & String)
+	{
+		std::string Result;
+		Result.reserve(String.size());
+		for(std::size_t Index = 0; Index < String.size(); ++Index)
+		{
+			char const Character = String[Index];
+			if(Character == '"' || Character == '\\')
+				Result.append(1, '\\').append(1, Character);
+			else if(static_cast<unsigned char>(Character) < 0x20)
+				Result += format("\\u%04x", static_cast<int>(Character));
+			else
+				Result.append(1, Character);
+		}
+		return Result;
+	}
+
+	char const* type_name(GLenum Type)
+	{
+		switch(Type)
+		{
+		case GL_VERTEX_SHADER: return "vertex";
+		case GL_TESS_CONTROL_SHADER: return "tess-control";
+		case GL_TESS_EVALUATION_SHADER: return "tess-evaluation";
+		case GL_GEOMETRY_SHADER: return "geometry";
+		case GL_FRAGMENT_SHADER: return "fragment";
+		case GL_COMPUTE_SHADER: return "compute";
+		default: return "unknown";
+		}
+	}
+}//namespace
+
+double telemetry_time()
+{
+	return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+compiler_telemetry::compiler_telemetry() :
+	Verbosity(VERBOSITY_QUIET)
+{}
+
+void compiler_telemetry::recordShader(shader_record const & Record, std::string const & Source)
+{
+	{
+		std::lock_guard<std::mutex> Lock(this->Mutex);
+		this->ShaderRecords[Record.Name] = this->Shaders.size();
+		this->Shaders.push_back(Record);
+	}
+
+	if(this->Verbosity >= VERBOSITY_SUMMARY)
+		fprintf(stdout, "Shader %d %s %s: %d bytes, %d includes, preprocessed in %.3f ms%s%s\n",
+			static_cast<int>(Record.Name), type_name(Record.Type), Record.Filename.c_str(),
+			static_cast<int>(Record.SourceSize), static_cast<int>(Record.IncludeCount), Record.PreprocessTime,
+			Record.SourceCacheHit ? ", source cache hit" : "", Record.Deferred ? ", compile deferred" : "");
+	if(this->Verbosity >= VERBOSITY_SOURCE)
+		fprintf(stdout, "%s\n", Source.c_str());
+}
+
+void compiler_telemetry::recordCompileStatus(GLuint ShaderName, bool Compiled)
+{
+	std::lock_guard<std::mutex> Lock(this->Mutex);
+
+	std::map<GLuint, std::size_t>::const_iterator Iterator = this->ShaderRecords.find(ShaderName);
+	if(Iterator == this->ShaderRecords.end())
+		return;
+
+	shader_record & Record = this->Shaders[Iterator->second];
+	if(Record.CompileTime >= 0.0)
+		return;
+
+	Record.CompileTime = telemetry_time() - Record.IssueTime;
+	Record.Compiled = Compiled;
+}
+
+void compiler_telemetry::recordLink(GLuint ProgramName, double LinkTime, bool ProgramCacheHit)
+{
+	program_record Record;
+	Record.Name = ProgramName;
+	Record.LinkTime = LinkTime;
+	Record.ProgramCacheHit = ProgramCacheHit;
+
+	GLint ShaderCount = 0;
+	glGetProgramiv(ProgramName, GL_ATTACHED_SHADERS, &ShaderCount);
+	if(ShaderCount > 0)
+	{
+		Record.Shaders.resize(static_cast<std::size_t>(ShaderCount));
+		glGetAttachedShaders(ProgramName, ShaderCount, nullptr, &Record.Shaders[0]);
+	}
+
+	std::lock_guard<std::mutex> Lock(this->Mutex);
+	this->Programs.push_back(Record);
+}
+
+std::vector<compiler_telemetry::shader_record> compiler_telemetry::shaders() const
+{
+	std::lock_guard<std::mutex> Lock(this->Mutex);
+	return this->Shaders;
+}
+
+std::vector<compiler_telemetry::program_record> compiler_telemetry::programs() const
+{
+	std::lock_guard<std::mutex> Lock(this->Mutex);
+	return this->Programs;
+}
+
+std::string compiler_telemetry::json() const
+{
+	std::lock_guard<std::mutex> Lock(this->Mutex);
+
+	std::string Result("{\n\t\"shaders\": [");
+	for(std::size_t ShaderIndex = 0; ShaderIndex < this->Shaders.size(); ++ShaderIndex)
+	{
+		shader_record const & Record = this->Shaders[ShaderIndex];
+		Result += ShaderIndex ? ",\n\t\t" : "\n\t\t";
+		// Paths and define lists are unbounded, they are appended rather than formatted
+		Result += format("{\"name\": %d, \"type\": \"%s\", \"file\": \"", static_cast<int>(Record.Name), type_name(Record.Type));
+		Result += escape_json(Record.Filename);
+		Result += "\", \"arguments\": \"";
+		Result += escape_json(Record.Arguments);
+		Result += "\", ";
+		Result += format("\"preprocess_ms\": %.4f, \"compile_ms\": %s, \"source_size\": %d, \"includes\": %d, ",
+			Record.PreprocessTime, Record.CompileTime >= 0.0 ? format("%.4f", Record.CompileTime).c_str() : "null",
+			static_cast<int>(Record.SourceSize), static_cast<int>(Record.IncludeCount));
+		Result += format("\"source_cache_hit\": %s, \"deferred\": %s, \"compiled\": %s}",
+			Record.SourceCacheHit ? "true" : "false", Record.Deferred ? "true" : "false",
+			Record.CompileTime >= 0.0 ? (Record.Compiled ? "true" : "false") : "null");
+	}
+	Result += "\n\t],\n\t\"programs\": [";
+	for(std::size_t ProgramIndex = 0; ProgramIndex < this->Programs.size(); ++ProgramIndex)
+	{
+		program_record const & Record = this->Programs[ProgramIndex];
+		std::string Shaders;
+		for(std::size_t ShaderIndex = 0; ShaderIndex < Record.Shaders.size(); ++ShaderIndex)
+			Shaders += format(ShaderIndex ? ", %d" : "%d", static_cast<int>(Record.Shaders[ShaderIndex]));
+		Result += ProgramIndex ? ",\n\t\t" : "\n\t\t";
+		Result += format("{\"name\": %d, \"shaders\": [", static_cast<int>(Record.Name));
+		Result += Shaders;
+		Result += format("], \"link_ms\": %.4f, \"program_cache_hit\": %s}", Record.LinkTime, Record.ProgramCacheHit ? "true" : "false");
+	}
+	Result += "\n\t]\n}\n";
+
+	return Result;
+}
+
+bool compiler_telemetry::saveJson(std::string const & Filename) const
+{
+	FILE* File = fopen(Filename.c_str(), "wb");
+	if(!File)
+		return false;
+
+	std::string const Json = this->json();
+	bool const Written = fwrite(Json.data(), Json.size(), 1, File) == 1;
+	return fclose(File) == 0 && Written;
+}
+
+void compiler_telemetry::clear()
+{
+	std::lock_guard<std::mutex> Lock(this->Mutex);
+	this->Shaders.clear();
+	this->Programs.clear();
+	this->ShaderRecords.clear();
+}
+
+compiler_telemetry& get_compiler_telemetry()
+{
+	static compiler_telemetry Telemetry;
+	return Telemetry;
+}
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <GL/glew.h>
+
+#include <cstddef>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/// Process-wide record of the work of the compilers: one record per shader compilation and per program link.
+/// Queried in process or exported as JSON, e.g. by sample-runner --telemetry=<file>.
+class compiler_telemetry
+{
+public:
+	enum verbosity
+	{
+		VERBOSITY_QUIET,
+		/// One line per shader compilation
+		VERBOSITY_SUMMARY,
+		/// The summary line followed by the preprocessed source
+		VERBOSITY_SOURCE
+	};
+
+	/// Times are wall times in milliseconds
+	struct shader_record
+	{
+		shader_record() :
+			Type(0),
+			Name(0),
+			PreprocessTime(0.0),
+			CompileTime(-1.0),
+			SourceSize(0),
+			IncludeCount(0),
+			SourceCacheHit(false),
+			Deferred(false),
+			Compiled(false),
+			IssueTime(0.0)
+		{}
+
+		std::string Filename;
+		std::string Arguments;
+		GLenum Type;
+		GLuint Name;
+		double PreprocessTime;
+		/// From glCompileShader to the first query of the compile status, -1 until then
+		double CompileTime;
+		std::size_t SourceSize;
+		std::size_t IncludeCount;
+		/// The preprocessed text came from the source cache
+		bool SourceCacheHit;
+		/// Known to compile from the program cache, glCompileShader deferred to a link missing the cache
+		bool Deferred;
+		bool Compiled;
+		/// telemetry_time() when the compilation was issued
+		double IssueTime;
+	};
+
+	struct program_record
+	{
+		GLuint Name;
+		std::vector<GLuint> Shaders;
+		/// glLinkProgram call, loading the binary on a program cache hit
+		double LinkTime;
+		bool ProgramCacheHit;
+	};
+
+	compiler_telemetry();
+
+	void setVerbosity(verbosity Verbosity) {this->Verbosity = Verbosity;}
+	verbosity getVerbosity() const {return this->Verbosity;}
+
+	void recordShader(shader_record const & Record, std::string const & Source);
+	void recordCompileStatus(GLuint ShaderName, bool Compiled);
+	void recordLink(GLuint ProgramName, double LinkTime, bool ProgramCacheHit);
+
+	std::vector<shader_record> shaders() const;
+	std::vector<program_record> programs() const;
+
+	std::string json() const;
+	bool saveJson(std::string const & Filename) const;
+
+	void clear();
+
+private:
+	mutable std::mutex Mutex;
+	std::vector<shader_record> Shaders;
+	std::vector<program_record> Programs;
+	/// Latest record of each shader name, names are reused once deleted
+	std::map<GLuint, std::size_t> ShaderRecords;
+	verbosity Verbosity;
+};
+
+compiler_telemetry& get_compiler_telemetry();
+
+/// Milliseconds of a steady clock, the origin is unspecified
+double telemetry_time();
@@ -2,6 +2,22 @@
 #include <cstdio>
 #include <cstring>
 
+namespace
+{
+	char const* const Metrics[] = {"cpu", "gpu", "swap"};
+	char const* const Columns[] = {"count", "mean", "min", "max", "p50", "p90", "p99", "p99.9", "jitter"};
+
+	// %.17g round-trips a double
+	void save_summary(FILE* File, histogram_summary const & Summary)
+	{
+		fprintf(File, ";%d;%.17g;%.17g;%.17g;%.17g;%.17g;%.17g;%.17g;%.17g",
+			static_cast<int>(Summary.Count),
+			Summary.Mean, Summary.Min, Summary.Max,
+			Summary.P50, Summary.P90, Summary.P99, Summary.P999,
+			Summary.Jitter);
+	}
+}//namespace
+
 std::string format(const char * Message, ...)
 {
 	assert(Message);
@@ -11,29 +27,35 @@ std::string format(const char * Message, ...)
 
 	va_list ap;
 	va_start(ap, Message);
-		std::vsprintf(Text, Message, ap);
+		std::vsnprintf(Text, sizeof(Text), Message, ap);
 	va_end(ap);
 
 	return Text;
 }
 
-void csv::log(char const* String, double Convergent, double Min, double Max)
+void csv::log(char const* String, histogram_summary const & Cpu, histogram_summary const & Gpu, histogram_summary const & Swap)
 {
-	this->Data.push_back(data(String, Convergent, Min, Max));
+	this->Data.push_back(data(String, Cpu, Gpu, Swap));
 }
 
 void csv::save(char const* Filename)
 {
 	FILE* File(fopen(Filename, "a+"));
 	assert(File);
-	fprintf(File, "%s;%s;%s;%s\n", "Tests", "average", "max", "min");
+
+	fprintf(File, "%s", "Tests");
+	for(std::size_t MetricIndex = 0; MetricIndex < sizeof(Metrics) / sizeof(Metrics[0]); ++MetricIndex)
+	for(std::size_t ColumnIndex = 0; ColumnIndex < sizeof(Columns) / sizeof(Columns[0]); ++ColumnIndex)
+		fprintf(File, ";%s %s", Metrics[MetricIndex], Columns[ColumnIndex]);
+	fprintf(File, "\n");
 
 	for(std::size_t i = 0; i < this->Data.size(); ++i)
 	{
-		fprintf(File, "%s;%d;%d;%d\n",
-			Data[i].String.c_str(),
-			static_cast<int>(Data[i].Convergent),
-			static_cast<int>(Data[i].Max), static_cast<int>(Data[i].Min));
+		fprintf(File, "%s", Data[i].String.c_str());
+		save_summary(File, Data[i].Cpu);
+		save_summary(File, Data[i].Gpu);
+		save_summary(File, Data[i].Swap);
+		fprintf(File, "\n");
 	}
 	fclose(File);
 }
@@ -43,10 +65,10 @@ void csv::print()
 	fprintf(stdout, "\n");
 	for(std::size_t i = 0; i < this->Data.size(); ++i)
 	{
-		fprintf(stdout, "%s, %2.5f, %2.5f, %2.5f\n",
+		fprintf(stdout, "%s, cpu p50 %2.5f p99 %2.5f, gpu p50 %2.5f p99 %2.5f jitter %2.5f, swap p50 %2.5f\n",
 			Data[i].String.c_str(),
-			Data[i].Convergent / 1000.0,
-			Data[i].Min / 1000.0, Data[i].Max / 1000.0);
+			Data[i].Cpu.P50, Data[i].Cpu.P99,
+			Data[i].Gpu.P50, Data[i].Gpu.P99, Data[i].Gpu.Jitter,
+			Data[i].Swap.P50);
 	}
 }
-
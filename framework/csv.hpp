@@ -1,5 +1,6 @@
 #pragma once
 
+#include "histogram.hpp"
 #include <vector>
 #include <string>
 #include <cstdarg>
@@ -13,19 +14,20 @@ class csv
 	{
 		data(
 			std::string const & String,
-			double Convergent, double Min, double Max) :
+			histogram_summary const & Cpu, histogram_summary const & Gpu, histogram_summary const & Swap) :
 			String(String),
-			Convergent(Convergent), Min(Min), Max(Max)
+			Cpu(Cpu), Gpu(Gpu), Swap(Swap)
 		{}
 
 		std::string String;
-		double Convergent;
-		double Min;
-		double Max;
+		histogram_summary Cpu;
+		histogram_summary Gpu;
+		histogram_summary Swap;
 	};
 
 public:
-	void log(char const* String, double Average, double Min, double Max);
+	/// One row per sample run with the CPU frame, GPU and swap time distributions
+	void log(char const* String, histogram_summary const & Cpu, histogram_summary const & Gpu, histogram_summary const & Swap);
 	void save(char const* Filename);
 	void print();
 
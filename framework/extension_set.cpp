@@ -0,0 +1,186 @@
+#include "extension_set.hpp"
+#include "hash.hpp"
+
+#include <cstring>
+
+namespace
+{
+	char const* const EXTENSION_NAMES[] =
+	{
+		"GL_AMD_blend_minmax_factor",
+		"GL_AMD_depth_clamp_separate",
+		"GL_AMD_performance_monitor",
+		"GL_AMD_sample_positions",
+		"GL_AMD_sparse_texture",
+		"GL_AMD_vertex_shader_layer",
+		"GL_AMD_vertex_shader_viewport_index",
+		"GL_ARB_arrays_of_arrays",
+		"GL_ARB_bindless_texture",
+		"GL_ARB_buffer_storage",
+		"GL_ARB_clear_buffer_object",
+		"GL_ARB_clear_texture",
+		"GL_ARB_clip_control",
+		"GL_ARB_compute_shader",
+		"GL_ARB_conditional_render_inverted",
+		"GL_ARB_copy_image",
+		"GL_ARB_cull_distance",
+		"GL_ARB_debug_output",
+		"GL_ARB_enhanced_layouts",
+		"GL_ARB_ES2_compatibility",
+		"GL_ARB_ES3_compatibility",
+		"GL_ARB_explicit_uniform_location",
+		"GL_ARB_fragment_layer_viewport",
+		"GL_ARB_framebuffer_no_attachments",
+		"GL_ARB_internalformat_query2",
+		"GL_ARB_invalidate_subdata",
+		"GL_ARB_multi_bind",
+		"GL_ARB_multi_draw_indirect",
+		"GL_ARB_parallel_shader_compile",
+		"GL_ARB_pipeline_statistics_query",
+		"GL_ARB_program_interface_query",
+		"GL_ARB_query_buffer_object",
+		"GL_ARB_seamless_cubemap_per_texture",
+		"GL_ARB_shader_image_size",
+		"GL_ARB_shader_storage_buffer_object",
+		"GL_ARB_shader_texture_image_samples",
+		"GL_ARB_sparse_buffer",
+		"GL_ARB_sparse_texture",
+		"GL_ARB_texture_barrier",
+		"GL_ARB_texture_buffer_range",
+		"GL_ARB_texture_mirror_clamp_to_edge",
+		"GL_ARB_texture_query_levels",
+		"GL_ARB_texture_stencil8",
+		"GL_ARB_texture_view",
+		"GL_ARB_vertex_attrib_binding",
+		"GL_ARB_vertex_type_10f_11f_11f_rev",
+		"GL_EXT_direct_state_access",
+		"GL_EXT_sparse_texture2",
+		"GL_EXT_texture_compression_s3tc",
+		"GL_EXT_texture_filter_anisotropic",
+		"GL_EXT_texture_mirror_clamp",
+		"GL_EXT_texture_sRGB",
+		"GL_INTEL_fragment_shader_ordering",
+		"GL_INTEL_performance_query",
+		"GL_KHR_debug",
+		"GL_NV_bindless_texture",
+		"GL_NV_fragment_shader_interlock",
+		"GL_NV_gpu_shader5",
+		"GL_NV_internalformat_sample_query",
+		"GL_NV_sample_locations",
+		"GL_NV_shader_buffer_load",
+		"GL_NV_shader_thread_group",
+		"GL_NV_vertex_buffer_unified_memory",
+		"GL_NV_viewport_array2"
+	};
+
+	static_assert(sizeof(EXTENSION_NAMES) / sizeof(EXTENSION_NAMES[0]) == EXTENSION_COUNT, "EXTENSION_NAMES and the extension enum must match");
+
+	extension_set& get_current_set()
+	{
+		static extension_set Set;
+		return Set;
+	}
+}//namespace
+
+char const* extension_name(extension Extension)
+{
+	return EXTENSION_NAMES[Extension];
+}
+
+extension_set::extension_set() :
+	Built(false)
+{}
+
+void extension_set::insert(char const* Name, std::size_t Size)
+{
+	this->Offsets.push_back(this->Names.size());
+	this->Hashes.push_back(hash64(Name, Size));
+	this->Names.append(Name, Size);
+	this->Names.push_back('\0');
+}
+
+void extension_set::build()
+{
+	this->Names.clear();
+	this->Offsets.clear();
+	this->Hashes.clear();
+	this->Buckets.clear();
+	this->Known.reset();
+
+	if(glGetStringi)
+	{
+		GLint ExtensionCount = 0;
+		glGetIntegerv(GL_NUM_EXTENSIONS, &ExtensionCount);
+		for(GLint ExtensionIndex = 0; ExtensionIndex < ExtensionCount; ++ExtensionIndex)
+		{
+			char const* Name = reinterpret_cast<char const*>(glGetStringi(GL_EXTENSIONS, static_cast<GLuint>(ExtensionIndex)));
+			if(Name)
+				this->insert(Name, strlen(Name));
+		}
+	}
+	else if(char const* String = reinterpret_cast<char const*>(glGetString(GL_EXTENSIONS)))
+	{
+		// Contexts older than OpenGL 3.0 or OpenGL ES 3.0 list the extensions in a single string
+		for(char const* Name = String; *Name;)
+		{
+			std::size_t const Size = strcspn(Name, " ");
+			if(Size > 0)
+				this->insert(Name, Size);
+			Name += Size;
+			Name += strspn(Name, " ");
+		}
+	}
+
+	// At most half full so that a lookup probes a couple of buckets
+	std::size_t BucketCount = 16;
+	while(BucketCount < this->Offsets.size() * 2)
+		BucketCount *= 2;
+	this->Buckets.assign(BucketCount, 0);
+
+	for(std::size_t ExtensionIndex = 0; ExtensionIndex < this->Offsets.size(); ++ExtensionIndex)
+	{
+		std::size_t BucketIndex = static_cast<std::size_t>(this->Hashes[ExtensionIndex]) & (BucketCount - 1);
+		while(this->Buckets[BucketIndex] != 0)
+			BucketIndex = (BucketIndex + 1) & (BucketCount - 1);
+		this->Buckets[BucketIndex] = static_cast<glm::u32>(ExtensionIndex + 1);
+	}
+
+	for(std::size_t ExtensionIndex = 0; ExtensionIndex < EXTENSION_COUNT; ++ExtensionIndex)
+		this->Known[ExtensionIndex] = this->contains(EXTENSION_NAMES[ExtensionIndex]);
+
+	this->Built = true;
+}
+
+bool extension_set::contains(char const* Name) const
+{
+	if(this->Buckets.empty())
+		return false;
+
+	std::size_t const Size = strlen(Name);
+	glm::u64 const Hash = hash64(Name, Size);
+	std::size_t const Mask = this->Buckets.size() - 1;
+
+	for(std::size_t BucketIndex = static_cast<std::size_t>(Hash) & Mask;; BucketIndex = (BucketIndex + 1) & Mask)
+	{
+		glm::u32 const Bucket = this->Buckets[BucketIndex];
+		if(Bucket == 0)
+			return false;
+
+		std::size_t const ExtensionIndex = Bucket - 1;
+		if(this->Hashes[ExtensionIndex] == Hash && strcmp(this->name(ExtensionIndex), Name) == 0)
+			return true;
+	}
+}
+
+extension_set const & get_extension_set()
+{
+	extension_set& Set = get_current_set();
+	if(!Set.built())
+		Set.build();
+	return Set;
+}
+
+void reset_extension_set()
+{
+	get_current_set() = extension_set();
+}
@@ -0,0 +1,118 @@
+#pragma once
+
+#include <GL/glew.h>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/type_precision.hpp>
+
+#include <bitset>
+#include <string>
+#include <vector>
+
+/// Extensions queried by the samples, checked without hashing their names
+enum extension
+{
+	EXTENSION_AMD_blend_minmax_factor,
+	EXTENSION_AMD_depth_clamp_separate,
+	EXTENSION_AMD_performance_monitor,
+	EXTENSION_AMD_sample_positions,
+	EXTENSION_AMD_sparse_texture,
+	EXTENSION_AMD_vertex_shader_layer,
+	EXTENSION_AMD_vertex_shader_viewport_index,
+	EXTENSION_ARB_arrays_of_arrays,
+	EXTENSION_ARB_bindless_texture,
+	EXTENSION_ARB_buffer_storage,
+	EXTENSION_ARB_clear_buffer_object,
+	EXTENSION_ARB_clear_texture,
+	EXTENSION_ARB_clip_control,
+	EXTENSION_ARB_compute_shader,
+	EXTENSION_ARB_conditional_render_inverted,
+	EXTENSION_ARB_copy_image,
+	EXTENSION_ARB_cull_distance,
+	EXTENSION_ARB_debug_output,
+	EXTENSION_ARB_enhanced_layouts,
+	EXTENSION_ARB_ES2_compatibility,
+	EXTENSION_ARB_ES3_compatibility,
+	EXTENSION_ARB_explicit_uniform_location,
+	EXTENSION_ARB_fragment_layer_viewport,
+	EXTENSION_ARB_framebuffer_no_attachments,
+	EXTENSION_ARB_internalformat_query2,
+	EXTENSION_ARB_invalidate_subdata,
+	EXTENSION_ARB_multi_bind,
+	EXTENSION_ARB_multi_draw_indirect,
+	EXTENSION_ARB_parallel_shader_compile,
+	EXTENSION_ARB_pipeline_statistics_query,
+	EXTENSION_ARB_program_interface_query,
+	EXTENSION_ARB_query_buffer_object,
+	EXTENSION_ARB_seamless_cubemap_per_texture,
+	EXTENSION_ARB_shader_image_size,
+	EXTENSION_ARB_shader_storage_buffer_object,
+	EXTENSION_ARB_shader_texture_image_samples,
+	EXTENSION_ARB_sparse_buffer,
+	EXTENSION_ARB_sparse_texture,
+	EXTENSION_ARB_texture_barrier,
+	EXTENSION_ARB_texture_buffer_range,
+	EXTENSION_ARB_texture_mirror_clamp_to_edge,
+	EXTENSION_ARB_texture_query_levels,
+	EXTENSION_ARB_texture_stencil8,
+	EXTENSION_ARB_texture_view,
+	EXTENSION_ARB_vertex_attrib_binding,
+	EXTENSION_ARB_vertex_type_10f_11f_11f_rev,
+	EXTENSION_EXT_direct_state_access,
+	EXTENSION_EXT_sparse_texture2,
+	EXTENSION_EXT_texture_compression_s3tc,
+	EXTENSION_EXT_texture_filter_anisotropic,
+	EXTENSION_EXT_texture_mirror_clamp,
+	EXTENSION_EXT_texture_sRGB,
+	EXTENSION_INTEL_fragment_shader_ordering,
+	EXTENSION_INTEL_performance_query,
+	EXTENSION_KHR_debug,
+	EXTENSION_NV_bindless_texture,
+	EXTENSION_NV_fragment_shader_interlock,
+	EXTENSION_NV_gpu_shader5,
+	EXTENSION_NV_internalformat_sample_query,
+	EXTENSION_NV_sample_locations,
+	EXTENSION_NV_shader_buffer_load,
+	EXTENSION_NV_shader_thread_group,
+	EXTENSION_NV_vertex_buffer_unified_memory,
+	EXTENSION_NV_viewport_array2,
+	EXTENSION_COUNT
+};
+
+/// Name of Extension including the GL_ prefix
+char const* extension_name(extension Extension);
+
+/// Extensions of a context, read once and looked up through an open addressing hash table
+class extension_set
+{
+public:
+	extension_set();
+
+	/// Read the extensions of the current context
+	void build();
+	bool built() const {return this->Built;}
+
+	bool contains(char const* Name) const;
+	bool contains(extension Extension) const {return this->Known[Extension];}
+
+	std::size_t size() const {return this->Offsets.size();}
+	char const* name(std::size_t Index) const {return &this->Names[this->Offsets[Index]];}
+
+private:
+	void insert(char const* Name, std::size_t Size);
+
+	/// Names separated by '\0'
+	std::string Names;
+	std::vector<std::size_t> Offsets;
+	std::vector<glm::u64> Hashes;
+	/// Hold index + 1, 0 ends a probe sequence
+	std::vector<glm::u32> Buckets;
+	std::bitset<EXTENSION_COUNT> Known;
+	bool Built;
+};
+
+/// The extensions of the current context, read on first use
+extension_set const & get_extension_set();
+
+/// Read the extensions again on next use, called when the framework creates a context
+void reset_extension_set();
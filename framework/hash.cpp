@@ -0,0 +1,108 @@
+#include "hash.hpp"
+#include <cstring>
+
+namespace
+{
+	glm::u64 const PRIME64_1 = 11400714785074694791ULL;
+	glm::u64 const PRIME64_2 = 14029467366897019727ULL;
+	glm::u64 const PRIME64_3 = 1609587929392839161ULL;
+	glm::u64 const PRIME64_4 = 9650029242287828579ULL;
+	glm::u64 const PRIME64_5 = 2870177450012600261ULL;
+
+	inline glm::u64 rotl(glm::u64 Value, int Shift)
+	{
+		return (Value << Shift) | (Value >> (64 - Shift));
+	}
+
+	inline glm::u64 read64(glm::u8 const* Data)
+	{
+		glm::u64 Value;
+		memcpy(&Value, Data, sizeof(Value));
+		return Value;
+	}
+
+	inline glm::u32 read32(glm::u8 const* Data)
+	{
+		glm::u32 Value;
+		memcpy(&Value, Data, sizeof(Value));
+		return Value;
+	}
+
+	inline glm::u64 round(glm::u64 Accumulator, glm::u64 Input)
+	{
+		Accumulator += Input * PRIME64_2;
+		Accumulator = rotl(Accumulator, 31);
+		return Accumulator * PRIME64_1;
+	}
+
+	inline glm::u64 merge_round(glm::u64 Accumulator, glm::u64 Value)
+	{
+		Accumulator ^= round(0, Value);
+		return Accumulator * PRIME64_1 + PRIME64_4;
+	}
+}//namespace
+
+glm::u64 hash64(void const* Data, std::size_t Size, glm::u64 Seed)
+{
+	glm::u8 const* Pointer = static_cast<glm::u8 const*>(Data);
+	glm::u8 const* const End = Pointer + Size;
+
+	glm::u64 Hash = 0;
+
+	if(Size >= 32)
+	{
+		glm::u8 const* const Limit = End - 32;
+		glm::u64 V1 = Seed + PRIME64_1 + PRIME64_2;
+		glm::u64 V2 = Seed + PRIME64_2;
+		glm::u64 V3 = Seed;
+		glm::u64 V4 = Seed - PRIME64_1;
+
+		do
+		{
+			V1 = round(V1, read64(Pointer)); Pointer += 8;
+			V2 = round(V2, read64(Pointer)); Pointer += 8;
+			V3 = round(V3, read64(Pointer)); Pointer += 8;
+			V4 = round(V4, read64(Pointer)); Pointer += 8;
+		}
+		while(Pointer <= Limit);
+
+		Hash = rotl(V1, 1) + rotl(V2, 7) + rotl(V3, 12) + rotl(V4, 18);
+		Hash = merge_round(Hash, V1);
+		Hash = merge_round(Hash, V2);
+		Hash = merge_round(Hash, V3);
+		Hash = merge_round(Hash, V4);
+	}
+	else
+	{
+		Hash = Seed + PRIME64_5;
+	}
+
+	Hash += static_cast<glm::u64>(Size);
+
+	for(; Pointer + 8 <= End; Pointer += 8)
+	{
+		Hash ^= round(0, read64(Pointer));
+		Hash = rotl(Hash, 27) * PRIME64_1 + PRIME64_4;
+	}
+
+	if(Pointer + 4 <= End)
+	{
+		Hash ^= static_cast<glm::u64>(read32(Pointer)) * PRIME64_1;
+		Hash = rotl(Hash, 23) * PRIME64_2 + PRIME64_3;
+		Pointer += 4;
+	}
+
+	for(; Pointer < End; ++Pointer)
+	{
+		Hash ^= (*Pointer) * PRIME64_5;
+		Hash = rotl(Hash, 11) * PRIME64_1;
+	}
+
+	Hash ^= Hash >> 33;
+	Hash *= PRIME64_2;
+	Hash ^= Hash >> 29;
+	Hash *= PRIME64_3;
+	Hash ^= Hash >> 32;
+
+	return Hash;
+}
@@ -0,0 +1,8 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <glm/gtc/type_precision.hpp>
+#include <cstddef>
+
+/// 64 bits non-cryptographic hash of Size bytes, following the xxHash64 algorithm
+glm::u64 hash64(void const* Data, std::size_t Size, glm::u64 Seed = 0);
@@ -0,0 +1,256 @@
+#include "headless.hpp"
+#include <GL/glew.h>
+#include <glm/gtc/type_precision.hpp>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#if defined(OGL_SAMPLES_HEADLESS)
+#	define EGL_NO_X11
+#	define MESA_EGL_NO_X11_HEADERS
+#	include <EGL/egl.h>
+#	include <EGL/eglext.h>
+
+#	ifndef EGL_PLATFORM_SURFACELESS_MESA
+#		define EGL_PLATFORM_SURFACELESS_MESA 0x31DD
+#	endif
+#	ifndef EGL_CONTEXT_MAJOR_VERSION_KHR
+#		define EGL_CONTEXT_MAJOR_VERSION_KHR 0x3098
+#		define EGL_CONTEXT_MINOR_VERSION_KHR 0x30FB
+#		define EGL_CONTEXT_FLAGS_KHR 0x30FC
+#		define EGL_CONTEXT_OPENGL_PROFILE_MASK_KHR 0x30FD
+#		define EGL_CONTEXT_OPENGL_DEBUG_BIT_KHR 0x00000001
+#		define EGL_CONTEXT_OPENGL_FORWARD_COMPATIBLE_BIT_KHR 0x00000002
+#		define EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT_KHR 0x00000001
+#		define EGL_CONTEXT_OPENGL_COMPATIBILITY_PROFILE_BIT_KHR 0x00000002
+#		define EGL_OPENGL_ES3_BIT_KHR 0x00000040
+#	endif
+
+namespace
+{
+	bool hasClientExtension(char const* Name)
+	{
+		char const* Extensions = eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS);
+		return Extensions && std::strstr(Extensions, Name) != nullptr;
+	}
+
+	// Prefer the Mesa surfaceless platform which requires neither X nor a DRM device, e.g. llvmpipe on a farm node
+	EGLDisplay getDisplay()
+	{
+		if(hasClientExtension("EGL_MESA_platform_surfaceless") && hasClientExtension("EGL_EXT_platform_base"))
+		{
+			PFNEGLGETPLATFORMDISPLAYEXTPROC GetPlatformDisplay = reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC>(eglGetProcAddress("eglGetPlatformDisplayEXT"));
+			if(GetPlatformDisplay)
+			{
+				EGLDisplay Display = GetPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+				if(Display != EGL_NO_DISPLAY)
+					return Display;
+			}
+		}
+
+		return eglGetDisplay(EGL_DEFAULT_DISPLAY);
+	}
+}//namespace
+#endif//OGL_SAMPLES_HEADLESS
+
+namespace
+{
+	PFNGLCLEARBUFFERFVPROC ClearBufferfv = nullptr;
+
+	// Clears the color buffer of the default framebuffer with glClear which resolves GL_BACK on single buffered surfaces
+	void GLAPIENTRY clear_buffer_fv(GLenum Buffer, GLint DrawBuffer, GLfloat const* Value)
+	{
+		GLint DrawFramebuffer(0);
+		glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &DrawFramebuffer);
+		if(Buffer != GL_COLOR || DrawFramebuffer != 0)
+		{
+			ClearBufferfv(Buffer, DrawBuffer, Value);
+			return;
+		}
+
+		GLfloat ClearColor[4];
+		glGetFloatv(GL_COLOR_CLEAR_VALUE, ClearColor);
+		glClearColor(Value[0], Value[1], Value[2], Value[3]);
+		glClear(GL_COLOR_BUFFER_BIT);
+		glClearColor(ClearColor[0], ClearColor[1], ClearColor[2], ClearColor[3]);
+	}
+}//namespace
+
+headless::headless() :
+	Display(nullptr),
+	Surface(nullptr),
+	Context(nullptr),
+	Size(0)
+{}
+
+headless::~headless()
+{
+	this->destroy();
+}
+
+bool headless::create(api API, int Major, int Minor, glm::ivec2 const & Size, bool Debug)
+{
+#	if defined(OGL_SAMPLES_HEADLESS)
+		EGLDisplay Display = getDisplay();
+		if(Display == EGL_NO_DISPLAY || !eglInitialize(Display, nullptr, nullptr))
+		{
+			fprintf(stderr, "Headless: failed to initialize an EGL display\n");
+			return false;
+		}
+		this->Display = Display;
+
+		if(!eglBindAPI(API == OPENGL_ES ? EGL_OPENGL_ES_API : EGL_OPENGL_API))
+		{
+			fprintf(stderr, "Headless: the EGL implementation doesn't support the requested API\n");
+			this->destroy();
+			return false;
+		}
+
+		EGLint const RenderableType = API != OPENGL_ES ? EGL_OPENGL_BIT : (Major >= 3 ? EGL_OPENGL_ES3_BIT_KHR : EGL_OPENGL_ES2_BIT);
+		EGLint const ConfigAttribs[] =
+		{
+			EGL_SURFACE_TYPE, EGL_PBUFFER_BIT,
+			EGL_RENDERABLE_TYPE, RenderableType,
+			EGL_RED_SIZE, 8,
+			EGL_GREEN_SIZE, 8,
+			EGL_BLUE_SIZE, 8,
+			EGL_ALPHA_SIZE, 8,
+			EGL_DEPTH_SIZE, 24,
+			EGL_STENCIL_SIZE, 8,
+			EGL_NONE
+		};
+
+		EGLConfig Config = nullptr;
+		EGLint ConfigCount = 0;
+		if(!eglChooseConfig(Display, ConfigAttribs, &Config, 1, &ConfigCount) || ConfigCount == 0)
+		{
+			fprintf(stderr, "Headless: no EGL pbuffer configuration matches RGBA8 D24S8\n");
+			this->destroy();
+			return false;
+		}
+
+		EGLint const SurfaceAttribs[] =
+		{
+			EGL_WIDTH, Size.x,
+			EGL_HEIGHT, Size.y,
+			EGL_NONE
+		};
+
+		this->Surface = eglCreatePbufferSurface(Display, Config, SurfaceAttribs);
+		if(this->Surface == EGL_NO_SURFACE)
+		{
+			fprintf(stderr, "Headless: failed to create a %dx%d pbuffer\n", Size.x, Size.y);
+			this->destroy();
+			return false;
+		}
+
+		std::vector<EGLint> ContextAttribs;
+		ContextAttribs.push_back(EGL_CONTEXT_MAJOR_VERSION_KHR);
+		ContextAttribs.push_back(Major);
+		ContextAttribs.push_back(EGL_CONTEXT_MINOR_VERSION_KHR);
+		ContextAttribs.push_back(Minor);
+		if(API != OPENGL_ES && Major * 10 + Minor >= 32)
+		{
+			ContextAttribs.push_back(EGL_CONTEXT_OPENGL_PROFILE_MASK_KHR);
+			ContextAttribs.push_back(API == OPENGL_CORE ? EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT_KHR : EGL_CONTEXT_OPENGL_COMPATIBILITY_PROFILE_BIT_KHR);
+		}
+		EGLint Flags = 0;
+		if(API == OPENGL_CORE && Major * 10 + Minor >= 32)
+			Flags |= EGL_CONTEXT_OPENGL_FORWARD_COMPATIBLE_BIT_KHR;
+		if(Debug)
+			Flags |= EGL_CONTEXT_OPENGL_DEBUG_BIT_KHR;
+		if(Flags)
+		{
+			ContextAttribs.push_back(EGL_CONTEXT_FLAGS_KHR);
+			ContextAttribs.push_back(Flags);
+		}
+		ContextAttribs.push_back(EGL_NONE);
+
+		this->Context = eglCreateContext(Display, Config, EGL_NO_CONTEXT, &ContextAttribs[0]);
+		if(this->Context == EGL_NO_CONTEXT)
+		{
+			fprintf(stderr, "Headless: failed to create an OpenGL%s %d.%d context\n", API == OPENGL_ES ? " ES" : "", Major, Minor);
+			this->Context = nullptr;
+			this->destroy();
+			return false;
+		}
+
+		if(!eglMakeCurrent(Display, this->Surface, this->Surface, this->Context))
+		{
+			fprintf(stderr, "Headless: failed to make the context current\n");
+			this->destroy();
+			return false;
+		}
+
+		this->Size = Size;
+		return true;
+#	else
+		(void)API; (void)Major; (void)Minor; (void)Size; (void)Debug;
+		fprintf(stderr, "Headless: EGL wasn't found when building the OpenGL Samples Pack\n");
+		return false;
+#	endif
+}
+
+void headless::destroy()
+{
+#	if defined(OGL_SAMPLES_HEADLESS)
+		if(this->Display)
+		{
+			eglMakeCurrent(this->Display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+			if(this->Context)
+				eglDestroyContext(this->Display, this->Context);
+			if(this->Surface && this->Surface != EGL_NO_SURFACE)
+				eglDestroySurface(this->Display, this->Surface);
+			eglTerminate(this->Display);
+		}
+#	endif
+
+	this->Display = nullptr;
+	this->Surface = nullptr;
+	this->Context = nullptr;
+	this->Size = glm::ivec2(0);
+}
+
+void headless::patchFunctions()
+{
+	if(!this->Context || !glClearBufferfv || glClearBufferfv == &clear_buffer_fv)
+		return;
+
+	// Mesa pbuffers are single buffered and report GL_BACK as draw buffer, yet glClearBuffer* doesn't find a back buffer
+	// to clear while draws and glClear do. Only route the default framebuffer clears through glClear when affected.
+	// A new surface holds garbage so it is cleared to black first, otherwise the probe reads whatever was there.
+	glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+	glClear(GL_COLOR_BUFFER_BIT);
+
+	GLfloat const White[] = {1.0f, 1.0f, 1.0f, 1.0f};
+	glClearBufferfv(GL_COLOR, 0, White);
+
+	glm::u8vec4 Texel(0);
+	glReadPixels(0, 0, 1, 1, GL_RGBA, GL_UNSIGNED_BYTE, &Texel[0]);
+
+	if(Texel.r != 255)
+	{
+		ClearBufferfv = glClearBufferfv;
+		glClearBufferfv = &clear_buffer_fv;
+	}
+
+	glClear(GL_COLOR_BUFFER_BIT);
+}
+
+void headless::swap()
+{
+#	if defined(OGL_SAMPLES_HEADLESS)
+		if(this->Context)
+			eglSwapBuffers(this->Display, this->Surface);
+#	endif
+}
+
+void headless::swapInterval(int Interval)
+{
+#	if defined(OGL_SAMPLES_HEADLESS)
+		if(this->Context)
+			eglSwapInterval(this->Display, Interval);
+#	else
+		(void)Interval;
+#	endif
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+/// Off-screen OpenGL context created with EGL, without any window system.
+/// The context renders into a pbuffer surface of the requested size which is the default framebuffer of the
+/// context, so framebuffer 0, glReadPixels and the templates checks behave as with a window.
+/// Only available when the build found EGL (OGL_SAMPLES_HEADLESS), create() fails otherwise.
+class headless
+{
+public:
+	enum api
+	{
+		OPENGL_CORE,
+		OPENGL_COMPATIBILITY,
+		OPENGL_ES
+	};
+
+	headless();
+	~headless();
+
+	bool create(api API, int Major, int Minor, glm::ivec2 const & Size, bool Debug);
+	void destroy();
+
+	bool empty() const {return this->Context == nullptr;}
+	glm::ivec2 size() const {return this->Size;}
+
+	/// Works around the driver bugs specific to off-screen surfaces, called once the OpenGL functions are loaded
+	void patchFunctions();
+
+	void swap();
+	void swapInterval(int Interval);
+
+private:
+	headless(headless const &);
+	headless& operator=(headless const &);
+
+	void* Display;
+	void* Surface;
+	void* Context;
+	glm::ivec2 Size;
+};
@@ -0,0 +1,98 @@
+#include "histogram.hpp"
+#include <glm/integer.hpp>
+#include <limits>
+
+histogram::histogram()
+{
+	this->clear();
+}
+
+void histogram::clear()
+{
+	this->Buckets.fill(0);
+	this->Count = 0;
+	this->Min = std::numeric_limits<glm::u64>::max();
+	this->Max = 0;
+	this->Last = 0;
+	this->Sum = 0.0;
+	this->JitterSum = 0.0;
+}
+
+std::size_t histogram::bucket(glm::u64 Value)
+{
+	if(Value < LINEAR_COUNT)
+		return static_cast<std::size_t>(Value);
+
+	// Keep the SUB_BUCKET_BITS + 1 most significant bits, the top one is implicit
+	int const MostSignificantBit = Value >> 32 ? 32 + glm::findMSB(static_cast<glm::uint>(Value >> 32)) : glm::findMSB(static_cast<glm::uint>(Value));
+	int const Shift = MostSignificantBit - SUB_BUCKET_BITS;
+	std::size_t const Bucket = LINEAR_COUNT + (Shift - 1) * SUB_BUCKET_COUNT + static_cast<std::size_t>((Value >> Shift) - SUB_BUCKET_COUNT);
+
+	return glm::min<std::size_t>(Bucket, BUCKET_COUNT - 1);
+}
+
+double histogram::bucketMidpoint(std::size_t Bucket)
+{
+	if(Bucket < LINEAR_COUNT)
+		return static_cast<double>(Bucket);
+
+	std::size_t const Shift = (Bucket - LINEAR_COUNT) / SUB_BUCKET_COUNT + 1;
+	std::size_t const Mantissa = (Bucket - LINEAR_COUNT) % SUB_BUCKET_COUNT + SUB_BUCKET_COUNT;
+	double const Lower = static_cast<double>(static_cast<glm::u64>(Mantissa) << Shift);
+	double const Width = static_cast<double>(glm::u64(1) << Shift);
+
+	return Lower + (Width - 1.0) * 0.5;
+}
+
+void histogram::record(glm::u64 Nanoseconds)
+{
+	++this->Buckets[bucket(Nanoseconds)];
+
+	if(this->Count > 0)
+		this->JitterSum += static_cast<double>(Nanoseconds > this->Last ? Nanoseconds - this->Last : this->Last - Nanoseconds);
+
+	++this->Count;
+	this->Min = glm::min(this->Min, Nanoseconds);
+	this->Max = glm::max(this->Max, Nanoseconds);
+	this->Last = Nanoseconds;
+	this->Sum += static_cast<double>(Nanoseconds);
+}
+
+double histogram::percentile(double Percentile) const
+{
+	if(this->Count == 0)
+		return 0.0;
+
+	glm::u64 const Rank = glm::max<glm::u64>(static_cast<glm::u64>(glm::ceil(Percentile / 100.0 * static_cast<double>(this->Count))), 1);
+
+	glm::u64 Accumulated = 0;
+	for(std::size_t Bucket = 0; Bucket < this->Buckets.size(); ++Bucket)
+	{
+		Accumulated += this->Buckets[Bucket];
+		if(Accumulated >= Rank)
+			return glm::clamp(bucketMidpoint(Bucket), static_cast<double>(this->Min), static_cast<double>(this->Max));
+	}
+
+	return static_cast<double>(this->Max);
+}
+
+histogram_summary histogram::summary() const
+{
+	double const Millisecond = 1.0e-6;
+
+	histogram_summary Summary;
+	Summary.Count = this->count();
+	if(this->Count == 0)
+		return Summary;
+
+	Summary.Mean = this->Sum / static_cast<double>(this->Count) * Millisecond;
+	Summary.Min = static_cast<double>(this->Min) * Millisecond;
+	Summary.Max = static_cast<double>(this->Max) * Millisecond;
+	Summary.P50 = this->percentile(50.0) * Millisecond;
+	Summary.P90 = this->percentile(90.0) * Millisecond;
+	Summary.P99 = this->percentile(99.0) * Millisecond;
+	Summary.P999 = this->percentile(99.9) * Millisecond;
+	Summary.Jitter = this->Count > 1 ? this->JitterSum / static_cast<double>(this->Count - 1) * Millisecond : 0.0;
+
+	return Summary;
+}
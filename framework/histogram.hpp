@@ -0,0 +1,62 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <glm/gtc/type_precision.hpp>
+#include <array>
+#include <cstddef>
+
+/// Summary of the durations recorded by a histogram, in milliseconds
+struct histogram_summary
+{
+	histogram_summary() :
+		Count(0),
+		Mean(0.0), Min(0.0), Max(0.0),
+		P50(0.0), P90(0.0), P99(0.0), P999(0.0),
+		Jitter(0.0)
+	{}
+
+	std::size_t Count;
+	double Mean, Min, Max;
+	double P50, P90, P99, P999;
+	/// Mean absolute difference between consecutive durations
+	double Jitter;
+};
+
+/// Fixed memory log-linear histogram of durations in nanoseconds, the same layout as HdrHistogram:
+/// linear buckets up to LINEAR_COUNT then SUB_BUCKET_COUNT buckets per power of two, ie a relative precision of 1/64
+/// up to 2^40 ns (18 minutes). Min, max, mean and jitter are exact, percentiles are bucket midpoints.
+class histogram
+{
+public:
+	enum
+	{
+		SUB_BUCKET_BITS = 6,
+		SUB_BUCKET_COUNT = 1 << SUB_BUCKET_BITS,
+		LINEAR_COUNT = SUB_BUCKET_COUNT * 2,
+		MAX_VALUE_BITS = 40,
+		BUCKET_COUNT = LINEAR_COUNT + (MAX_VALUE_BITS - SUB_BUCKET_BITS - 1) * SUB_BUCKET_COUNT
+	};
+
+	histogram();
+
+	void record(glm::u64 Nanoseconds);
+	void clear();
+
+	std::size_t count() const {return static_cast<std::size_t>(this->Count);}
+
+	/// Duration in nanoseconds below which Percentile percents of the recorded durations fall
+	double percentile(double Percentile) const;
+	histogram_summary summary() const;
+
+private:
+	static std::size_t bucket(glm::u64 Value);
+	static double bucketMidpoint(std::size_t Bucket);
+
+	std::array<glm::u64, BUCKET_COUNT> Buckets;
+	glm::u64 Count;
+	glm::u64 Min;
+	glm::u64 Max;
+	glm::u64 Last;
+	double Sum;
+	double JitterSum;
+};
@@ -0,0 +1,101 @@
+#include "mapped_file.hpp"
+
+#if defined(_WIN32)
+#	define WIN32_LEAN_AND_MEAN
+#	define NOMINMAX
+#	include <windows.h>
+#else
+#	include <sys/mman.h>
+#	include <sys/stat.h>
+#	include <fcntl.h>
+#	include <unistd.h>
+#endif
+
+mapped_file::mapped_file() :
+	Data(nullptr),
+	Size(0)
+#	if defined(_WIN32)
+		, File(INVALID_HANDLE_VALUE)
+		, Mapping(nullptr)
+#	endif
+{}
+
+mapped_file::~mapped_file()
+{
+	this->close();
+}
+
+bool mapped_file::open(std::string const & Filename)
+{
+	this->close();
+
+#	if defined(_WIN32)
+		this->File = CreateFileA(Filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+		if(this->File == INVALID_HANDLE_VALUE)
+			return false;
+
+		LARGE_INTEGER FileSize;
+		if(!GetFileSizeEx(this->File, &FileSize) || FileSize.QuadPart == 0)
+		{
+			this->close();
+			return false;
+		}
+
+		this->Mapping = CreateFileMappingA(this->File, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if(!this->Mapping)
+		{
+			this->close();
+			return false;
+		}
+
+		this->Data = MapViewOfFile(this->Mapping, FILE_MAP_READ, 0, 0, 0);
+		this->Size = static_cast<std::size_t>(FileSize.QuadPart);
+#	else
+		int const File = ::open(Filename.c_str(), O_RDONLY);
+		if(File == -1)
+			return false;
+
+		struct stat Stat;
+		if(fstat(File, &Stat) != 0 || Stat.st_size == 0)
+		{
+			::close(File);
+			return false;
+		}
+
+		void* Pointer = mmap(nullptr, static_cast<std::size_t>(Stat.st_size), PROT_READ, MAP_PRIVATE, File, 0);
+		::close(File);
+		if(Pointer == MAP_FAILED)
+			return false;
+
+		this->Data = Pointer;
+		this->Size = static_cast<std::size_t>(Stat.st_size);
+#	endif
+
+	if(!this->Data)
+	{
+		this->close();
+		return false;
+	}
+
+	return true;
+}
+
+void mapped_file::close()
+{
+#	if defined(_WIN32)
+		if(this->Data)
+			UnmapViewOfFile(this->Data);
+		if(this->Mapping)
+			CloseHandle(this->Mapping);
+		if(this->File != INVALID_HANDLE_VALUE)
+			CloseHandle(this->File);
+		this->Mapping = nullptr;
+		this->File = INVALID_HANDLE_VALUE;
+#	else
+		if(this->Data)
+			munmap(const_cast<void*>(this->Data), this->Size);
+#	endif
+
+	this->Data = nullptr;
+	this->Size = 0;
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+/// Read-only mapping of a whole file in the process address space
+class mapped_file
+{
+public:
+	mapped_file();
+	~mapped_file();
+
+	bool open(std::string const & Filename);
+	void close();
+
+	bool empty() const {return this->Data == nullptr;}
+	void const* data() const {return this->Data;}
+	std::size_t size() const {return this->Size;}
+
+private:
+	mapped_file(mapped_file const &);
+	mapped_file& operator=(mapped_file const &);
+
+	void const* Data;
+	std::size_t Size;
+#	if defined(_WIN32)
+		void* File;
+		void* Mapping;
+#	endif
+};
@@ -0,0 +1,107 @@
+#include "parallel.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+
+thread_pool::thread_pool() :
+	Job(nullptr),
+	Generation(0),
+	Pending(0),
+	Running(0),
+	Busy(false),
+	Stop(false)
+{
+	std::size_t ThreadCount = std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+
+	// Processes running side by side, like the sample-orchestrator workers, share the cores through this cap
+	if(char const* Cap = std::getenv("OGL_SAMPLES_THREADS"))
+		if(std::atoi(Cap) > 0)
+			ThreadCount = std::min<std::size_t>(ThreadCount, std::atoi(Cap));
+
+	this->Threads.reserve(ThreadCount - 1);
+	for(std::size_t ThreadIndex = 1; ThreadIndex < ThreadCount; ++ThreadIndex)
+		this->Threads.push_back(std::thread(&thread_pool::work, this));
+}
+
+thread_pool::~thread_pool()
+{
+	{
+		std::lock_guard<std::mutex> Lock(this->Mutex);
+		this->Stop = true;
+	}
+	this->Started.notify_all();
+
+	for(std::size_t ThreadIndex = 0; ThreadIndex < this->Threads.size(); ++ThreadIndex)
+		this->Threads[ThreadIndex].join();
+}
+
+bool thread_pool::isPoolThread() const
+{
+	std::thread::id const Id = std::this_thread::get_id();
+	for(std::size_t ThreadIndex = 0; ThreadIndex < this->Threads.size(); ++ThreadIndex)
+		if(this->Threads[ThreadIndex].get_id() == Id)
+			return true;
+	return false;
+}
+
+void thread_pool::run(std::size_t WorkerCount, std::function<void()> const & Job)
+{
+	std::unique_lock<std::mutex> Lock(this->Mutex);
+	if(WorkerCount <= 1 || this->Threads.empty() || this->Busy || this->isPoolThread())
+	{
+		Lock.unlock();
+		Job();
+		return;
+	}
+
+	this->Busy = true;
+	this->Job = &Job;
+	this->Pending = std::min(WorkerCount - 1, this->Threads.size());
+	this->Running = this->Pending;
+	++this->Generation;
+	Lock.unlock();
+	this->Started.notify_all();
+
+	Job();
+
+	Lock.lock();
+	this->Finished.wait(Lock, [this]{return this->Running == 0;});
+	this->Job = nullptr;
+	this->Busy = false;
+}
+
+void thread_pool::work()
+{
+	std::size_t Generation = 0;
+	for(;;)
+	{
+		std::function<void()> const* Job = nullptr;
+		{
+			std::unique_lock<std::mutex> Lock(this->Mutex);
+			this->Started.wait(Lock, [&]{return this->Stop || (this->Generation != Generation && this->Pending > 0);});
+			if(this->Stop)
+				return;
+
+			Generation = this->Generation;
+			--this->Pending;
+			Job = this->Job;
+		}
+
+		(*Job)();
+
+		std::lock_guard<std::mutex> Lock(this->Mutex);
+		if(--this->Running == 0)
+			this->Finished.notify_one();
+	}
+}
+
+thread_pool& get_thread_pool()
+{
+	static thread_pool Pool;
+	return Pool;
+}
+
+void run_on_thread_pool(std::size_t WorkerCount, std::function<void()> const & Job)
+{
+	get_thread_pool().run(WorkerCount, Job);
+}
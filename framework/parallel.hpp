@@ -0,0 +1,90 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <atomic>
+#include <cassert>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/// Process-wide pool of the threads running parallel_for, started on first use so that the comparisons of each
+/// checkTemplate call don't create and join threads. The pool uses all the hardware threads, at most the positive
+/// value of the OGL_SAMPLES_THREADS environment variable when it is set.
+class thread_pool
+{
+public:
+	thread_pool();
+	~thread_pool();
+
+	/// Number of threads running a job, the calling thread included
+	std::size_t size() const {return this->Threads.size() + 1;}
+
+	/// Call Job on WorkerCount threads, the calling thread included, and return once every call returned.
+	/// A job started from a pool thread or while another job runs is only called by the calling thread.
+	void run(std::size_t WorkerCount, std::function<void()> const & Job);
+
+private:
+	thread_pool(thread_pool const &);
+	thread_pool& operator=(thread_pool const &);
+
+	void work();
+	bool isPoolThread() const;
+
+	std::mutex Mutex;
+	/// Signaled when a job is started or the pool is destroyed
+	std::condition_variable Started;
+	/// Signaled when the last pool thread running a job returns
+	std::condition_variable Finished;
+	std::vector<std::thread> Threads;
+	std::function<void()> const* Job;
+	std::size_t Generation;
+	/// Pool threads which still have to pick the current job
+	std::size_t Pending;
+	/// Pool threads which picked the current job or still have to, until they return from it
+	std::size_t Running;
+	bool Busy;
+	bool Stop;
+};
+
+thread_pool& get_thread_pool();
+
+/// thread_pool::run on the process-wide pool, installed as the runner of the gli box filter mipmaps
+void run_on_thread_pool(std::size_t WorkerCount, std::function<void()> const & Job);
+
+/// Split [0, Count) into tiles of TileSize items processed by the threads of the pool.
+/// Task is called as Task(Begin, End, Stop) and returns false on failure. Any failure raises Stop, which
+/// prevents the other workers from picking new tiles and lets long running tasks exit early.
+/// Returns true when every task succeeded.
+template <typename task>
+bool parallel_for(std::size_t Count, std::size_t TileSize, task const& Task)
+{
+	assert(TileSize > 0);
+
+	std::size_t const TileCount = (Count + TileSize - 1) / TileSize;
+	if(TileCount == 0)
+		return true;
+
+	thread_pool& Pool = get_thread_pool();
+	std::size_t const WorkerCount = glm::clamp<std::size_t>(Pool.size(), 1, TileCount);
+
+	std::atomic<std::size_t> NextTile(0);
+	std::atomic<bool> Stop(false);
+
+	std::function<void()> const Worker = [&]()
+	{
+		for(std::size_t Tile = NextTile++; Tile < TileCount && !Stop; Tile = NextTile++)
+		{
+			std::size_t const Begin = Tile * TileSize;
+			std::size_t const End = glm::min(Begin + TileSize, Count);
+			if(!Task(Begin, End, Stop))
+				Stop = true;
+		}
+	};
+
+	Pool.run(WorkerCount, Worker);
+
+	return !Stop;
+}
@@ -0,0 +1,432 @@
+#include "program_cache.hpp"
+#include "compiler_telemetry.hpp"
+#include "source_cache.hpp"
+#include "hash.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#if defined(_WIN32)
+#	include <direct.h>
+#	include <process.h>
+#else
+#	include <sys/stat.h>
+#	include <sys/types.h>
+#	include <unistd.h>
+#endif
+
+std::string format(const char* Message, ...);
+std::string getBinaryDirectory();
+
+namespace
+{
+	glm::u32 const BINARY_MAGIC = 0x50434C47; // "GLCP"
+	glm::u32 const BINARY_VERSION = 1;
+
+	/// Header of a cached program binary, the payload follows
+	struct binary_header
+	{
+		glm::u32 Magic;
+		glm::u32 Version;
+		glm::u64 Key;
+		glm::u32 Format;
+		glm::u32 Size;
+		glm::u64 Checksum;
+	};
+
+	PFNGLCREATESHADERPROC CreateShader = nullptr;
+	PFNGLSHADERSOURCEPROC ShaderSource = nullptr;
+	PFNGLDELETESHADERPROC DeleteShader = nullptr;
+	PFNGLCREATEPROGRAMPROC CreateProgram = nullptr;
+	PFNGLLINKPROGRAMPROC LinkProgram = nullptr;
+	PFNGLPROGRAMPARAMETERIPROC ProgramParameteri = nullptr;
+	PFNGLBINDATTRIBLOCATIONPROC BindAttribLocation = nullptr;
+	PFNGLBINDFRAGDATALOCATIONPROC BindFragDataLocation = nullptr;
+	PFNGLBINDFRAGDATALOCATIONINDEXEDPROC BindFragDataLocationIndexed = nullptr;
+	PFNGLTRANSFORMFEEDBACKVARYINGSPROC TransformFeedbackVaryings = nullptr;
+
+	// A shader name only maps to the hash of its source until the source changes or the name is reused
+	GLuint GLAPIENTRY create_shader(GLenum Type)
+	{
+		GLuint const ShaderName = CreateShader(Type);
+		get_program_cache().forgetShader(ShaderName);
+		return ShaderName;
+	}
+
+	void GLAPIENTRY shader_source(GLuint ShaderName, GLsizei Count, GLchar const* const* Strings, GLint const* Lengths)
+	{
+		get_program_cache().forgetShader(ShaderName);
+		ShaderSource(ShaderName, Count, Strings, Lengths);
+	}
+
+	// A shader still attached to a program is only flagged for deletion and keeps its source until it is detached
+	void GLAPIENTRY delete_shader(GLuint ShaderName)
+	{
+		DeleteShader(ShaderName);
+		if(!glIsShader(ShaderName))
+			get_program_cache().forgetShader(ShaderName);
+	}
+
+	// The state set before a link changes the binary, it is hashed into the key of the program
+	GLuint GLAPIENTRY create_program()
+	{
+		GLuint const ProgramName = CreateProgram();
+		get_program_cache().resetState(ProgramName);
+		return ProgramName;
+	}
+
+	void GLAPIENTRY link_program(GLuint ProgramName)
+	{
+		program_cache& Cache = get_program_cache();
+		std::size_t const Hits = Cache.hits();
+		double const Start = telemetry_time();
+		Cache.link(ProgramName);
+		get_compiler_telemetry().recordLink(ProgramName, telemetry_time() - Start, Cache.hits() != Hits);
+	}
+
+	void GLAPIENTRY program_parameteri(GLuint ProgramName, GLenum Name, GLint Value)
+	{
+		GLint const State[] = {static_cast<GLint>(Name), Value};
+		get_program_cache().recordState(ProgramName, State, sizeof(State));
+		ProgramParameteri(ProgramName, Name, Value);
+	}
+
+	void GLAPIENTRY bind_attrib_location(GLuint ProgramName, GLuint Index, GLchar const* Name)
+	{
+		get_program_cache().recordState(ProgramName, &Index, sizeof(Index));
+		get_program_cache().recordState(ProgramName, Name, std::strlen(Name));
+		BindAttribLocation(ProgramName, Index, Name);
+	}
+
+	void GLAPIENTRY bind_frag_data_location(GLuint ProgramName, GLuint Color, GLchar const* Name)
+	{
+		get_program_cache().recordState(ProgramName, &Color, sizeof(Color));
+		get_program_cache().recordState(ProgramName, Name, std::strlen(Name));
+		BindFragDataLocation(ProgramName, Color, Name);
+	}
+
+	void GLAPIENTRY bind_frag_data_location_indexed(GLuint ProgramName, GLuint Color, GLuint Index, GLchar const* Name)
+	{
+		GLuint const State[] = {Color, Index};
+		get_program_cache().recordState(ProgramName, State, sizeof(State));
+		get_program_cache().recordState(ProgramName, Name, std::strlen(Name));
+		BindFragDataLocationIndexed(ProgramName, Color, Index, Name);
+	}
+
+	void GLAPIENTRY transform_feedback_varyings(GLuint ProgramName, GLsizei Count, GLchar const* const* Varyings, GLenum BufferMode)
+	{
+		get_program_cache().recordState(ProgramName, &BufferMode, sizeof(BufferMode));
+		for(GLsizei VaryingIndex = 0; VaryingIndex < Count; ++VaryingIndex)
+			get_program_cache().recordState(ProgramName, Varyings[VaryingIndex], std::strlen(Varyings[VaryingIndex]) + 1);
+		TransformFeedbackVaryings(ProgramName, Count, Varyings, BufferMode);
+	}
+
+	template <typename proc>
+	void patch(proc & Function, proc & Real, proc Replacement)
+	{
+		if(!Function || Function == Replacement)
+			return;
+		Real = Function;
+		Function = Replacement;
+	}
+
+	glm::u64 hash_string(GLenum Name, glm::u64 Seed)
+	{
+		char const* String = reinterpret_cast<char const*>(glGetString(Name));
+		return String ? hash64(String, std::strlen(String), Seed) : Seed;
+	}
+
+	void make_directory(std::string const & Path)
+	{
+#		if defined(_WIN32)
+			_mkdir(Path.c_str());
+#		else
+			mkdir(Path.c_str(), 0755);
+#		endif
+	}
+
+	// Unique per process so that concurrent sample-orchestrator workers never write the same temporary file
+	std::string temporary_path(std::string const & Path)
+	{
+#		if defined(_WIN32)
+			return format("%s.%d.tmp", Path.c_str(), _getpid());
+#		else
+			return format("%s.%d.tmp", Path.c_str(), static_cast<int>(getpid()));
+#		endif
+	}
+
+	// Writes next to Path then renames so that readers only ever see complete files
+	bool write_atomic(std::string const & Path, void const* Header, std::size_t HeaderSize, void const* Data, std::size_t Size)
+	{
+		std::string const TemporaryPath = temporary_path(Path);
+
+		FILE* File = fopen(TemporaryPath.c_str(), "wb");
+		if(!File)
+			return false;
+
+		bool const Written = fwrite(Header, HeaderSize, 1, File) == 1 && (Size == 0 || fwrite(Data, Size, 1, File) == 1);
+		bool const Closed = fclose(File) == 0;
+
+		if(Written && Closed)
+		{
+#			if defined(_WIN32)
+				std::remove(Path.c_str());
+#			endif
+			if(std::rename(TemporaryPath.c_str(), Path.c_str()) == 0)
+				return true;
+		}
+
+		std::remove(TemporaryPath.c_str());
+		return false;
+	}
+}//namespace
+
+program_cache::program_cache() :
+	ContextHash(0),
+	Enabled(true),
+	Supported(false),
+	Hits(0),
+	Misses(0),
+	Rejects(0)
+{}
+
+void program_cache::setEnabled(bool Enabled)
+{
+	this->Enabled = Enabled;
+}
+
+void program_cache::patchFunctions()
+{
+	this->Supported = false;
+	if(!glLinkProgram || !glCreateProgram)
+		return;
+
+	// Links are redirected without program binaries too so that compiler telemetry records them, only the cache is
+	// disabled
+	GLint FormatCount = 0;
+	if(glGetProgramBinary && glProgramBinary && glProgramParameteri)
+		glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &FormatCount);
+	this->Supported = FormatCount > 0;
+
+	this->ContextHash = hash_string(GL_VERSION, hash_string(GL_RENDERER, hash_string(GL_VENDOR, 0)));
+
+	patch(glCreateShader, CreateShader, &create_shader);
+	patch(glShaderSource, ShaderSource, &shader_source);
+	patch(glDeleteShader, DeleteShader, &delete_shader);
+	patch(glCreateProgram, CreateProgram, &create_program);
+	patch(glLinkProgram, LinkProgram, &link_program);
+	patch(glProgramParameteri, ProgramParameteri, &program_parameteri);
+	patch(glBindAttribLocation, BindAttribLocation, &bind_attrib_location);
+	patch(glBindFragDataLocation, BindFragDataLocation, &bind_frag_data_location);
+	patch(glBindFragDataLocationIndexed, BindFragDataLocationIndexed, &bind_frag_data_location_indexed);
+	patch(glTransformFeedbackVaryings, TransformFeedbackVaryings, &transform_feedback_varyings);
+}
+
+bool program_cache::deferCompile(GLuint ShaderName, GLenum Type, std::string const & Source)
+{
+	shader Shader;
+	Shader.Hash = hash64(Source.data(), Source.size(), hash64(&Type, sizeof(Type), this->ContextHash));
+	Shader.Deferred = false;
+
+	// A marker file records that a source compiled and linked successfully on this renderer, the hash of the source
+	// is seeded with GL_VENDOR, GL_RENDERER and GL_VERSION so that a driver update compiles every shader again
+	if(this->Enabled && this->Supported)
+	{
+		if(this->CompiledShaders.find(Shader.Hash) == this->CompiledShaders.end())
+			if(stamp_file(this->directory() + format("%016llx.shader", static_cast<unsigned long long>(Shader.Hash))).Exists)
+				this->CompiledShaders.insert(Shader.Hash);
+		Shader.Deferred = this->CompiledShaders.find(Shader.Hash) != this->CompiledShaders.end();
+	}
+
+	this->Shaders[ShaderName] = Shader;
+	return Shader.Deferred;
+}
+
+bool program_cache::isDeferred(GLuint ShaderName) const
+{
+	std::map<GLuint, shader>::const_iterator Iterator = this->Shaders.find(ShaderName);
+	return Iterator != this->Shaders.end() && Iterator->second.Deferred;
+}
+
+void program_cache::forgetShader(GLuint ShaderName)
+{
+	this->Shaders.erase(ShaderName);
+}
+
+void program_cache::recordState(GLuint ProgramName, void const* Data, std::size_t Size)
+{
+	glm::u64& State = this->States[ProgramName];
+	State = hash64(Data, Size, State);
+}
+
+void program_cache::resetState(GLuint ProgramName)
+{
+	this->States.erase(ProgramName);
+}
+
+void program_cache::compileDeferred(GLuint ProgramName)
+{
+	GLint ShaderCount = 0;
+	glGetProgramiv(ProgramName, GL_ATTACHED_SHADERS, &ShaderCount);
+	if(ShaderCount <= 0)
+		return;
+
+	std::vector<GLuint> ShaderNames(static_cast<std::size_t>(ShaderCount));
+	glGetAttachedShaders(ProgramName, ShaderCount, nullptr, &ShaderNames[0]);
+
+	for(std::size_t ShaderIndex = 0; ShaderIndex < ShaderNames.size(); ++ShaderIndex)
+	{
+		std::map<GLuint, shader>::iterator Iterator = this->Shaders.find(ShaderNames[ShaderIndex]);
+		if(Iterator == this->Shaders.end() || !Iterator->second.Deferred)
+			continue;
+
+		glCompileShader(ShaderNames[ShaderIndex]);
+		Iterator->second.Deferred = false;
+	}
+}
+
+void program_cache::link(GLuint ProgramName)
+{
+	if(!this->Enabled || !this->Supported)
+	{
+		this->compileDeferred(ProgramName);
+		LinkProgram(ProgramName);
+		return;
+	}
+
+	GLint ShaderCount = 0;
+	glGetProgramiv(ProgramName, GL_ATTACHED_SHADERS, &ShaderCount);
+
+	std::vector<GLuint> ShaderNames(static_cast<std::size_t>(glm::max(ShaderCount, 0)));
+	if(ShaderCount > 0)
+		glGetAttachedShaders(ProgramName, ShaderCount, nullptr, &ShaderNames[0]);
+
+	// Only programs built from compiler shaders are cached, any other glShaderSource dropped the hash of the shader
+	std::vector<glm::u64> ShaderHashes;
+	for(std::size_t ShaderIndex = 0; ShaderIndex < ShaderNames.size(); ++ShaderIndex)
+	{
+		std::map<GLuint, shader>::const_iterator Iterator = this->Shaders.find(ShaderNames[ShaderIndex]);
+		if(Iterator == this->Shaders.end())
+		{
+			this->compileDeferred(ProgramName);
+			LinkProgram(ProgramName);
+			return;
+		}
+
+		ShaderHashes.push_back(Iterator->second.Hash);
+	}
+
+	if(ShaderHashes.empty())
+	{
+		LinkProgram(ProgramName);
+		return;
+	}
+
+	// Attachment order doesn't change the program
+	std::sort(ShaderHashes.begin(), ShaderHashes.end());
+
+	glm::u64 Key = hash64(&ShaderHashes[0], ShaderHashes.size() * sizeof(glm::u64), this->ContextHash);
+	std::map<GLuint, glm::u64>::const_iterator State = this->States.find(ProgramName);
+	if(State != this->States.end())
+		Key = hash64(&State->second, sizeof(State->second), Key);
+
+	std::string const Path = this->directory() + format("%016llx.program", static_cast<unsigned long long>(Key));
+
+	if(this->loadBinary(Path, Key, ProgramName))
+	{
+		++this->Hits;
+		return;
+	}
+
+	++this->Misses;
+
+	this->compileDeferred(ProgramName);
+	ProgramParameteri(ProgramName, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+	LinkProgram(ProgramName);
+
+	GLint Status = GL_FALSE;
+	glGetProgramiv(ProgramName, GL_LINK_STATUS, &Status);
+	if(Status != GL_TRUE)
+		return;
+
+	this->saveBinary(Path, Key, ProgramName);
+
+	for(std::size_t ShaderIndex = 0; ShaderIndex < ShaderHashes.size(); ++ShaderIndex)
+	{
+		if(!this->CompiledShaders.insert(ShaderHashes[ShaderIndex]).second)
+			continue;
+
+		binary_header const Marker = {BINARY_MAGIC, BINARY_VERSION, ShaderHashes[ShaderIndex], 0, 0, 0};
+		write_atomic(this->directory() + format("%016llx.shader", static_cast<unsigned long long>(ShaderHashes[ShaderIndex])), &Marker, sizeof(Marker), nullptr, 0);
+	}
+}
+
+bool program_cache::loadBinary(std::string const & Path, glm::u64 Key, GLuint ProgramName)
+{
+	FILE* File = fopen(Path.c_str(), "rb");
+	if(!File)
+		return false;
+
+	binary_header Header;
+	std::vector<glm::u8> Data;
+
+	bool Valid = fread(&Header, sizeof(Header), 1, File) == 1 &&
+		Header.Magic == BINARY_MAGIC && Header.Version == BINARY_VERSION && Header.Key == Key && Header.Size > 0;
+	if(Valid)
+	{
+		Data.resize(Header.Size);
+		Valid = fread(&Data[0], Data.size(), 1, File) == 1 && fgetc(File) == EOF &&
+			hash64(&Data[0], Data.size(), Key) == Header.Checksum;
+	}
+	fclose(File);
+
+	// The driver may still refuse a valid file, e.g. after an update, in which case the program is linked from its sources
+	if(Valid)
+	{
+		glProgramBinary(ProgramName, Header.Format, &Data[0], static_cast<GLsizei>(Data.size()));
+
+		GLint Status = GL_FALSE;
+		glGetProgramiv(ProgramName, GL_LINK_STATUS, &Status);
+		Valid = Status == GL_TRUE;
+	}
+
+	if(!Valid)
+	{
+		++this->Rejects;
+		std::remove(Path.c_str());
+	}
+
+	return Valid;
+}
+
+void program_cache::saveBinary(std::string const & Path, glm::u64 Key, GLuint ProgramName)
+{
+	GLint Size = 0;
+	glGetProgramiv(ProgramName, GL_PROGRAM_BINARY_LENGTH, &Size);
+	if(Size <= 0)
+		return;
+
+	std::vector<glm::u8> Data(static_cast<std::size_t>(Size));
+	GLenum Format = 0;
+	glGetProgramBinary(ProgramName, Size, &Size, &Format, &Data[0]);
+	if(Size <= 0)
+		return;
+
+	binary_header const Header = {BINARY_MAGIC, BINARY_VERSION, Key, Format, static_cast<glm::u32>(Size), hash64(&Data[0], static_cast<std::size_t>(Size), Key)};
+
+	make_directory(this->directory());
+	write_atomic(Path, &Header, sizeof(Header), &Data[0], static_cast<std::size_t>(Size));
+}
+
+std::string program_cache::directory() const
+{
+	return getBinaryDirectory() + "program-cache/";
+}
+
+program_cache& get_program_cache()
+{
+	static program_cache Cache;
+	return Cache;
+}
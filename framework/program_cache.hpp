@@ -0,0 +1,67 @@
+#pragma once
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+#include <glm/gtc/type_precision.hpp>
+
+#include <cstddef>
+#include <map>
+#include <set>
+#include <string>
+
+/// Process-wide on-disk cache of linked program binaries, transparent to the samples.
+/// glLinkProgram is redirected so that a program whose attached shaders were created by a compiler is loaded with
+/// glProgramBinary when the same sources, pre-link state and GL_RENDERER / GL_VERSION were linked before.
+/// Shaders known to compile defer glCompileShader to the link so that a warm run doesn't compile GLSL at all.
+class program_cache
+{
+public:
+	program_cache();
+
+	/// Enabled by default, --no-program-cache disables it
+	void setEnabled(bool Enabled);
+	bool isEnabled() const {return this->Enabled;}
+
+	/// Redirects the program link functions of the current context through the cache
+	void patchFunctions();
+
+	/// Called by compiler::create after glShaderSource, returns true when the compilation is deferred to the link
+	bool deferCompile(GLuint ShaderName, GLenum Type, std::string const & Source);
+	bool isDeferred(GLuint ShaderName) const;
+	/// Called when the source of a shader changes or its name is released, its next link isn't cached unless
+	/// deferCompile records its new source
+	void forgetShader(GLuint ShaderName);
+
+	/// Links loaded from a binary, links compiled and stored, binaries discarded because corrupted or refused by the driver
+	std::size_t hits() const {return this->Hits;}
+	std::size_t misses() const {return this->Misses;}
+	std::size_t rejects() const {return this->Rejects;}
+
+	void link(GLuint ProgramName);
+	void recordState(GLuint ProgramName, void const* Data, std::size_t Size);
+	void resetState(GLuint ProgramName);
+
+private:
+	struct shader
+	{
+		glm::u64 Hash;
+		bool Deferred;
+	};
+
+	void compileDeferred(GLuint ProgramName);
+	bool loadBinary(std::string const & Path, glm::u64 Key, GLuint ProgramName);
+	void saveBinary(std::string const & Path, glm::u64 Key, GLuint ProgramName);
+	std::string directory() const;
+
+	std::map<GLuint, shader> Shaders;
+	std::map<GLuint, glm::u64> States;
+	std::set<glm::u64> CompiledShaders;
+	glm::u64 ContextHash;
+	bool Enabled;
+	bool Supported;
+	std::size_t Hits;
+	std::size_t Misses;
+	std::size_t Rejects;
+};
+
+program_cache& get_program_cache();
@@ -0,0 +1,178 @@
+#include "readback.hpp"
+#include <cassert>
+#include <cstring>
+
+#if GLM_ARCH & GLM_ARCH_SSSE3_BIT
+#	include <tmmintrin.h>
+#elif GLM_ARCH & GLM_ARCH_SSE2_BIT
+#	include <emmintrin.h>
+#endif
+
+void convert_rgba8_to_rgb8(glm::u8 const* Source, glm::u8* Destination, std::size_t TexelCount)
+{
+	std::size_t TexelIndex = 0;
+
+#	if GLM_ARCH & GLM_ARCH_SSSE3_BIT
+	{
+		// Each iteration writes 16 bytes of which only the first 12 are valid, the next iteration overwrites the
+		// remaining 4. Stop while the 16 bytes store still fits in Destination.
+		__m128i const Shuffle = _mm_setr_epi8(0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1);
+		for(; TexelIndex + 6 <= TexelCount; TexelIndex += 4)
+		{
+			__m128i const RGBA = _mm_loadu_si128(reinterpret_cast<__m128i const*>(Source + TexelIndex * 4));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(Destination + TexelIndex * 3), _mm_shuffle_epi8(RGBA, Shuffle));
+		}
+	}
+#	elif GLM_ARCH & GLM_ARCH_SSE2_BIT
+	{
+		// Without byte shuffles, each 64 bits half packs its two texels as RGB0 | RGB1 << 24. The halves are stored 6 bytes
+		// apart with 8 bytes stores, the last one writing up to 14 bytes past the first texel.
+		__m128i const Mask = _mm_set_epi32(0, 0x00FFFFFF, 0, 0x00FFFFFF);
+		for(; TexelIndex + 6 <= TexelCount; TexelIndex += 4)
+		{
+			__m128i const RGBA = _mm_loadu_si128(reinterpret_cast<__m128i const*>(Source + TexelIndex * 4));
+			__m128i const Packed = _mm_or_si128(_mm_and_si128(RGBA, Mask), _mm_slli_epi64(_mm_and_si128(_mm_srli_epi64(RGBA, 32), Mask), 24));
+			_mm_storel_epi64(reinterpret_cast<__m128i*>(Destination + TexelIndex * 3), Packed);
+			_mm_storel_epi64(reinterpret_cast<__m128i*>(Destination + TexelIndex * 3 + 6), _mm_unpackhi_epi64(Packed, Packed));
+		}
+	}
+#	endif
+
+	for(; TexelIndex < TexelCount; ++TexelIndex)
+	{
+		Destination[TexelIndex * 3 + 0] = Source[TexelIndex * 4 + 0];
+		Destination[TexelIndex * 3 + 1] = Source[TexelIndex * 4 + 1];
+		Destination[TexelIndex * 3 + 2] = Source[TexelIndex * 4 + 2];
+	}
+}
+
+readback::readback(bool Asynchronous) :
+	Asynchronous(Asynchronous)
+{}
+
+readback::~readback()
+{
+	while(!this->Live.empty())
+	{
+		this->Free.push_back(this->Live.front());
+		this->Live.pop_front();
+	}
+
+	for(std::size_t TransferIndex = 0; TransferIndex < this->Free.size(); ++TransferIndex)
+	{
+		transfer & Transfer = this->Free[TransferIndex];
+		if(Transfer.Fence)
+			glDeleteSync(Transfer.Fence);
+		if(Transfer.Buffer)
+			glDeleteBuffers(1, &Transfer.Buffer);
+	}
+}
+
+void readback::read(glm::ivec2 const & Size, GLenum Format, GLenum Type)
+{
+	assert(Format == GL_RGBA || Format == GL_RGB);
+	assert(Type == GL_UNSIGNED_BYTE);
+
+	transfer Transfer;
+	if(this->Free.empty())
+	{
+		Transfer.Buffer = 0;
+		Transfer.Capacity = 0;
+		Transfer.Fence = nullptr;
+	}
+	else
+	{
+		Transfer = this->Free.back();
+		this->Free.pop_back();
+	}
+
+	Transfer.Size = Size;
+	Transfer.Format = Format;
+
+	GLsizeiptr const DataSize = static_cast<GLsizeiptr>(Size.x) * Size.y * (Format == GL_RGBA ? 4 : 3);
+
+	GLint PackAlignment(4);
+	glGetIntegerv(GL_PACK_ALIGNMENT, &PackAlignment);
+	glPixelStorei(GL_PACK_ALIGNMENT, 1);
+
+	if(this->Asynchronous)
+	{
+		if(!Transfer.Buffer)
+			glGenBuffers(1, &Transfer.Buffer);
+
+		glBindBuffer(GL_PIXEL_PACK_BUFFER, Transfer.Buffer);
+		if(Transfer.Capacity < DataSize)
+		{
+			glBufferData(GL_PIXEL_PACK_BUFFER, DataSize, nullptr, GL_STREAM_READ);
+			Transfer.Capacity = DataSize;
+		}
+
+		glReadPixels(0, 0, Size.x, Size.y, Format, Type, nullptr);
+		glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+		if(Transfer.Fence)
+			glDeleteSync(Transfer.Fence);
+		Transfer.Fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+	}
+	else
+	{
+		Transfer.Data.resize(DataSize);
+		glReadPixels(0, 0, Size.x, Size.y, Format, Type, &Transfer.Data[0]);
+	}
+
+	glPixelStorei(GL_PACK_ALIGNMENT, PackAlignment);
+
+	this->Live.push_back(Transfer);
+}
+
+bool readback::resolve(glm::u8* Destination)
+{
+	if(this->Live.empty())
+		return false;
+
+	transfer Transfer = this->Live.front();
+	this->Live.pop_front();
+
+	std::size_t const TexelCount = static_cast<std::size_t>(Transfer.Size.x) * Transfer.Size.y;
+	std::size_t const DataSize = TexelCount * (Transfer.Format == GL_RGBA ? 4 : 3);
+
+	bool Success = true;
+	glm::u8 const* Data = nullptr;
+
+	if(this->Asynchronous)
+	{
+		GLenum Status = GL_TIMEOUT_EXPIRED;
+		while(Status == GL_TIMEOUT_EXPIRED)
+			Status = glClientWaitSync(Transfer.Fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000);
+		Success = Status != GL_WAIT_FAILED;
+
+		glBindBuffer(GL_PIXEL_PACK_BUFFER, Transfer.Buffer);
+		if(Success)
+			Data = static_cast<glm::u8 const*>(glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, static_cast<GLsizeiptr>(DataSize), GL_MAP_READ_BIT));
+	}
+	else
+	{
+		Data = &Transfer.Data[0];
+	}
+
+	Success = Success && Data != nullptr;
+
+	if(Success)
+	{
+		if(Transfer.Format == GL_RGBA)
+			convert_rgba8_to_rgb8(Data, Destination, TexelCount);
+		else
+			memcpy(Destination, Data, DataSize);
+	}
+
+	if(this->Asynchronous)
+	{
+		if(Data)
+			glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+		glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+	}
+
+	this->Free.push_back(Transfer);
+
+	return Success;
+}
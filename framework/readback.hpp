@@ -0,0 +1,48 @@
+#pragma once
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+#include <glm/gtc/type_precision.hpp>
+
+#include <deque>
+#include <vector>
+
+/// Convert TexelCount RGBA8 texels to packed RGB8 texels, Source and Destination must not overlap
+void convert_rgba8_to_rgb8(glm::u8 const* Source, glm::u8* Destination, std::size_t TexelCount);
+
+/// Framebuffer readback into packed RGB8 rows.
+/// Asynchronous reads go through a ring of pixel pack buffers followed by a fence so that the transfer overlaps
+/// with the work issued before resolve, e.g. the rendering of the next frame for multi-frame captures.
+/// Synchronous reads are used when pixel pack buffers or fences are not available (OpenGL < 3.2, OpenGL ES 2.0).
+class readback
+{
+public:
+	explicit readback(bool Asynchronous);
+	~readback();
+
+	/// Queue the read of the bound read framebuffer, Format is GL_RGBA or GL_RGB and Type GL_UNSIGNED_BYTE
+	void read(glm::ivec2 const & Size, GLenum Format, GLenum Type);
+
+	/// Wait for the oldest queued read and write its texels as packed RGB8 rows in Destination
+	bool resolve(glm::u8* Destination);
+
+	bool empty() const {return this->Live.empty();}
+
+private:
+	struct transfer
+	{
+		GLuint Buffer;
+		GLsizeiptr Capacity;
+		GLsync Fence;
+		glm::ivec2 Size;
+		GLenum Format;
+		std::vector<glm::u8> Data;
+	};
+
+	readback(readback const &);
+	readback& operator=(readback const &);
+
+	bool const Asynchronous;
+	std::deque<transfer> Live;
+	std::vector<transfer> Free;
+};
@@ -0,0 +1,29 @@
+#include "sample_registry.hpp"
+#include <algorithm>
+
+namespace
+{
+	std::vector<sample_entry>& get_samples()
+	{
+		static std::vector<sample_entry> Samples;
+		return Samples;
+	}
+}//namespace
+
+sample_registration::sample_registration(char const* Name, sample_main Main)
+{
+	sample_entry Entry;
+	Entry.Name = Name;
+	Entry.Main = Main;
+	get_samples().push_back(Entry);
+}
+
+std::vector<sample_entry> get_registered_samples()
+{
+	std::vector<sample_entry> Samples(get_samples());
+	std::sort(Samples.begin(), Samples.end(), [](sample_entry const & A, sample_entry const & B)
+	{
+		return A.Name < B.Name;
+	});
+	return Samples;
+}
@@ -0,0 +1,22 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+/// Entry point of a sample linked in the sample runner: the renamed main() of the sample source
+typedef int (*sample_main)(int argc, char* argv[]);
+
+struct sample_entry
+{
+	std::string Name;
+	sample_main Main;
+};
+
+/// Registers a sample during static initialization, one static object per sample linked in the runner
+struct sample_registration
+{
+	sample_registration(char const* Name, sample_main Main);
+};
+
+/// Registered samples sorted by name, which groups the samples sharing a profile and version
+std::vector<sample_entry> get_registered_samples();
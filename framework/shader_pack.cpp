@@ -0,0 +1,207 @@
+#include "shader_pack.hpp"
+#include "hash.hpp"
+
+#include <cassert>
+#include <cstdio>
+#include <cstring>
+
+std::string getDataDirectory();
+std::string getBinaryDirectory();
+
+namespace
+{
+	std::size_t const ALIGNMENT = 16;
+
+	std::size_t align(std::size_t Offset)
+	{
+		return (Offset + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+	}
+
+	glm::u64 hash_path(std::string const & Path)
+	{
+		return hash64(Path.data(), Path.size());
+	}
+
+	// At most half full so that a lookup probes a couple of buckets
+	glm::u32 bucket_count(std::size_t EntryCount)
+	{
+		glm::u32 Count = 16;
+		while(Count < EntryCount * 2)
+			Count *= 2;
+		return Count;
+	}
+}//namespace
+
+bool shader_pack::open(std::string const & Filename)
+{
+	if(!this->File.open(Filename))
+		return false;
+
+	glm::u8 const* Data = static_cast<glm::u8 const*>(this->File.data());
+	std::size_t const Size = this->File.size();
+
+	this->Header = reinterpret_cast<header const*>(Data);
+	this->Buckets = reinterpret_cast<glm::u32 const*>(Data + sizeof(header));
+
+	bool Valid = Size >= sizeof(header);
+	Valid = Valid && this->Header->Magic == MAGIC && this->Header->Version == VERSION;
+	Valid = Valid && this->Header->BucketCount > 0 && (this->Header->BucketCount & (this->Header->BucketCount - 1)) == 0;
+
+	std::size_t const EntriesOffset = Valid ? align(sizeof(header) + this->Header->BucketCount * sizeof(glm::u32)) : 0;
+	Valid = Valid && Size >= EntriesOffset + this->Header->EntryCount * sizeof(entry);
+	this->Entries = reinterpret_cast<entry const*>(Data + EntriesOffset);
+
+	// An empty bucket must end every probe sequence
+	Valid = Valid && this->Header->EntryCount < this->Header->BucketCount;
+	for(glm::u32 BucketIndex = 0; Valid && BucketIndex < this->Header->BucketCount; ++BucketIndex)
+		Valid = this->Buckets[BucketIndex] <= this->Header->EntryCount;
+
+	for(glm::u32 EntryIndex = 0; Valid && EntryIndex < this->Header->EntryCount; ++EntryIndex)
+	{
+		entry const & Entry = this->Entries[EntryIndex];
+		Valid = Valid && Entry.PathOffset <= Size && Entry.PathSize <= Size - Entry.PathOffset;
+		Valid = Valid && Entry.DataOffset <= Size && Entry.DataSize <= Size - Entry.DataOffset;
+	}
+
+	if(!Valid)
+	{
+		fprintf(stderr, "Invalid shader pack: %s\n", Filename.c_str());
+		this->File.close();
+	}
+
+	return Valid;
+}
+
+shader_pack::entry const* shader_pack::find(std::string const & Path) const
+{
+	if(this->empty())
+		return nullptr;
+
+	char const* Data = static_cast<char const*>(this->File.data());
+	glm::u64 const Hash = hash_path(Path);
+	glm::u32 const Mask = this->Header->BucketCount - 1;
+
+	// Buckets hold entry index + 1, 0 ends the probe sequence
+	for(glm::u32 BucketIndex = static_cast<glm::u32>(Hash) & Mask;; BucketIndex = (BucketIndex + 1) & Mask)
+	{
+		glm::u32 const Bucket = this->Buckets[BucketIndex];
+		if(Bucket == 0)
+			return nullptr;
+
+		entry const & Entry = this->Entries[Bucket - 1];
+		if(Entry.Hash == Hash && Entry.PathSize == Path.size() && std::memcmp(Data + Entry.PathOffset, Path.data(), Path.size()) == 0)
+			return &Entry;
+	}
+}
+
+bool shader_pack::find(std::string const & Filename, file_stamp const & Stamp, char const* & Data, std::size_t & Size) const
+{
+	if(this->empty())
+		return false;
+
+	std::string const Directory = getDataDirectory();
+	if(Filename.compare(0, Directory.size(), Directory) != 0)
+		return false;
+
+	entry const* Entry = this->find(Filename.substr(Directory.size()));
+	if(!Entry || !Stamp.Exists || Entry->Time != static_cast<glm::i64>(Stamp.Time) || Entry->Size != static_cast<glm::i64>(Stamp.Size))
+		return false;
+
+	Data = static_cast<char const*>(this->File.data()) + Entry->DataOffset;
+	Size = static_cast<std::size_t>(Entry->DataSize);
+	return true;
+}
+
+shader_pack const & get_shader_pack()
+{
+	struct build_pack : public shader_pack
+	{
+		build_pack()
+		{
+			this->open(getBinaryDirectory() + "shaders.pack");
+		}
+	};
+
+	static build_pack Pack;
+	return Pack;
+}
+
+bool save_shader_pack(std::string const & Filename, std::vector<std::string> const & Paths, std::vector<std::string> const & Contents, std::vector<file_stamp> const & Stamps)
+{
+	assert(Paths.size() == Contents.size() && Paths.size() == Stamps.size());
+
+	shader_pack::header Header;
+	Header.Magic = shader_pack::MAGIC;
+	Header.Version = shader_pack::VERSION;
+	Header.EntryCount = static_cast<glm::u32>(Paths.size());
+	Header.BucketCount = bucket_count(Paths.size());
+
+	std::vector<glm::u32> Buckets(Header.BucketCount, 0);
+	std::vector<shader_pack::entry> Entries(Paths.size());
+
+	std::size_t const EntriesOffset = align(sizeof(Header) + Buckets.size() * sizeof(glm::u32));
+	std::size_t Offset = align(EntriesOffset + Entries.size() * sizeof(shader_pack::entry));
+	for(std::size_t EntryIndex = 0; EntryIndex < Paths.size(); ++EntryIndex)
+	{
+		shader_pack::entry & Entry = Entries[EntryIndex];
+		memset(&Entry, 0, sizeof(Entry));
+		Entry.Hash = hash_path(Paths[EntryIndex]);
+		Entry.PathOffset = Offset;
+		Entry.PathSize = Paths[EntryIndex].size();
+		Offset += Paths[EntryIndex].size();
+		Entry.DataOffset = Offset;
+		Entry.DataSize = Contents[EntryIndex].size();
+		Offset = align(Offset + Contents[EntryIndex].size());
+		Entry.Time = static_cast<glm::i64>(Stamps[EntryIndex].Time);
+		Entry.Size = static_cast<glm::i64>(Stamps[EntryIndex].Size);
+
+		glm::u32 BucketIndex = static_cast<glm::u32>(Entry.Hash) & (Header.BucketCount - 1);
+		while(Buckets[BucketIndex] != 0)
+			BucketIndex = (BucketIndex + 1) & (Header.BucketCount - 1);
+		Buckets[BucketIndex] = static_cast<glm::u32>(EntryIndex + 1);
+	}
+
+	// Running samples may map the previous pack, it is replaced rather than truncated
+	std::string const TemporaryFilename = Filename + ".tmp";
+	FILE* File = fopen(TemporaryFilename.c_str(), "wb");
+	if(!File)
+		return false;
+
+	char const Padding[ALIGNMENT] = {0};
+	std::size_t Size = 0;
+	auto write = [&](void const* Data, std::size_t DataSize)
+	{
+		if(DataSize > 0)
+			fwrite(Data, DataSize, 1, File);
+		Size += DataSize;
+	};
+	auto pad = [&](std::size_t Offset)
+	{
+		write(Padding, Offset - Size);
+	};
+
+	write(&Header, sizeof(Header));
+	write(&Buckets[0], Buckets.size() * sizeof(glm::u32));
+	pad(EntriesOffset);
+	write(Entries.empty() ? nullptr : &Entries[0], Entries.size() * sizeof(shader_pack::entry));
+	for(std::size_t EntryIndex = 0; EntryIndex < Entries.size(); ++EntryIndex)
+	{
+		pad(Entries[EntryIndex].PathOffset);
+		write(Paths[EntryIndex].data(), Paths[EntryIndex].size());
+		write(Contents[EntryIndex].data(), Contents[EntryIndex].size());
+	}
+	pad(align(Size));
+
+	bool const Written = ferror(File) == 0;
+	bool const Closed = fclose(File) == 0;
+
+#	if defined(_WIN32)
+		if(Written && Closed)
+			std::remove(Filename.c_str());
+#	endif
+	if(Written && Closed && std::rename(TemporaryFilename.c_str(), Filename.c_str()) == 0)
+		return true;
+
+	std::remove(TemporaryFilename.c_str());
+	return false;
+}
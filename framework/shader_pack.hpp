@@ -0,0 +1,68 @@
+#pragma once
+
+#include "mapped_file.hpp"
+#include "source_cache.hpp"
+
+#include <glm/glm.hpp>
+#include <glm/gtc/type_precision.hpp>
+
+#include <string>
+#include <vector>
+
+/// Shader files and the files they include packed in a single file, mapped rather than read.
+/// Paths are relative to the data directory and looked up through an open addressing hash table. Each file keeps the
+/// stamp it had when packed so that a file edited since is read from disk instead.
+class shader_pack
+{
+public:
+	enum
+	{
+		MAGIC = 0x4B505347, // "GSPK"
+		VERSION = 2
+	};
+
+	struct header
+	{
+		glm::u32 Magic;
+		glm::u32 Version;
+		glm::u32 EntryCount;
+		glm::u32 BucketCount;
+	};
+
+	struct entry
+	{
+		glm::u64 Hash;
+		glm::u64 PathOffset;
+		glm::u64 PathSize;
+		glm::u64 DataOffset;
+		glm::u64 DataSize;
+		glm::i64 Time;
+		glm::i64 Size;
+	};
+
+	shader_pack() :
+		Header(nullptr),
+		Buckets(nullptr),
+		Entries(nullptr)
+	{}
+
+	bool open(std::string const & Filename);
+	bool empty() const {return this->File.empty();}
+
+	/// Content of Filename, a file of the data directory, if it was packed with Stamp
+	bool find(std::string const & Filename, file_stamp const & Stamp, char const* & Data, std::size_t & Size) const;
+
+private:
+	entry const* find(std::string const & Path) const;
+
+	mapped_file File;
+	header const* Header;
+	glm::u32 const* Buckets;
+	entry const* Entries;
+};
+
+/// The pack of the build directory, opened on first use. empty() when the pack wasn't built.
+shader_pack const & get_shader_pack();
+
+/// Write the pack of the files at Paths relative to the data directory with their Contents and Stamps
+bool save_shader_pack(std::string const & Filename, std::vector<std::string> const & Paths, std::vector<std::string> const & Contents, std::vector<file_stamp> const & Stamps);
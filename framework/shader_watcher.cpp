@@ -0,0 +1,389 @@
+#include "shader_watcher.hpp"
+
+#include <chrono>
+#include <cstdio>
+
+#if defined(__linux__)
+#	include <poll.h>
+#	include <sys/inotify.h>
+#	include <unistd.h>
+#endif
+
+namespace
+{
+	PFNGLATTACHSHADERPROC AttachShader = nullptr;
+	PFNGLDETACHSHADERPROC DetachShader = nullptr;
+	PFNGLDELETEPROGRAMPROC DeleteProgram = nullptr;
+	PFNGLDELETESHADERPROC DeleteShader = nullptr;
+
+	void GLAPIENTRY attach_shader(GLuint ProgramName, GLuint ShaderName)
+	{
+		get_shader_watcher().attach(ProgramName, ShaderName);
+		AttachShader(ProgramName, ShaderName);
+	}
+
+	void GLAPIENTRY detach_shader(GLuint ProgramName, GLuint ShaderName)
+	{
+		get_shader_watcher().detach(ProgramName, ShaderName);
+		DetachShader(ProgramName, ShaderName);
+		get_shader_watcher().releaseShader(ShaderName);
+	}
+
+	void GLAPIENTRY delete_program(GLuint ProgramName)
+	{
+		shader_watcher& Watcher = get_shader_watcher();
+		std::vector<GLuint> const Shaders = Watcher.shaders(ProgramName);
+		Watcher.deleteProgram(ProgramName);
+		DeleteProgram(ProgramName);
+		for(std::size_t ShaderIndex = 0; ShaderIndex < Shaders.size(); ++ShaderIndex)
+			Watcher.releaseShader(Shaders[ShaderIndex]);
+	}
+
+	void GLAPIENTRY delete_shader(GLuint ShaderName)
+	{
+		DeleteShader(ShaderName);
+		get_shader_watcher().releaseShader(ShaderName);
+	}
+
+	template <typename proc>
+	void patch(proc & Function, proc & Real, proc Replacement)
+	{
+		if(!Function || Function == Replacement)
+			return;
+		Real = Function;
+		Function = Replacement;
+	}
+
+	std::string directory_of(std::string const & Filename)
+	{
+		std::size_t const Separator = Filename.find_last_of("/\\");
+		return Separator == std::string::npos ? std::string("./") : Filename.substr(0, Separator + 1);
+	}
+}//namespace
+
+shader_watcher::shader_watcher() :
+	ReloadStart(0.0),
+	Relinks(0),
+	Enabled(false),
+	Changed(false),
+	Descriptor(-1)
+{
+	this->StopDescriptors[0] = -1;
+	this->StopDescriptors[1] = -1;
+}
+
+shader_watcher::~shader_watcher()
+{
+	this->stop();
+}
+
+bool shader_watcher::setEnabled(bool Enabled)
+{
+	if(Enabled == this->Enabled)
+		return true;
+
+	if(!Enabled)
+	{
+		this->stop();
+		return true;
+	}
+
+#	if defined(__linux__)
+		this->Descriptor = inotify_init1(IN_CLOEXEC);
+		if(this->Descriptor < 0 || pipe(this->StopDescriptors) != 0)
+		{
+			this->stop();
+			fprintf(stderr, "Shader hot reload: inotify is unavailable\n");
+			return false;
+		}
+
+		this->Enabled = true;
+		this->Thread = std::thread(&shader_watcher::run, this);
+		return true;
+#	else
+		fprintf(stderr, "Shader hot reload is only supported on Linux\n");
+		return false;
+#	endif
+}
+
+void shader_watcher::stop()
+{
+#	if defined(__linux__)
+		if(this->Thread.joinable())
+		{
+			char const Stop = 0;
+			if(write(this->StopDescriptors[1], &Stop, 1) == 1)
+				this->Thread.join();
+			else
+				this->Thread.detach();
+		}
+
+		if(this->Descriptor >= 0)
+			close(this->Descriptor);
+		for(int Index = 0; Index < 2; ++Index)
+			if(this->StopDescriptors[Index] >= 0)
+				close(this->StopDescriptors[Index]);
+#	endif
+
+	this->Descriptor = -1;
+	this->StopDescriptors[0] = -1;
+	this->StopDescriptors[1] = -1;
+	this->Enabled = false;
+
+	std::lock_guard<std::mutex> Lock(this->Mutex);
+	this->Directories.clear();
+	this->Files.clear();
+	this->Changes.clear();
+	this->Changed = false;
+}
+
+void shader_watcher::patchFunctions()
+{
+	if(!this->Enabled)
+		return;
+
+	patch(glAttachShader, AttachShader, &attach_shader);
+	patch(glDetachShader, DetachShader, &detach_shader);
+	patch(glDeleteProgram, DeleteProgram, &delete_program);
+	patch(glDeleteShader, DeleteShader, &delete_shader);
+}
+
+void shader_watcher::addShader(GLuint ShaderName, compiler::variant const & Variant, source_cache::dependencies const & Dependencies)
+{
+	// Record the include graph, missing include candidates too as creating one changes the preprocessed text
+	this->removeDependencies(ShaderName);
+	this->Variants.insert(std::make_pair(ShaderName, Variant)).first->second = Variant;
+	for(std::size_t DependencyIndex = 0; DependencyIndex < Dependencies.size(); ++DependencyIndex)
+	{
+		this->Dependents[Dependencies[DependencyIndex].first].insert(ShaderName);
+		this->watch(Dependencies[DependencyIndex].first);
+	}
+}
+
+void shader_watcher::releaseShader(GLuint ShaderName)
+{
+	// Still a shader while attached to a program even when deleted
+	if(this->Variants.find(ShaderName) == this->Variants.end() || glIsShader(ShaderName))
+		return;
+
+	this->Variants.erase(ShaderName);
+	this->ReloadShaders.erase(ShaderName);
+	this->removeDependencies(ShaderName);
+}
+
+void shader_watcher::removeDependencies(GLuint ShaderName)
+{
+	for(std::map<std::string, std::set<GLuint> >::iterator Iterator = this->Dependents.begin(); Iterator != this->Dependents.end();)
+	{
+		Iterator->second.erase(ShaderName);
+		if(Iterator->second.empty())
+			this->Dependents.erase(Iterator++);
+		else
+			++Iterator;
+	}
+}
+
+void shader_watcher::watch(std::string const & Filename)
+{
+	if(!this->Enabled)
+		return;
+
+	std::lock_guard<std::mutex> Lock(this->Mutex);
+	if(!this->Files.insert(Filename).second)
+		return;
+
+#	if defined(__linux__)
+		// Editors often save by renaming a new file over the old one, the directory is watched rather than the file.
+		// Different spellings of a directory share the watch descriptor of its inode.
+		std::string const Directory = directory_of(Filename);
+		int const Watch = inotify_add_watch(this->Descriptor, Directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE | IN_DELETE | IN_MOVED_FROM);
+		if(Watch >= 0)
+			this->Directories[Watch].insert(Directory);
+#	endif
+}
+
+void shader_watcher::run()
+{
+#	if defined(__linux__)
+		std::vector<char> Buffer(64 * 1024);
+
+		for(;;)
+		{
+			pollfd Descriptors[2];
+			Descriptors[0].fd = this->Descriptor;
+			Descriptors[0].events = POLLIN;
+			Descriptors[1].fd = this->StopDescriptors[0];
+			Descriptors[1].events = POLLIN;
+			if(poll(Descriptors, 2, -1) < 0)
+				continue;
+			if(Descriptors[1].revents)
+				return;
+
+			ssize_t const Size = read(this->Descriptor, &Buffer[0], Buffer.size());
+			if(Size <= 0)
+				continue;
+
+			std::lock_guard<std::mutex> Lock(this->Mutex);
+			for(char const* Event = &Buffer[0]; Event < &Buffer[0] + Size;)
+			{
+				inotify_event const* Notification = reinterpret_cast<inotify_event const*>(Event);
+				Event += sizeof(inotify_event) + Notification->len;
+
+				std::map<int, std::set<std::string> >::const_iterator Directory = this->Directories.find(Notification->wd);
+				if(Directory == this->Directories.end() || Notification->len == 0)
+					continue;
+
+				for(std::set<std::string>::const_iterator Iterator = Directory->second.begin(); Iterator != Directory->second.end(); ++Iterator)
+				{
+					std::string const Filename = *Iterator + Notification->name;
+					if(this->Files.find(Filename) == this->Files.end())
+						continue;
+					this->Changes.insert(Filename);
+					this->Changed = true;
+				}
+			}
+		}
+#	endif
+}
+
+std::vector<GLuint> shader_watcher::programs(GLuint ShaderName) const
+{
+	std::vector<GLuint> Programs;
+	for(std::map<GLuint, std::set<GLuint> >::const_iterator Iterator = this->Attachments.begin(); Iterator != this->Attachments.end(); ++Iterator)
+		if(Iterator->second.find(ShaderName) != Iterator->second.end())
+			Programs.push_back(Iterator->first);
+	return Programs;
+}
+
+std::vector<GLuint> shader_watcher::shaders(GLuint ProgramName) const
+{
+	std::map<GLuint, std::set<GLuint> >::const_iterator Iterator = this->Attachments.find(ProgramName);
+	if(Iterator == this->Attachments.end())
+		return std::vector<GLuint>();
+	return std::vector<GLuint>(Iterator->second.begin(), Iterator->second.end());
+}
+
+void shader_watcher::attach(GLuint ProgramName, GLuint ShaderName)
+{
+	this->Attachments[ProgramName].insert(ShaderName);
+}
+
+void shader_watcher::detach(GLuint ProgramName, GLuint ShaderName)
+{
+	std::map<GLuint, std::set<GLuint> >::iterator Iterator = this->Attachments.find(ProgramName);
+	if(Iterator != this->Attachments.end())
+		Iterator->second.erase(ShaderName);
+}
+
+void shader_watcher::deleteProgram(GLuint ProgramName)
+{
+	this->Attachments.erase(ProgramName);
+}
+
+void shader_watcher::update()
+{
+	if(this->Changed.load(std::memory_order_relaxed))
+	{
+		std::set<std::string> Changes;
+		{
+			std::lock_guard<std::mutex> Lock(this->Mutex);
+			Changes.swap(this->Changes);
+			this->Changed = false;
+		}
+
+		std::size_t const Compiles = this->reload(Changes);
+
+		for(std::set<std::string>::const_iterator Iterator = Changes.begin(); Iterator != Changes.end(); ++Iterator)
+			fprintf(stdout, "Hot reload: %s changed\n", Iterator->c_str());
+		fprintf(stdout, "Hot reload: %d shaders recompiling\n", static_cast<int>(Compiles));
+	}
+
+	if(this->isReloading())
+		this->updateReload();
+}
+
+std::size_t shader_watcher::reload(std::set<std::string> const & Files)
+{
+	std::set<GLuint> Shaders;
+	for(std::set<std::string>::const_iterator FileIterator = Files.begin(); FileIterator != Files.end(); ++FileIterator)
+	{
+		std::map<std::string, std::set<GLuint> >::const_iterator Iterator = this->Dependents.find(*FileIterator);
+		if(Iterator != this->Dependents.end())
+			Shaders.insert(Iterator->second.begin(), Iterator->second.end());
+	}
+
+	if(Shaders.empty())
+		return 0;
+
+	if(!this->isReloading())
+		this->ReloadStart = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now().time_since_epoch()).count();
+
+	std::size_t Compiles = 0;
+	for(std::set<GLuint>::const_iterator ShaderIterator = Shaders.begin(); ShaderIterator != Shaders.end(); ++ShaderIterator)
+	{
+		// Released without going through the patched functions, e.g. by deleting the program in use
+		if(!glIsShader(*ShaderIterator))
+		{
+			this->releaseShader(*ShaderIterator);
+			continue;
+		}
+
+		compiler::variant const Variant = this->Variants.find(*ShaderIterator)->second;
+		this->Reloader.recompile(*ShaderIterator, Variant);
+		this->ReloadShaders.insert(*ShaderIterator);
+		++Compiles;
+	}
+
+	return Compiles;
+}
+
+void shader_watcher::updateReload()
+{
+	if(!this->ReloadShaders.empty())
+	{
+		for(std::set<GLuint>::const_iterator ShaderIterator = this->ReloadShaders.begin(); ShaderIterator != this->ReloadShaders.end(); ++ShaderIterator)
+			if(!compile_future(compile_future::SHADER, *ShaderIterator).ready())
+				return;
+
+		std::set<GLuint> Failed;
+		std::set<GLuint> Programs;
+		for(std::set<GLuint>::const_iterator ShaderIterator = this->ReloadShaders.begin(); ShaderIterator != this->ReloadShaders.end(); ++ShaderIterator)
+		{
+			if(!this->Reloader.check(*ShaderIterator))
+				Failed.insert(*ShaderIterator);
+			std::vector<GLuint> const ShaderPrograms = this->programs(*ShaderIterator);
+			Programs.insert(ShaderPrograms.begin(), ShaderPrograms.end());
+		}
+		this->ReloadShaders.clear();
+
+		// A program keeps its previous executable until all its shaders compile again
+		for(std::set<GLuint>::const_iterator ProgramIterator = Programs.begin(); ProgramIterator != Programs.end(); ++ProgramIterator)
+		{
+			std::vector<GLuint> const Shaders = this->shaders(*ProgramIterator);
+			bool Compiled = true;
+			for(std::size_t ShaderIndex = 0; ShaderIndex < Shaders.size(); ++ShaderIndex)
+				Compiled = Compiled && Failed.find(Shaders[ShaderIndex]) == Failed.end();
+			if(Compiled)
+				this->ReloadPrograms.insert(compiler::link(*ProgramIterator).name());
+		}
+	}
+
+	for(std::set<GLuint>::const_iterator ProgramIterator = this->ReloadPrograms.begin(); ProgramIterator != this->ReloadPrograms.end(); ++ProgramIterator)
+		if(!compile_future(compile_future::PROGRAM, *ProgramIterator).ready())
+			return;
+
+	std::size_t Linked = 0;
+	for(std::set<GLuint>::const_iterator ProgramIterator = this->ReloadPrograms.begin(); ProgramIterator != this->ReloadPrograms.end(); ++ProgramIterator)
+		Linked += this->Reloader.check_program(*ProgramIterator) ? 1 : 0;
+	this->Relinks += Linked;
+
+	double const Now = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now().time_since_epoch()).count();
+	fprintf(stdout, "Hot reload: %d programs relinked in %.1f ms\n", static_cast<int>(Linked), Now - this->ReloadStart);
+	this->ReloadPrograms.clear();
+}
+
+shader_watcher& get_shader_watcher()
+{
+	static shader_watcher Watcher;
+	return Watcher;
+}
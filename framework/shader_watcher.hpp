@@ -0,0 +1,92 @@
+#pragma once
+
+#include "compiler.hpp"
+
+#include <GL/glew.h>
+
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+/// Process-wide shader hot reload, enabled with --hot-reload on Linux.
+/// A thread waits for inotify events on the directories of the files the compilers read while preprocessing and only
+/// queues the changed paths. update(), called once per frame on the context thread, recompiles the shaders depending on
+/// the files and relinks the programs they are attached to, without blocking.
+/// The include graph is kept here rather than in the compilers: samples create their compiler as a local of their
+/// init function, the shaders outlive it as long as a program holds them.
+class shader_watcher
+{
+public:
+	shader_watcher();
+	~shader_watcher();
+
+	/// Returns false when hot reload isn't supported on the platform
+	bool setEnabled(bool Enabled);
+	bool isEnabled() const {return this->Enabled;}
+
+	/// Tracks the shaders attached to each program and the shader names released, called once the OpenGL functions are loaded
+	void patchFunctions();
+
+	/// Records the variant of ShaderName and the files it was preprocessed from, called by compiler on each compilation
+	void addShader(GLuint ShaderName, compiler::variant const & Variant, source_cache::dependencies const & Dependencies);
+	/// Forgets ShaderName once its name is released, a deleted shader lives until no program holds it
+	void releaseShader(GLuint ShaderName);
+	/// Reports the changes of Filename, which may not exist yet, to update()
+	void watch(std::string const & Filename);
+
+	/// Programs with ShaderName attached
+	std::vector<GLuint> programs(GLuint ShaderName) const;
+	/// Shaders attached to ProgramName
+	std::vector<GLuint> shaders(GLuint ProgramName) const;
+
+	void attach(GLuint ProgramName, GLuint ShaderName);
+	void detach(GLuint ProgramName, GLuint ShaderName);
+	void deleteProgram(GLuint ProgramName);
+
+	/// Starts the reload of the shaders depending on the files changed since the last call and progresses the
+	/// reloads in flight. Only costs an atomic load per frame when nothing changed.
+	void update();
+	bool isReloading() const {return !this->ReloadShaders.empty() || !this->ReloadPrograms.empty();}
+	/// Programs linked successfully by the reloads since the start
+	std::size_t relinks() const {return this->Relinks;}
+
+private:
+	shader_watcher(shader_watcher const &);
+	shader_watcher& operator=(shader_watcher const &);
+
+	void run();
+	void stop();
+	void removeDependencies(GLuint ShaderName);
+	/// Recompiles the shaders that read one of Files while preprocessing, returns the number of compilations issued
+	std::size_t reload(std::set<std::string> const & Files);
+	/// Relinks the programs once the reloaded shaders compiled, never blocks
+	void updateReload();
+
+	/// Recompiles the shaders and lists their source strings with the errors, it never owns them
+	compiler Reloader;
+	/// Include graph: the shaders depending on each file read while preprocessing, found or not
+	std::map<std::string, std::set<GLuint> > Dependents;
+	std::map<GLuint, compiler::variant> Variants;
+	std::map<GLuint, std::set<GLuint> > Attachments;
+	std::set<GLuint> ReloadShaders;
+	std::set<GLuint> ReloadPrograms;
+	double ReloadStart;
+	std::size_t Relinks;
+	bool Enabled;
+
+	// Shared with the watcher thread
+	std::mutex Mutex;
+	std::map<int, std::set<std::string> > Directories;
+	std::set<std::string> Files;
+	std::set<std::string> Changes;
+	std::atomic<bool> Changed;
+	int Descriptor;
+	int StopDescriptors[2];
+	std::thread Thread;
+};
+
+shader_watcher& get_shader_watcher();
@@ -0,0 +1,118 @@
+#include "source_cache.hpp"
+#include "shader_pack.hpp"
+
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <fstream>
+#include <iterator>
+
+#if !defined(S_ISREG)
+#	define S_ISREG(Mode) (((Mode) & S_IFMT) == S_IFREG)
+#endif
+
+file_stamp stamp_file(std::string const & Filename)
+{
+	file_stamp Stamp;
+
+	struct stat Status;
+	if(stat(Filename.c_str(), &Status) != 0 || !S_ISREG(Status.st_mode))
+		return Stamp;
+
+#	if defined(_WIN32)
+		Stamp.Time = static_cast<long long>(Status.st_mtime) * 1000000000LL;
+#	elif defined(__APPLE__)
+		Stamp.Time = static_cast<long long>(Status.st_mtimespec.tv_sec) * 1000000000LL + Status.st_mtimespec.tv_nsec;
+#	else
+		Stamp.Time = static_cast<long long>(Status.st_mtim.tv_sec) * 1000000000LL + Status.st_mtim.tv_nsec;
+#	endif
+	Stamp.Size = static_cast<long long>(Status.st_size);
+	Stamp.Exists = true;
+	return Stamp;
+}
+
+std::shared_ptr<std::string const> source_cache::loadFile(std::string const & Filename, dependencies* Dependencies)
+{
+	file_stamp const Stamp = stamp_file(Filename);
+	if(Dependencies)
+		Dependencies->push_back(std::make_pair(Filename, Stamp));
+
+	if(!Stamp.Exists)
+		return nullptr;
+
+	{
+		std::lock_guard<std::mutex> Lock(this->Mutex);
+		std::map<std::string, file>::const_iterator Iterator = this->Files.find(Filename);
+		if(Iterator != this->Files.end() && Iterator->second.Stamp == Stamp)
+			return Iterator->second.Content;
+	}
+
+	std::shared_ptr<std::string> Content(new std::string);
+
+	// Files unchanged since the build are copied from the mapped shader pack instead of being opened
+	char const* PackData = nullptr;
+	std::size_t PackSize = 0;
+	if(get_shader_pack().find(Filename, Stamp, PackData, PackSize))
+		Content->assign(PackData, PackSize);
+	else
+	{
+		std::ifstream Stream(Filename.c_str());
+		if(!Stream.is_open())
+			return nullptr;
+
+		Content->reserve(static_cast<std::size_t>(Stamp.Size));
+		Content->assign((std::istreambuf_iterator<char>(Stream)), std::istreambuf_iterator<char>());
+	}
+
+	std::lock_guard<std::mutex> Lock(this->Mutex);
+	file& File = this->Files[Filename];
+	File.Stamp = Stamp;
+	File.Content = Content;
+	return Content;
+}
+
+bool source_cache::findPreprocessed(std::string const & Key, std::string & Text, dependencies* Dependencies)
+{
+	std::lock_guard<std::mutex> Lock(this->Mutex);
+
+	std::map<std::string, preprocessed>::iterator Iterator = this->Preprocessed.find(Key);
+	if(Iterator == this->Preprocessed.end())
+		return false;
+
+	dependencies const & Stamps = Iterator->second.Dependencies;
+	for(std::size_t DependencyIndex = 0; DependencyIndex < Stamps.size(); ++DependencyIndex)
+	{
+		if(stamp_file(Stamps[DependencyIndex].first) == Stamps[DependencyIndex].second)
+			continue;
+
+		this->Preprocessed.erase(Iterator);
+		return false;
+	}
+
+	Text = Iterator->second.Text;
+	if(Dependencies)
+		*Dependencies = Iterator->second.Dependencies;
+	return true;
+}
+
+void source_cache::storePreprocessed(std::string const & Key, std::string const & Text, dependencies const & Dependencies)
+{
+	std::lock_guard<std::mutex> Lock(this->Mutex);
+
+	preprocessed& Entry = this->Preprocessed[Key];
+	Entry.Text = Text;
+	Entry.Dependencies = Dependencies;
+}
+
+void source_cache::clear()
+{
+	std::lock_guard<std::mutex> Lock(this->Mutex);
+
+	this->Files.clear();
+	this->Preprocessed.clear();
+}
+
+source_cache& get_source_cache()
+{
+	static source_cache Cache;
+	return Cache;
+}
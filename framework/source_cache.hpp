@@ -0,0 +1,67 @@
+#pragma once
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+/// Modification time and size of a file, used to detect that a cached file changed on disk. The time is in nanoseconds
+/// where the file system provides them so that an edit keeping the size within the same second is still detected.
+struct file_stamp
+{
+	file_stamp() :
+		Time(0),
+		Size(0),
+		Exists(false)
+	{}
+
+	bool operator==(file_stamp const & Stamp) const {return this->Time == Stamp.Time && this->Size == Stamp.Size && this->Exists == Stamp.Exists;}
+	bool operator!=(file_stamp const & Stamp) const {return !(*this == Stamp);}
+
+	long long Time;
+	long long Size;
+	bool Exists;
+};
+
+file_stamp stamp_file(std::string const & Filename);
+
+/// Process-wide cache of shader files and of preprocessed shader texts, shared by every compiler instance.
+/// An entry is reused as long as the files it was built from, missing files included, keep the same stamps.
+class source_cache
+{
+public:
+	/// Files read to build a preprocessed text, with the stamp they had at the time
+	typedef std::vector<std::pair<std::string, file_stamp> > dependencies;
+
+	/// Content of Filename, read from disk only when its stamp changed. Returns nullptr when the file doesn't exist.
+	/// The file and its stamp are appended to Dependencies when it isn't nullptr.
+	std::shared_ptr<std::string const> loadFile(std::string const & Filename, dependencies* Dependencies = nullptr);
+
+	/// Text preprocessed with Key if none of its dependencies changed since storePreprocessed
+	/// The dependencies of the text are copied to Dependencies when it isn't nullptr
+	bool findPreprocessed(std::string const & Key, std::string & Text, dependencies* Dependencies = nullptr);
+	void storePreprocessed(std::string const & Key, std::string const & Text, dependencies const & Dependencies);
+
+	void clear();
+
+private:
+	struct file
+	{
+		file_stamp Stamp;
+		std::shared_ptr<std::string const> Content;
+	};
+
+	struct preprocessed
+	{
+		std::string Text;
+		dependencies Dependencies;
+	};
+
+	std::mutex Mutex;
+	std::map<std::string, file> Files;
+	std::map<std::string, preprocessed> Preprocessed;
+};
+
+source_cache& get_source_cache();
@@ -0,0 +1,154 @@
+#include "template_pack.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+namespace
+{
+	std::size_t const ALIGNMENT = 16;
+
+	std::size_t align(std::size_t Offset)
+	{
+		return (Offset + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+	}
+
+	struct entry_less
+	{
+		bool operator()(template_pack::entry const & Entry, char const* Title) const
+		{
+			return std::strncmp(Entry.Name, Title, template_pack::NAME_SIZE) < 0;
+		}
+	};
+}//namespace
+
+bool template_pack::open(std::string const & Filename)
+{
+	if(!this->File.open(Filename))
+		return false;
+
+	glm::u8 const* Data = static_cast<glm::u8 const*>(this->File.data());
+	std::size_t const Size = this->File.size();
+
+	this->Header = reinterpret_cast<header const*>(Data);
+	this->Entries = reinterpret_cast<entry const*>(Data + sizeof(header));
+
+	bool Valid = Size >= sizeof(header);
+	Valid = Valid && this->Header->Magic == MAGIC && this->Header->Version == VERSION && this->Header->TileSize == TEMPLATE_TILE_SIZE;
+	Valid = Valid && Size >= sizeof(header) + this->Header->EntryCount * sizeof(entry);
+
+	for(glm::u32 EntryIndex = 0; Valid && EntryIndex < this->Header->EntryCount; ++EntryIndex)
+	{
+		entry const & Entry = this->Entries[EntryIndex];
+		glm::ivec2 const TileCount = tile_count(glm::ivec2(Entry.Width, Entry.Height));
+		std::size_t const DataSize = static_cast<std::size_t>(Entry.Width) * Entry.Height * sizeof(glm::u8vec3);
+		std::size_t const HashSize = static_cast<std::size_t>(TileCount.x) * TileCount.y * sizeof(glm::u64);
+
+		Valid = Valid && Entry.Name[NAME_SIZE - 1] == '\0';
+		Valid = Valid && Entry.DataOffset <= Size && DataSize <= Size - Entry.DataOffset;
+		Valid = Valid && Entry.HashOffset % sizeof(glm::u64) == 0 && Entry.HashOffset <= Size && HashSize <= Size - Entry.HashOffset;
+	}
+
+	if(!Valid)
+	{
+		fprintf(stderr, "Invalid template pack: %s\n", Filename.c_str());
+		this->File.close();
+	}
+
+	return Valid;
+}
+
+bool template_pack::find(char const* Title, image_rgb8 & Image, glm::u64 const* & TileHashes) const
+{
+	if(this->empty())
+		return false;
+
+	entry const* End = this->Entries + this->Header->EntryCount;
+	entry const* Entry = std::lower_bound(this->Entries, End, Title, entry_less());
+	if(Entry == End || std::strncmp(Entry->Name, Title, NAME_SIZE) != 0)
+		return false;
+
+	glm::u8 const* Data = static_cast<glm::u8 const*>(this->File.data());
+	Image = image_rgb8(Data + Entry->DataOffset, glm::ivec2(Entry->Width, Entry->Height));
+	TileHashes = reinterpret_cast<glm::u64 const*>(Data + Entry->HashOffset);
+	return true;
+}
+
+bool save_template_pack(std::string const & Filename, std::vector<std::string> const & Names, std::vector<gli::texture> const & Textures)
+{
+	assert(Names.size() == Textures.size());
+
+	std::vector<std::size_t> Order(Names.size());
+	for(std::size_t Index = 0; Index < Order.size(); ++Index)
+		Order[Index] = Index;
+	std::sort(Order.begin(), Order.end(), [&](std::size_t A, std::size_t B){return Names[A] < Names[B];});
+
+	template_pack::header Header;
+	Header.Magic = template_pack::MAGIC;
+	Header.Version = template_pack::VERSION;
+	Header.TileSize = TEMPLATE_TILE_SIZE;
+	Header.EntryCount = static_cast<glm::u32>(Names.size());
+
+	std::vector<template_pack::entry> Entries(Names.size());
+	std::vector<std::vector<glm::u64> > Hashes(Names.size());
+
+	std::size_t Offset = align(sizeof(Header) + Entries.size() * sizeof(template_pack::entry));
+	for(std::size_t EntryIndex = 0; EntryIndex < Order.size(); ++EntryIndex)
+	{
+		std::string const & Name = Names[Order[EntryIndex]];
+		gli::texture const & Texture = Textures[Order[EntryIndex]];
+
+		if(Name.size() >= template_pack::NAME_SIZE || Texture.format() != gli::FORMAT_RGB8_UNORM_PACK8)
+		{
+			fprintf(stderr, "Unsupported template: %s\n", Name.c_str());
+			return false;
+		}
+
+		image_rgb8 const Image(Texture.data<glm::u8>(), glm::ivec2(Texture.extent()));
+		glm::ivec2 const TileCount = tile_count(Image.Extent);
+		for(int TileY = 0; TileY < TileCount.y; ++TileY)
+		for(int TileX = 0; TileX < TileCount.x; ++TileX)
+			Hashes[EntryIndex].push_back(hash_tile(Image, glm::ivec2(TileX, TileY)));
+
+		template_pack::entry & Entry = Entries[EntryIndex];
+		memset(&Entry, 0, sizeof(Entry));
+		strncpy(Entry.Name, Name.c_str(), template_pack::NAME_SIZE - 1);
+		Entry.Width = static_cast<glm::u32>(Image.Extent.x);
+		Entry.Height = static_cast<glm::u32>(Image.Extent.y);
+		Entry.DataOffset = Offset;
+		Offset = align(Offset + Image.size());
+		Entry.HashOffset = Offset;
+		Offset = align(Offset + Hashes[EntryIndex].size() * sizeof(glm::u64));
+	}
+
+	FILE* File = fopen(Filename.c_str(), "wb");
+	if(!File)
+		return false;
+
+	char const Padding[ALIGNMENT] = {0};
+	std::size_t Written = 0;
+	auto write = [&](void const* Data, std::size_t Size)
+	{
+		if(Size > 0)
+			fwrite(Data, Size, 1, File);
+		Written += Size;
+	};
+	auto pad = [&](std::size_t Offset)
+	{
+		write(Padding, Offset - Written);
+	};
+
+	write(&Header, sizeof(Header));
+	write(Entries.empty() ? nullptr : &Entries[0], Entries.size() * sizeof(template_pack::entry));
+	for(std::size_t EntryIndex = 0; EntryIndex < Order.size(); ++EntryIndex)
+	{
+		gli::texture const & Texture = Textures[Order[EntryIndex]];
+		pad(Entries[EntryIndex].DataOffset);
+		write(Texture.data(), Texture.size());
+		pad(Entries[EntryIndex].HashOffset);
+		write(&Hashes[EntryIndex][0], Hashes[EntryIndex].size() * sizeof(glm::u64));
+	}
+
+	bool const Success = ferror(File) == 0;
+	fclose(File);
+	return Success;
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include "compare.hpp"
+#include "mapped_file.hpp"
+
+#include <gli/gli.hpp>
+
+#include <string>
+#include <vector>
+
+/// Pre-decoded automated test templates packed in a single file, mapped rather than read.
+/// The pack holds a sorted entry index followed by the raw RGB8 rows and the tile hashes of each template.
+class template_pack
+{
+public:
+	enum
+	{
+		MAGIC = 0x4B505447, // "GTPK"
+		VERSION = 1,
+		NAME_SIZE = 96
+	};
+
+	struct header
+	{
+		glm::u32 Magic;
+		glm::u32 Version;
+		glm::u32 TileSize;
+		glm::u32 EntryCount;
+	};
+
+	struct entry
+	{
+		char Name[NAME_SIZE];
+		glm::u32 Width;
+		glm::u32 Height;
+		glm::u64 DataOffset;
+		glm::u64 HashOffset;
+	};
+
+	template_pack() :
+		Header(nullptr),
+		Entries(nullptr)
+	{}
+
+	bool open(std::string const & Filename);
+	bool empty() const {return this->File.empty();}
+
+	/// Find the template named Title. TileHashes holds tile_count(Image.Extent) hashes, tiles in rows bottom-up.
+	bool find(char const* Title, image_rgb8 & Image, glm::u64 const* & TileHashes) const;
+
+private:
+	mapped_file File;
+	header const* Header;
+	entry const* Entries;
+};
+
+/// Write the pack of the RGB8 Textures, named by Names. Returns false on error.
+bool save_template_pack(std::string const & Filename, std::vector<std::string> const & Names, std::vector<gli::texture> const & Textures);
@@ -1,11 +1,20 @@
 ﻿#include "test.hpp"
 #include "png.hpp"
+#include "compare.hpp"
+#include "parallel.hpp"
+#include "readback.hpp"
+#include "template_pack.hpp"
+#include "compiler_telemetry.hpp"
+#include "program_cache.hpp"
+#include "shader_watcher.hpp"
 #include <glm/vector_relational.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 #include <gli/generate_mipmaps.hpp>
 #include <gli/copy.hpp>
 #include <gli/duplicate.hpp>
-#include <fstream>
+#include <chrono>
+#include <cstring>
+#include <cmath>
 
 std::string getDataDirectory()
 {
@@ -17,6 +26,51 @@ std::string getBinaryDirectory()
 	return std::string(OGL_SAMPLES_BINARY_DIR) + "/";
 }
 
+namespace
+{
+	// Context left alive by the previous framework of the process, adopted by the next framework requesting the same context
+	struct reusable_context
+	{
+		reusable_context() :
+			Enabled(false),
+			Window(nullptr),
+			Profile(0),
+			Major(0),
+			Minor(0),
+			Size(0)
+		{}
+
+		bool Enabled;
+		GLFWwindow* Window;
+		std::unique_ptr<headless> Headless;
+		int Profile;
+		int Major;
+		int Minor;
+		glm::uvec2 Size;
+	};
+
+	reusable_context& get_reusable_context()
+	{
+		static reusable_context Context;
+		return Context;
+	}
+
+	void destroy_reusable_context(reusable_context& Context)
+	{
+		if(Context.Window)
+			glfwDestroyWindow(Context.Window);
+		Context.Window = nullptr;
+		Context.Headless.reset();
+	}
+
+	// Images written by the failed template checks since the last framework::takeArtifacts call
+	std::vector<std::string>& get_artifacts()
+	{
+		static std::vector<std::string> Artifacts;
+		return Artifacts;
+	}
+}//namespace
+
 framework::framework
 (
 	int argc, char* argv[], char const* Title,
@@ -67,16 +121,17 @@ framework::framework
 	std::size_t FrameCount, success Success, heuristic Heuristic
 ) :
 	Window(nullptr),
+	HeadlessClose(false),
 	Success(Success),
 	Title(Title),
 	Profile(Profile),
 	Major(Major),
 	Minor(Minor),
-	TimerQueryName(0),
+	TimerQueryIssued(0),
+	TimerQueryHarvested(0),
+	TimerDropCount(0),
+	TimerDropped(false),
 	FrameCount(FrameCount),
-	TimeSum(0.0),
-	TimeMin(std::numeric_limits<double>::max()),
-	TimeMax(0.0),
 	MouseOrigin(WindowSize >> 1u),
 	MouseCurrent(WindowSize >> 1u),
 	TranlationOrigin(Position),
@@ -85,12 +140,112 @@ framework::framework
 	RotationCurrent(Orientation),
 	MouseButtonFlags(0),
 	Error(false),
-	Heuristic(Heuristic)
+	Heuristic(Heuristic),
+	ContextSize(WindowSize),
+	TimeLast(0.0)
 {
 	assert(WindowSize.x > 0 && WindowSize.y > 0);
 
 	memset(&KeyPressed[0], 0, sizeof(KeyPressed));
+	this->TimerQueryNames.fill(0);
 
+	bool HeadlessRequested = false;
+	bool ProgramCache = true;
+	bool CapsSnapshot = true;
+	bool HotReload = false;
+	for(int ArgIndex = 1; ArgIndex < argc; ++ArgIndex)
+	{
+		if(std::strcmp(argv[ArgIndex], "--headless") == 0)
+			HeadlessRequested = true;
+		else if(std::strcmp(argv[ArgIndex], "--no-program-cache") == 0)
+			ProgramCache = false;
+		else if(std::strcmp(argv[ArgIndex], "--no-caps-snapshot") == 0)
+			CapsSnapshot = false;
+		else if(std::strcmp(argv[ArgIndex], "--hot-reload") == 0)
+			HotReload = true;
+		else if(std::strcmp(argv[ArgIndex], "--shader-verbosity=summary") == 0)
+			get_compiler_telemetry().setVerbosity(compiler_telemetry::VERBOSITY_SUMMARY);
+		else if(std::strcmp(argv[ArgIndex], "--shader-verbosity=source") == 0)
+			get_compiler_telemetry().setVerbosity(compiler_telemetry::VERBOSITY_SOURCE);
+	}
+	get_program_cache().setEnabled(ProgramCache);
+	caps::setSnapshotEnabled(CapsSnapshot);
+	gli::set_parallel_run(&run_on_thread_pool);
+	get_shader_watcher().setEnabled(HotReload);
+
+	reusable_context& Reusable = get_reusable_context();
+	if(Reusable.Window || Reusable.Headless)
+	{
+		bool const Compatible = Reusable.Profile == Profile && Reusable.Major == Major && Reusable.Minor == Minor &&
+			Reusable.Size == WindowSize && (Reusable.Headless != nullptr) == HeadlessRequested;
+
+		if(Compatible)
+		{
+			this->Window = Reusable.Window;
+			this->Headless = std::move(Reusable.Headless);
+			Reusable.Window = nullptr;
+		}
+		else
+			destroy_reusable_context(Reusable);
+	}
+
+	bool const Adopted = this->Window || this->isHeadless();
+	if(Adopted)
+	{
+		// The previous sample closed the context when it stopped, the close request isn't carried over
+		this->HeadlessClose = false;
+		if(this->Window)
+		{
+			glfwSetWindowUserPointer(this->Window, this);
+			glfwSetWindowShouldClose(this->Window, GL_FALSE);
+			glfwSetWindowTitle(this->Window, argv[0]);
+		}
+	}
+	else if(HeadlessRequested)
+	{
+#		if defined(_DEBUG)
+			bool const Debug = true;
+#		else
+			bool const Debug = false;
+#		endif
+		headless::api const API = Profile == ES ? headless::OPENGL_ES : (Profile == CORE ? headless::OPENGL_CORE : headless::OPENGL_COMPATIBILITY);
+		this->Headless.reset(new headless);
+		if(!this->Headless->create(API, this->Major, this->Minor, glm::ivec2(WindowSize), Debug))
+			this->Headless.reset();
+	}
+	else
+		this->createWindow(argv[0], WindowSize);
+
+	if(this->Window || this->isHeadless())
+	{
+		if(!Adopted)
+		{
+			glewExperimental = GL_TRUE;
+			glewInit();
+			if(this->isHeadless())
+				this->Headless->patchFunctions();
+			get_program_cache().patchFunctions();
+			reset_extension_set();
+		}
+		get_shader_watcher().patchFunctions();
+		glGetError();
+
+#		if defined(_DEBUG) && defined(GL_KHR_debug)
+			if(this->isExtensionSupported(EXTENSION_KHR_debug))
+			{
+				glEnable(GL_DEBUG_OUTPUT);
+				glEnable(GL_DEBUG_OUTPUT_SYNCHRONOUS);
+				glDebugMessageControl(GL_DONT_CARE, GL_DONT_CARE, GL_DONT_CARE, 0, nullptr, GL_TRUE);
+				glDebugMessageCallback(&framework::debugOutput, this);
+			}
+#		endif
+
+		glGenQueries(static_cast<GLsizei>(this->TimerQueryNames.size()), &this->TimerQueryNames[0]);
+	}
+}
+
+void framework::createWindow(char const* Name, glm::uvec2 const & WindowSize)
+{
 	glfwInit();
 	glfwWindowHint(GLFW_RESIZABLE, GL_FALSE);
 	glfwWindowHint(GLFW_VISIBLE, GL_TRUE);
@@ -126,7 +281,7 @@ framework::framework
 		int const DPI = 1;
 #	endif
 	
-	this->Window = glfwCreateWindow(WindowSize.x / DPI, WindowSize.y / DPI, argv[0], nullptr, nullptr);
+	this->Window = glfwCreateWindow(WindowSize.x / DPI, WindowSize.y / DPI, Name, nullptr, nullptr);
 
 	if(this->Window)
 	{
@@ -136,29 +291,28 @@ framework::framework
 		glfwSetCursorPosCallback(this->Window, framework::cursorPositionCallback);
 		glfwSetKeyCallback(this->Window, framework::keyCallback);
 		glfwMakeContextCurrent(this->Window);
-
-		glewExperimental = GL_TRUE;
-		glewInit();
-		glGetError();
-
-#		if defined(_DEBUG) && defined(GL_KHR_debug)
-			if(this->isExtensionSupported("GL_KHR_debug"))
-			{
-				glEnable(GL_DEBUG_OUTPUT);
-				glEnable(GL_DEBUG_OUTPUT_SYNCHRONOUS);
-				glDebugMessageControl(GL_DONT_CARE, GL_DONT_CARE, GL_DONT_CARE, 0, nullptr, GL_TRUE);
-				glDebugMessageCallback(&framework::debugOutput, this);
-			}
-#		endif
-
-		glGenQueries(1, &this->TimerQueryName);
 	}
 }
 
 framework::~framework()
 {
-	if(this->TimerQueryName)
-		glDeleteQueries(1, &this->TimerQueryName);
+	if(this->TimerQueryNames[0])
+		glDeleteQueries(static_cast<GLsizei>(this->TimerQueryNames.size()), &this->TimerQueryNames[0]);
+
+	reusable_context& Reusable = get_reusable_context();
+	if(Reusable.Enabled && (this->Window || this->isHeadless()))
+	{
+		this->resetState();
+
+		Reusable.Window = this->Window;
+		Reusable.Headless = std::move(this->Headless);
+		Reusable.Profile = this->Profile;
+		Reusable.Major = this->Major;
+		Reusable.Minor = this->Minor;
+		Reusable.Size = this->ContextSize;
+		this->Window = nullptr;
+		return;
+	}
 
 	if(this->Window)
 	{
@@ -166,12 +320,146 @@ framework::~framework()
 		this->Window = 0;
 	}
 
+	this->Headless.reset();
 	glfwTerminate();
 }
 
+void framework::reuseContext(bool Reuse)
+{
+	reusable_context& Reusable = get_reusable_context();
+	Reusable.Enabled = Reuse;
+
+	if(!Reuse && (Reusable.Window || Reusable.Headless))
+	{
+		destroy_reusable_context(Reusable);
+		glfwTerminate();
+	}
+}
+
+std::vector<std::string> framework::takeArtifacts()
+{
+	std::vector<std::string> Artifacts;
+	Artifacts.swap(get_artifacts());
+	return Artifacts;
+}
+
+void framework::resetState()
+{
+	// Objects deleted by end() are unbound by the implementation, only the context state that outlives them is reset
+	bool const ProfileES = this->Profile == ES;
+	bool const ProfileES3 = ProfileES && this->Major >= 3;
+	bool const ProfileGL3 = !ProfileES && this->Major >= 3;
+
+#	if defined(_DEBUG) && defined(GL_KHR_debug)
+		if(glDebugMessageCallback)
+			glDebugMessageCallback(nullptr, nullptr);
+#	endif
+
+	glBindFramebuffer(GL_FRAMEBUFFER, 0);
+	glUseProgram(0);
+	if(ProfileES3 || ProfileGL3)
+	{
+		glBindVertexArray(0);
+		glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+		glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+		glDisable(GL_RASTERIZER_DISCARD);
+	}
+	if(!ProfileES && version(this->Major, this->Minor) >= version(4, 1))
+		glBindProgramPipeline(0);
+
+	glDisable(GL_DEPTH_TEST);
+	glDisable(GL_STENCIL_TEST);
+	glDisable(GL_BLEND);
+	glDisable(GL_CULL_FACE);
+	glDisable(GL_SCISSOR_TEST);
+	glDisable(GL_POLYGON_OFFSET_FILL);
+	glDisable(GL_SAMPLE_ALPHA_TO_COVERAGE);
+	glDisable(GL_SAMPLE_COVERAGE);
+	if(!ProfileES)
+	{
+		glEnable(GL_MULTISAMPLE);
+		glDisable(GL_FRAMEBUFFER_SRGB);
+		glDisable(GL_PROGRAM_POINT_SIZE);
+		glDisable(GL_DEPTH_CLAMP);
+		glDisable(GL_PRIMITIVE_RESTART);
+		glDisable(GL_TEXTURE_CUBE_MAP_SEAMLESS);
+		GLint MaxClipDistances(0);
+		glGetIntegerv(GL_MAX_CLIP_DISTANCES, &MaxClipDistances);
+		for(GLint ClipDistanceIndex = 0; ClipDistanceIndex < MaxClipDistances; ++ClipDistanceIndex)
+			glDisable(GL_CLIP_DISTANCE0 + ClipDistanceIndex);
+		glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
+		glPointSize(1.0f);
+		glClearDepth(1.0);
+		if(version(this->Major, this->Minor) >= version(3, 2))
+			glProvokingVertex(GL_LAST_VERTEX_CONVENTION);
+		if(version(this->Major, this->Minor) >= version(4, 0))
+			glPatchParameteri(GL_PATCH_VERTICES, 3);
+		if(version(this->Major, this->Minor) >= version(4, 5))
+			glClipControl(GL_LOWER_LEFT, GL_NEGATIVE_ONE_TO_ONE);
+		// 0xFFFFFFFF is the initial value, the implementation picks its number of compiler threads
+		if(GLEW_KHR_parallel_shader_compile)
+			glMaxShaderCompilerThreadsKHR(0xFFFFFFFF);
+		else if(GLEW_ARB_parallel_shader_compile)
+			glMaxShaderCompilerThreadsARB(0xFFFFFFFF);
+	}
+	else
+		glClearDepthf(1.0f);
+
+	glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+	glDepthMask(GL_TRUE);
+	glStencilMask(~0u);
+	glDepthFunc(GL_LESS);
+	glStencilFunc(GL_ALWAYS, 0, ~0u);
+	glStencilOp(GL_KEEP, GL_KEEP, GL_KEEP);
+	glBlendEquation(GL_FUNC_ADD);
+	glBlendFunc(GL_ONE, GL_ZERO);
+	glCullFace(GL_BACK);
+	glFrontFace(GL_CCW);
+	glLineWidth(1.0f);
+	glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+	glClearStencil(0);
+	glPixelStorei(GL_PACK_ALIGNMENT, 4);
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+	// Samples don't always delete their textures and samplers, don't let them leak into the next sample
+	GLint TextureUnits(0);
+	glGetIntegerv(GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS, &TextureUnits);
+	for(GLint TextureUnit = 0; TextureUnit < TextureUnits; ++TextureUnit)
+	{
+		glActiveTexture(GL_TEXTURE0 + TextureUnit);
+		glBindTexture(GL_TEXTURE_2D, 0);
+		glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
+		if(ProfileES3 || ProfileGL3)
+		{
+			glBindTexture(GL_TEXTURE_3D, 0);
+			glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+		}
+		if(!ProfileES)
+		{
+			glBindTexture(GL_TEXTURE_1D, 0);
+			glBindTexture(GL_TEXTURE_1D_ARRAY, 0);
+			glBindTexture(GL_TEXTURE_RECTANGLE, 0);
+			glBindTexture(GL_TEXTURE_BUFFER, 0);
+			glBindTexture(GL_TEXTURE_2D_MULTISAMPLE, 0);
+			glBindTexture(GL_TEXTURE_2D_MULTISAMPLE_ARRAY, 0);
+			glBindTexture(GL_TEXTURE_CUBE_MAP_ARRAY, 0);
+		}
+		if(ProfileES3 || version(this->Major, this->Minor) >= version(3, 3))
+			glBindSampler(TextureUnit, 0);
+	}
+	glActiveTexture(GL_TEXTURE0);
+
+	glm::uvec2 const WindowSize = this->getWindowSize();
+	glViewport(0, 0, WindowSize.x, WindowSize.y);
+	glScissor(0, 0, WindowSize.x, WindowSize.y);
+
+	// Discard the errors of the state the implementation doesn't support
+	while(glGetError() != GL_NO_ERROR){}
+}
+
 int framework::operator()()
 {
-	if(this->Window == 0)
+	if(this->Window == 0 && !this->isHeadless())
 		return EXIT_FAILURE;
 
 	int Result = EXIT_SUCCESS;
@@ -187,27 +475,52 @@ int framework::operator()()
 	bool Automated = false;
 #	ifdef AUTOMATED_TESTS
 		Automated = true;
-		FrameNum = this->FrameCount;
 #	endif//AUTOMATED_TESTS
 
+	// Nobody can close an off-screen context, run it as an automated test
+	if(this->isHeadless())
+		Automated = true;
+	if(Automated)
+		FrameNum = this->FrameCount;
+
 	while(Result == EXIT_SUCCESS && !this->Error)
 	{
+		std::chrono::steady_clock::time_point const FrameStart = std::chrono::steady_clock::now();
+
+		get_shader_watcher().update();
+
 		Result = this->render() ? EXIT_SUCCESS : EXIT_FAILURE;
 		Result = Result && this->checkError("render");
 
-		glfwPollEvents();
-		if(glfwWindowShouldClose(this->Window) || (Automated && FrameNum == 0))
+		bool ShouldClose = this->HeadlessClose;
+		if(this->Window)
+		{
+			glfwPollEvents();
+			ShouldClose = glfwWindowShouldClose(this->Window) != 0;
+		}
+
+		if(ShouldClose || (Automated && FrameNum == 0))
 		{
 			if(this->Success == MATCH_TEMPLATE)
 			{
-				if(!checkTemplate(this->Window, this->Title.c_str()))
+				// The last frame is read back before the swap and compared after it, the transfer overlaps with the swap
+				readback Readback(this->Profile == ES ? this->Major >= 3 : version(this->Major, this->Minor) >= version(3, 2));
+				glm::ivec2 const FramebufferSize = this->readFramebuffer(Readback);
+				this->swap();
+
+				if(!checkTemplate(Readback, FramebufferSize, this->Title.c_str()))
 					Result = EXIT_FAILURE;
 				this->checkError("checkTemplate");
 			}
 			break;
 		}
 
+		std::chrono::steady_clock::time_point const SwapStart = std::chrono::steady_clock::now();
 		this->swap();
+		std::chrono::steady_clock::time_point const SwapEnd = std::chrono::steady_clock::now();
+
+		this->CpuTime.record(std::chrono::duration_cast<std::chrono::nanoseconds>(SwapStart - FrameStart).count());
+		this->SwapTime.record(std::chrono::duration_cast<std::chrono::nanoseconds>(SwapEnd - SwapStart).count());
 
 		if(Automated)
 			--FrameNum;
@@ -224,50 +537,69 @@ int framework::operator()()
 
 void framework::swap()
 {
-	glfwSwapBuffers(this->Window);
+	if(this->isHeadless())
+		this->Headless->swap();
+	else
+		glfwSwapBuffers(this->Window);
 }
 
 void framework::sync(sync_mode const & Sync)
 {
+	int Interval = 0;
 	switch(Sync)
 	{
 	case ASYNC:
-		glfwSwapInterval(0);
+		Interval = 0;
 		break;
 	case VSYNC:
-		glfwSwapInterval(1);
+		Interval = 1;
 		break;
 	case TEARING:
-		glfwSwapInterval(-1);
+		Interval = -1;
 		break;
 	default:
 		assert(0);
 	}
+
+	if(this->isHeadless())
+		this->Headless->swapInterval(Interval);
+	else
+		glfwSwapInterval(Interval);
 }
 
 void framework::stop()
 {
-	glfwSetWindowShouldClose(this->Window, GL_TRUE);
+	if(this->isHeadless())
+		this->HeadlessClose = true;
+	else
+		glfwSetWindowShouldClose(this->Window, GL_TRUE);
 }
 
 void framework::log(csv & CSV, char const* String)
 {
-	CSV.log(String, this->TimeSum / this->FrameCount, this->TimeMin, this->TimeMax);
+	this->harvestTimers(true);
+
+	if(this->TimerDropCount > 0)
+		fprintf(stdout, "%s: %d frame timings dropped\n", String, static_cast<int>(this->TimerDropCount));
+
+	CSV.log(String, this->CpuTime.summary(), this->GpuTime.summary(), this->SwapTime.summary());
 }
 
 bool framework::isExtensionSupported(char const* String)
 {
-	GLint ExtensionCount(0);
-	glGetIntegerv(GL_NUM_EXTENSIONS, &ExtensionCount);
-	for(GLint i = 0; i < ExtensionCount; ++i)
-		if(std::string((char const*)glGetStringi(GL_EXTENSIONS, i)) == std::string(String))
-			return true;
-	//printf("Failed to find Extension: \"%s\"\n",String);
-	return false;
+	return get_extension_set().contains(String);
+}
+
+bool framework::isExtensionSupported(extension Extension)
+{
+	return get_extension_set().contains(Extension);
 }
 
 glm::uvec2 framework::getWindowSize() const
 {
+	if(this->isHeadless())
+		return glm::uvec2(this->Headless->size());
+
 	glm::ivec2 WindowSize(0);
 	glfwGetFramebufferSize(this->Window, &WindowSize.x, &WindowSize.y);
 	return glm::uvec2(WindowSize);
@@ -308,36 +640,285 @@ namespace
 		return Result;
 	}
 
+	image_rgb8 make_image(gli::texture const& Texture)
+	{
+		assert(Texture.format() == gli::FORMAT_RGB8_UNORM_PACK8);
+		return image_rgb8(Texture.data<glm::u8>(), glm::ivec2(Texture.extent()));
+	}
+
+	gli::texture2d make_texture(image_rgb8 const& Image)
+	{
+		gli::texture2d Texture(gli::FORMAT_RGB8_UNORM_PACK8, Image.Extent, 1);
+		memcpy(Texture.data(), Image.Data, Image.size());
+		return Texture;
+	}
+
+	template_pack const& get_template_pack()
+	{
+		static template_pack Pack;
+		static bool Init = false;
+
+		if(!Init)
+		{
+			Init = true;
+			Pack.open(getBinaryDirectory() + "templates.pack");
+		}
+
+		return Pack;
+	}
+
+	// Rectangle of texels [Begin, End) processed by a worker of the tile-parallel comparisons. The kernel heuristics
+	// read the neighbours straight from the whole images, so the halo rows of a region are always available.
+	struct region
+	{
+		glm::ivec2 Begin;
+		glm::ivec2 End;
+	};
+
+	// Split the whole image in bands of TEMPLATE_TILE_SIZE rows
+	std::vector<region> make_bands(glm::ivec2 const& Extent)
+	{
+		int const TileSize = static_cast<int>(TEMPLATE_TILE_SIZE);
+
+		std::vector<region> Regions;
+		for(int BandY = 0; BandY < Extent.y; BandY += TileSize)
+		{
+			region const Region = {glm::ivec2(0, BandY), glm::ivec2(Extent.x, glm::min(BandY + TileSize, Extent.y))};
+			Regions.push_back(Region);
+		}
+		return Regions;
+	}
+
+	// Tiles of the frame whose hash differs from the template tile hashes, the other tiles are identical to the template
+	std::vector<region> find_mismatching_tiles(image_rgb8 const& Frame, glm::u64 const* TileHashes)
+	{
+		int const TileSize = static_cast<int>(TEMPLATE_TILE_SIZE);
+		glm::ivec2 const TileCount = tile_count(Frame.Extent);
+
+		std::vector<glm::u8> Mismatches(TileCount.x * TileCount.y, 0);
+		parallel_for(TileCount.y, 1, [&](std::size_t Begin, std::size_t End, std::atomic<bool> const&)
+		{
+			for(int TileY = static_cast<int>(Begin); TileY < static_cast<int>(End); ++TileY)
+			for(int TileX = 0; TileX < TileCount.x; ++TileX)
+			{
+				std::size_t const TileIndex = TileY * TileCount.x + TileX;
+				Mismatches[TileIndex] = hash_tile(Frame, glm::ivec2(TileX, TileY)) != TileHashes[TileIndex];
+			}
+			return true;
+		});
+
+		std::vector<region> Regions;
+		for(int TileY = 0; TileY < TileCount.y; ++TileY)
+		for(int TileX = 0; TileX < TileCount.x; ++TileX)
+		{
+			if(!Mismatches[TileY * TileCount.x + TileX])
+				continue;
+
+			glm::ivec2 const Begin = glm::ivec2(TileX, TileY) * TileSize;
+			region const Region = {Begin, glm::min(Begin + TileSize, Frame.Extent)};
+			Regions.push_back(Region);
+		}
+		return Regions;
+	}
+
+	// Call Kernel on each texel of the regions for which A differs from B by more than Threshold on any channel.
+	// Rows are scanned with the packed byte kernel so that only the differing texels are loaded individually.
+	// Regions are processed in parallel, the first texel rejected by Kernel stops all the workers.
+	template <typename kernel>
+	bool test_regions(image_rgb8 const& A, image_rgb8 const& B, std::vector<region> const& Regions, glm::u8 Threshold, kernel const& Kernel)
+	{
+		assert(A.Extent == B.Extent);
+
+		return parallel_for(Regions.size(), 1, [&](std::size_t Begin, std::size_t End, std::atomic<bool> const& Stop)
+		{
+			for(std::size_t RegionIndex = Begin; RegionIndex < End; ++RegionIndex)
+			{
+				region const& Region = Regions[RegionIndex];
+				std::size_t const RowBegin = Region.Begin.x * sizeof(glm::u8vec3);
+				std::size_t const RowEnd = Region.End.x * sizeof(glm::u8vec3);
+
+				for(int TexelIndexY = Region.Begin.y; TexelIndexY < Region.End.y && !Stop; ++TexelIndexY)
+				{
+					glm::u8 const* RowA = A.row(TexelIndexY);
+					glm::u8 const* RowB = B.row(TexelIndexY);
+
+					for(std::size_t Offset = find_absolute_difference(RowA, RowB, RowBegin, RowEnd, Threshold); Offset < RowEnd;)
+					{
+						std::size_t const TexelIndexX = Offset / sizeof(glm::u8vec3);
+						glm::ivec2 const TexelCoordA(TexelIndexX, TexelIndexY);
+
+						if(!Kernel(TexelCoordA, A.load(TexelCoordA)))
+							return false;
+
+						Offset = find_absolute_difference(RowA, RowB, (TexelIndexX + 1) * sizeof(glm::u8vec3), RowEnd, Threshold);
+					}
+				}
+			}
+
+			return true;
+		});
+	}
+
+	// Check that all texels of the regions of A and B are within Threshold on every channel
+	bool test_absolute_difference(image_rgb8 const& A, image_rgb8 const& B, std::vector<region> const& Regions, glm::u8 Threshold)
+	{
+		return test_regions(A, B, Regions, Threshold, [](glm::ivec2 const&, glm::u8vec3 const&)
+		{
+			return false;
+		});
+	}
+
+	// Run the heuristic kernel on each texel of the regions of A which differs from B by more than Threshold
+	template <typename heuristic>
+	bool test_kernel(image_rgb8 const& A, image_rgb8 const& B, std::vector<region> const& Regions, glm::u8 Threshold, heuristic const& Heuristic)
+	{
+		return test_regions(A, B, Regions, Threshold, [&](glm::ivec2 const& TexelCoordA, glm::u8vec3 const& TexelA)
+		{
+			return Heuristic.kernel(TexelCoordA, TexelA, B);
+		});
+	}
+
+	// Level of the mipmaps compared by the mipmaps heuristics
+	int const MIPMAPS_LEVEL = 3;
+
+	// generate_mipmaps samples the texel i of a level at s = i * (SrcSize - 1) / (DstSize - 1) in the previous level and
+	// reads its texels floor(s) and floor(s) + 1. The ranges below are widened by a texel to cover the rounding.
+
+	// Texels [First, Last) of a level which read a texel of [SrcFirst, SrcLast) in the previous level
+	void sampling_texels(int SrcFirst, int SrcLast, int SrcSize, int DstSize, int& First, int& Last)
+	{
+		float const Ratio = DstSize == 1 ? 0.f : static_cast<float>(DstSize - 1) / static_cast<float>(SrcSize - 1);
+		First = glm::max(static_cast<int>(std::floor(static_cast<float>(SrcFirst - 1) * Ratio)) - 1, 0);
+		Last = glm::min(static_cast<int>(std::ceil(static_cast<float>(SrcLast) * Ratio)) + 2, DstSize);
+	}
+
+	// Texels [First, Last) of the previous level read by the texels [DstFirst, DstLast) of a level
+	void sampled_texels(int DstFirst, int DstLast, int SrcSize, int DstSize, int& First, int& Last)
+	{
+		float const Ratio = DstSize == 1 ? 0.f : static_cast<float>(SrcSize - 1) / static_cast<float>(DstSize - 1);
+		First = glm::max(static_cast<int>(std::floor(static_cast<float>(DstFirst) * Ratio)) - 1, 0);
+		Last = glm::min(static_cast<int>(std::ceil(static_cast<float>(DstLast - 1) * Ratio)) + 3, SrcSize);
+	}
+
+	// Texels of the mipmaps of two images which may differ because the images differ in Regions, and the texels of the
+	// intermediate levels they read. Only those are generated: the other texels of MIPMAPS_LEVEL are the same in both
+	// mipmaps as they only read equal texels.
+	struct mipmaps_regions
+	{
+		mipmaps_regions(glm::ivec2 const& Extent, std::vector<region> const& Regions)
+		{
+			glm::ivec2 Extents[MIPMAPS_LEVEL + 1];
+			for(int Level = 0; Level <= MIPMAPS_LEVEL; ++Level)
+			{
+				Extents[Level] = glm::max(Extent >> Level, glm::ivec2(1));
+				if(Level > 0)
+					this->Masks[Level - 1].assign(Extents[Level].x * Extents[Level].y, 0);
+			}
+
+			for(std::size_t RegionIndex = 0; RegionIndex < Regions.size(); ++RegionIndex)
+			{
+				// The texels of the compared level which read a texel of the region, through any intermediate level
+				region Region = Regions[RegionIndex];
+				for(int Level = 1; Level <= MIPMAPS_LEVEL; ++Level)
+				{
+					sampling_texels(Region.Begin.x, Region.End.x, Extents[Level - 1].x, Extents[Level].x, Region.Begin.x, Region.End.x);
+					sampling_texels(Region.Begin.y, Region.End.y, Extents[Level - 1].y, Extents[Level].y, Region.Begin.y, Region.End.y);
+				}
+				this->Regions.push_back(Region);
+
+				// Then the texels of each level they read
+				for(int Level = MIPMAPS_LEVEL; Level > 0; --Level)
+				{
+					std::vector<glm::u8>& Mask = this->Masks[Level - 1];
+					for(int TexelIndexY = Region.Begin.y; TexelIndexY < Region.End.y; ++TexelIndexY)
+						std::memset(&Mask[TexelIndexY * Extents[Level].x + Region.Begin.x], 1, Region.End.x - Region.Begin.x);
+
+					sampled_texels(Region.Begin.x, Region.End.x, Extents[Level - 1].x, Extents[Level].x, Region.Begin.x, Region.End.x);
+					sampled_texels(Region.Begin.y, Region.End.y, Extents[Level - 1].y, Extents[Level].y, Region.Begin.y, Region.End.y);
+				}
+			}
+		}
+
+		/// Texels to generate in the levels 1 to MIPMAPS_LEVEL
+		std::vector<glm::u8> Masks[MIPMAPS_LEVEL];
+		/// Regions of MIPMAPS_LEVEL to compare
+		std::vector<region> Regions;
+	};
+
+	// Generate the level MIPMAPS_LEVEL of the FILTER_LINEAR mipmaps of both images as gli::generate_mipmaps does, but
+	// only the texels of the mipmaps regions. The rows of both images are generated level by level by the thread pool.
+	void mipmaps_views(image_rgb8 const& A, image_rgb8 const& B, mipmaps_regions const& Regions, gli::texture2d& ViewA, gli::texture2d& ViewB)
+	{
+		assert(A.Extent == B.Extent);
+
+		gli::texture2d MipmapsA(gli::FORMAT_RGB8_UNORM_PACK8, A.Extent, MIPMAPS_LEVEL + 1);
+		gli::texture2d MipmapsB(gli::FORMAT_RGB8_UNORM_PACK8, B.Extent, MIPMAPS_LEVEL + 1);
+		memcpy(MipmapsA.data(0, 0, 0), A.Data, A.size());
+		memcpy(MipmapsB.data(0, 0, 0), B.Data, B.size());
+
+		// Same filter and sample positions as gli::generate_mipmaps, the sample positions never need the wrap clamp
+		gli::fsampler2D SamplerA(MipmapsA, gli::WRAP_CLAMP_TO_EDGE, gli::FILTER_NEAREST, gli::FILTER_LINEAR);
+		gli::fsampler2D SamplerB(MipmapsB, gli::WRAP_CLAMP_TO_EDGE, gli::FILTER_NEAREST, gli::FILTER_LINEAR);
+
+		for(int Level = 0; Level < MIPMAPS_LEVEL; ++Level)
+		{
+			gli::texture2d::extent_type const Extent = MipmapsA.extent(Level + 1);
+			glm::vec2 const Scale = glm::vec2(1) / glm::vec2(glm::max(Extent - gli::texture2d::extent_type(1), gli::texture2d::extent_type(1)));
+			std::vector<glm::u8> const& Mask = Regions.Masks[Level];
+
+			parallel_for(Extent.y * 2, 8, [&](std::size_t Begin, std::size_t End, std::atomic<bool> const&)
+			{
+				for(int Row = static_cast<int>(Begin); Row < static_cast<int>(End); ++Row)
+				{
+					gli::fsampler2D& Sampler = Row < Extent.y ? SamplerA : SamplerB;
+					int const TexelIndexY = Row % Extent.y;
+
+					for(int TexelIndexX = 0; TexelIndexX < Extent.x; ++TexelIndexX)
+					{
+						if(!Mask[TexelIndexY * Extent.x + TexelIndexX])
+							continue;
+
+						gli::texture2d::extent_type const TexelCoord(TexelIndexX, TexelIndexY);
+						Sampler.texel_write(TexelCoord, Level + 1, Sampler.texture_lod(glm::vec2(TexelCoord) * Scale, static_cast<float>(Level)));
+					}
+				}
+				return true;
+			});
+		}
+
+		ViewA = gli::texture2d(gli::view(SamplerA(), MIPMAPS_LEVEL, MIPMAPS_LEVEL));
+		ViewB = gli::texture2d(gli::view(SamplerB(), MIPMAPS_LEVEL, MIPMAPS_LEVEL));
+	}
+
 	struct heuristic
 	{
-		virtual bool test(gli::texture const& A, gli::texture const& B) const = 0;
+		virtual bool test(image_rgb8 const& A, image_rgb8 const& B, std::vector<region> const& Regions) const = 0;
 	};
 
 	struct heuristic_equal : public heuristic
 	{
-		bool test(gli::texture const& A, gli::texture const& B) const override
+		bool test(image_rgb8 const& A, image_rgb8 const& B, std::vector<region> const& Regions) const override
 		{
-			return A == B;
+			return test_absolute_difference(A, B, Regions, 0);
 		}
 	};
 
 	struct heuristic_absolute_difference_max_one_large_kernel
 	{
-		bool kernel(gli::texture2d::extent_type const& TexelCoordA, glm::u8vec3 const& TexelA, gli::texture2d const& TextureB) const
+		bool kernel(glm::ivec2 const& TexelCoordA, glm::u8vec3 const& TexelA, image_rgb8 const& ImageB) const
 		{
 			int const KernelSize = 9;
 
-			gli::texture2d::extent_type const TexelCoordInvA(TexelCoordA.x, 480 - TexelCoordA.y);
 			glm::u8vec3 TexelB[KernelSize * KernelSize];
 
 			for(int KernelIndexY = 0; KernelIndexY < KernelSize; ++KernelIndexY)
 			for(int KernelIndexX = 0; KernelIndexX < KernelSize; ++KernelIndexX)
 			{
-				gli::texture2d::extent_type const KernelCoordB(KernelIndexX - KernelSize / 2, KernelIndexY - KernelSize / 2);
-				gli::texture2d::extent_type const TexelCoordB = TexelCoordA + KernelCoordB;
+				glm::ivec2 const KernelCoordB(KernelIndexX - KernelSize / 2, KernelIndexY - KernelSize / 2);
+				glm::ivec2 const TexelCoordB = TexelCoordA + KernelCoordB;
 
-				gli::texture2d::extent_type ClampedTexelCoord = glm::clamp(TexelCoordB, glm::ivec2(0), glm::ivec2(TextureB.extent()) - glm::ivec2(1));
-				TexelB[KernelIndexY * KernelSize + KernelIndexX] = TextureB.load<glm::u8vec3>(ClampedTexelCoord, 0);
+				glm::ivec2 ClampedTexelCoord = glm::clamp(TexelCoordB, glm::ivec2(0), ImageB.Extent - glm::ivec2(1));
+				TexelB[KernelIndexY * KernelSize + KernelIndexX] = ImageB.load(ClampedTexelCoord);
 			}
 
 			for(int KernelIndex = 0; KernelIndex < KernelSize * KernelSize; ++KernelIndex)
@@ -351,158 +932,69 @@ namespace
 			return false;
 		}
 
-		bool test(gli::texture const& A, gli::texture const& B) const
+		bool test(image_rgb8 const& A, image_rgb8 const& B, std::vector<region> const& Regions) const
 		{
-			gli::texture2d TextureA(A);
-			gli::texture2d TextureB(B);
-
-			for(std::size_t TexelIndexY = 0, TexelCountY = A.extent().y; TexelIndexY < TexelCountY; ++TexelIndexY)
-			for(std::size_t TexelIndexX = 0, TexelCountX = A.extent().x; TexelIndexX < TexelCountX; ++TexelIndexX)
-			{
-				gli::texture2d::extent_type const TexelCoordA(TexelIndexX, TexelIndexY);
-				glm::u8vec3 const TexelA = TextureA.load<glm::u8vec3>(TexelCoordA, 0);
-				glm::u8vec3 const TexelB = TextureB.load<glm::u8vec3>(TexelCoordA, 0);
-				if (TexelA == TexelB)
-					continue;
-
-				bool const ValidTexel = this->kernel(TexelCoordA, TexelA, TextureB);
-				if(!ValidTexel)
-					return false;
-			}
-
-			return true;
+			return test_kernel(A, B, Regions, 0, *this);
 		}
 	};
 
 	struct heuristic_absolute_difference_max_one_kernel
 	{
-		bool test(gli::texture const& A, gli::texture const& B) const
+		bool kernel(glm::ivec2 const& TexelCoordA, glm::u8vec3 const& TexelA, image_rgb8 const& ImageB) const
 		{
-			gli::texture2d Texture(absolute_difference(A, B, 1));
-			glm::u8vec3 AbsDiffMax(0);
-			for(std::size_t TexelIndexY = 0, TexelCountY = Texture.extent().y; TexelIndexY < TexelCountY; ++TexelIndexY)
-			for(std::size_t TexelIndexX = 0, TexelCountX = Texture.extent().x; TexelIndexX < TexelCountX; ++TexelIndexX)
+			for(int KernelIndexY = -1; KernelIndexY <= 1; ++KernelIndexY)
+			for(int KernelIndexX = -1; KernelIndexX <= 1; ++KernelIndexX)
 			{
-				gli::texture2d::extent_type const TexelCoord(TexelIndexX, TexelIndexY);
-				glm::u8vec3 TexelDiff = Texture.load<glm::u8vec3>(TexelCoord, 0);
-
-				if(glm::all(glm::lessThanEqual(TexelDiff, glm::u8vec3(1))))
-					continue;
-
-				gli::texture2d TextureA(A);
-				gli::texture2d TextureB(B);
-				glm::u8vec3 const TexelA = TextureA.load<glm::u8vec3>(TexelCoord, 0);
-
-				bool KernelAbsDiffMax = false;
-				for(int KernelIndexY = -1; KernelIndexY <= 1; ++KernelIndexY)
-				for(int KernelIndexX = -1; KernelIndexX <= 1; ++KernelIndexX)
-				{
-					glm::ivec2 const KernelCoord(KernelIndexX, KernelIndexY);
-					gli::texture2d::extent_type ClampedTexelCoord = glm::clamp(glm::ivec2(TexelCoord) + KernelCoord, glm::ivec2(0), glm::ivec2(Texture.extent()) - glm::ivec2(1));
-					glm::u8vec3 const TexelB = TextureB.load<glm::u8vec3>(ClampedTexelCoord, 0);
-
-					if(glm::all(glm::lessThanEqual(glm::abs(glm::vec3(TexelB) - glm::vec3(TexelA)), glm::vec3(1))))
-						KernelAbsDiffMax = true;
-				}
+				glm::ivec2 const KernelCoord(KernelIndexX, KernelIndexY);
+				glm::ivec2 ClampedTexelCoord = glm::clamp(glm::ivec2(TexelCoordA) + KernelCoord, glm::ivec2(0), ImageB.Extent - glm::ivec2(1));
+				glm::u8vec3 const TexelB = ImageB.load(ClampedTexelCoord);
 
-				if(KernelAbsDiffMax)
-					TexelDiff = glm::min(TexelDiff, glm::u8vec3(1));
-				AbsDiffMax = glm::max(TexelDiff, AbsDiffMax);
+				if(glm::all(glm::lessThanEqual(glm::abs(glm::vec3(TexelB) - glm::vec3(TexelA)), glm::vec3(1))))
+					return true;
 			}
 
-			return glm::all(glm::lessThanEqual(AbsDiffMax, glm::u8vec3(1)));
+			return false;
+		}
+
+		bool test(image_rgb8 const& A, image_rgb8 const& B, std::vector<region> const& Regions) const
+		{
+			return test_kernel(A, B, Regions, 1, *this);
 		}
 	};
 
 	struct heuristic_absolute_difference_max_one
 	{
-		bool test(gli::texture const& A, gli::texture const& B) const
+		bool test(image_rgb8 const& A, image_rgb8 const& B, std::vector<region> const& Regions) const
 		{
-			gli::texture Texture = absolute_difference(A, B, 1);
-			glm::u8vec3 AbsDiffMax(0);
-			glm::u32vec3 AbsDiffCount(0);
-			for(std::size_t TexelIndex = 0, TexelCount = Texture.size<glm::u8vec3>(); TexelIndex < TexelCount; ++TexelIndex)
-			{
-				glm::u8vec3 AbsDiff = *(Texture.data<glm::u8vec3>() + TexelIndex);
-				if(AbsDiff.x > 0)
-					++AbsDiffCount.x;
-				if(AbsDiff.y > 0)
-					++AbsDiffCount.y;
-				if(AbsDiff.z > 0)
-					++AbsDiffCount.z;
-				AbsDiffMax = glm::max(AbsDiff, AbsDiffMax);
-			}
-			return glm::all(glm::lessThanEqual(AbsDiffMax, glm::u8vec3(1)));
+			return test_absolute_difference(A, B, Regions, 1);
 		}
 	};
 
 	struct heuristic_mipmaps_absolute_difference_max_one
 	{
-		bool test(gli::texture const& A, gli::texture const& B) const
-		{
-			gli::texture2d TextureA(A);
-			gli::texture2d TextureB(B);
-			gli::texture2d MipmapsA(TextureA.format(), TextureA.extent());
-			gli::texture2d MipmapsB(TextureB.format(), TextureB.extent());
-			memcpy(MipmapsA.data(), TextureA.data(), TextureA.size());
-			memcpy(MipmapsB.data(), TextureB.data(), TextureB.size());
-			gli::texture2d GeneratedA = gli::generate_mipmaps(MipmapsA, gli::FILTER_LINEAR);
-			gli::texture2d GeneratedB = gli::generate_mipmaps(MipmapsB, gli::FILTER_LINEAR);
-			gli::texture ViewA = gli::view(GeneratedA, 3, 3);
-			gli::texture ViewB = gli::view(GeneratedB, 3, 3);
-			gli::texture Texture = absolute_difference(ViewA, ViewB, 1);
-			glm::u8vec3 AbsDiffMax(0);
-			glm::u32vec3 AbsDiffCount(0);
-			for(std::size_t TexelIndex = 0, TexelCount = Texture.size<glm::u8vec3>(); TexelIndex < TexelCount; ++TexelIndex)
-			{
-				glm::u8vec3 AbsDiff = *(Texture.data<glm::u8vec3>() + TexelIndex);
-				if(AbsDiff.x > 0)
-					++AbsDiffCount.x;
-				if(AbsDiff.y > 0)
-					++AbsDiffCount.y;
-				if(AbsDiff.z > 0)
-					++AbsDiffCount.z;
-				AbsDiffMax = glm::max(AbsDiff, AbsDiffMax);
-			}
-			return glm::all(glm::lessThanEqual(AbsDiffMax, glm::u8vec3(1)));
+		bool test(image_rgb8 const& A, image_rgb8 const& B, std::vector<region> const& Regions) const
+		{
+			mipmaps_regions const MipmapsRegions(A.Extent, Regions);
+			gli::texture2d ViewA, ViewB;
+			mipmaps_views(A, B, MipmapsRegions, ViewA, ViewB);
+			return test_absolute_difference(make_image(ViewA), make_image(ViewB), MipmapsRegions.Regions, 1);
 		}
 	};
 
 	struct heuristic_mipmaps_absolute_difference_max_four
 	{
-		bool test(gli::texture const& A, gli::texture const& B) const
-		{
-			gli::texture2d TextureA(A);
-			gli::texture2d TextureB(B);
-			gli::texture2d MipmapsA(TextureA.format(), TextureA.extent());
-			gli::texture2d MipmapsB(TextureB.format(), TextureB.extent());
-			memcpy(MipmapsA.data(), TextureA.data(), TextureA.size());
-			memcpy(MipmapsB.data(), TextureB.data(), TextureB.size());
-			gli::texture2d GeneratedA = gli::generate_mipmaps(MipmapsA, gli::FILTER_LINEAR);
-			gli::texture2d GeneratedB = gli::generate_mipmaps(MipmapsB, gli::FILTER_LINEAR);
-			gli::texture ViewA = gli::view(GeneratedA, 3, 3);
-			gli::texture ViewB = gli::view(GeneratedB, 3, 3);
-			gli::texture Texture = absolute_difference(ViewA, ViewB, 1);
-			glm::u8vec3 AbsDiffMax(0);
-			glm::u32vec3 AbsDiffCount(0);
-			for(std::size_t TexelIndex = 0, TexelCount = Texture.size<glm::u8vec3>(); TexelIndex < TexelCount; ++TexelIndex)
-			{
-				glm::u8vec3 AbsDiff = *(Texture.data<glm::u8vec3>() + TexelIndex);
-				if(AbsDiff.x > 0)
-					++AbsDiffCount.x;
-				if(AbsDiff.y > 0)
-					++AbsDiffCount.y;
-				if(AbsDiff.z > 0)
-					++AbsDiffCount.z;
-				AbsDiffMax = glm::max(AbsDiff, AbsDiffMax);
-			}
-			return glm::all(glm::lessThanEqual(AbsDiffMax, glm::u8vec3(4)));
+		bool test(image_rgb8 const& A, image_rgb8 const& B, std::vector<region> const& Regions) const
+		{
+			mipmaps_regions const MipmapsRegions(A.Extent, Regions);
+			gli::texture2d ViewA, ViewB;
+			mipmaps_views(A, B, MipmapsRegions, ViewA, ViewB);
+			return test_absolute_difference(make_image(ViewA), make_image(ViewB), MipmapsRegions.Regions, 4);
 		}
 	};
 
 	struct heuristic_mipmaps_absolute_difference_max_channel
 	{
-		bool kernel(gli::texture2d::extent_type const& TexelCoordA, glm::u8vec3 const& TexelA, gli::texture2d const& TextureB) const
+		bool kernel(glm::ivec2 const& TexelCoordA, glm::u8vec3 const& TexelA, image_rgb8 const& ImageB) const
 		{
 			int const KernelSize = 1;
 
@@ -511,11 +1003,11 @@ namespace
 			for(int KernelIndexY = 0; KernelIndexY < KernelSize; ++KernelIndexY)
 			for(int KernelIndexX = 0; KernelIndexX < KernelSize; ++KernelIndexX)
 			{
-				gli::texture2d::extent_type const KernelCoordB(KernelIndexX - KernelSize / 2, KernelIndexY - KernelSize / 2);
-				gli::texture2d::extent_type const TexelCoordB = TexelCoordA + KernelCoordB;
+				glm::ivec2 const KernelCoordB(KernelIndexX - KernelSize / 2, KernelIndexY - KernelSize / 2);
+				glm::ivec2 const TexelCoordB = TexelCoordA + KernelCoordB;
 
-				gli::texture2d::extent_type ClampedTexelCoord = glm::clamp(TexelCoordB, glm::ivec2(0), glm::ivec2(TextureB.extent()) - glm::ivec2(1));
-				TexelB[KernelIndexY * KernelSize + KernelIndexX] = TextureB.load<glm::u8vec3>(ClampedTexelCoord, 0);
+				glm::ivec2 ClampedTexelCoord = glm::clamp(TexelCoordB, glm::ivec2(0), ImageB.Extent - glm::ivec2(1));
+				TexelB[KernelIndexY * KernelSize + KernelIndexX] = ImageB.load(ClampedTexelCoord);
 			}
 
 			glm::vec3 TexelDiff[KernelSize * KernelSize];
@@ -533,45 +1025,23 @@ namespace
 			return false;
 		}
 
-		bool test(gli::texture const& A, gli::texture const& B) const
-		{
-			gli::texture2d TextureA(A);
-			gli::texture2d TextureB(B);
-			gli::texture2d MipmapsA(TextureA.format(), TextureA.extent());
-			gli::texture2d MipmapsB(TextureB.format(), TextureB.extent());
-			memcpy(MipmapsA.data(), TextureA.data(), TextureA.size());
-			memcpy(MipmapsB.data(), TextureB.data(), TextureB.size());
-			gli::texture2d GeneratedA = gli::generate_mipmaps(MipmapsA, gli::FILTER_LINEAR);
-			gli::texture2d GeneratedB = gli::generate_mipmaps(MipmapsB, gli::FILTER_LINEAR);
-			gli::texture2d ViewA(gli::view(GeneratedA, 3, 3));
-			gli::texture2d ViewB(gli::view(GeneratedB, 3, 3));
-
-			for(std::size_t TexelIndexY = 0, TexelCountY = ViewA.extent().y; TexelIndexY < TexelCountY; ++TexelIndexY)
-			for(std::size_t TexelIndexX = 0, TexelCountX = ViewA.extent().x; TexelIndexX < TexelCountX; ++TexelIndexX)
-			{
-				gli::texture2d::extent_type const TexelCoordA(TexelIndexX, TexelIndexY);
-				glm::u8vec3 const TexelA = ViewA.load<glm::u8vec3>(TexelCoordA, 0);
-				glm::u8vec3 const TexelB = ViewB.load<glm::u8vec3>(TexelCoordA, 0);
-				if (TexelA == TexelB)
-					continue;
-
-				bool const ValidTexel = this->kernel(TexelCoordA, TexelA, ViewB);
-				if(!ValidTexel)
-					return false;
-			}
-
-			return true;
+		bool test(image_rgb8 const& A, image_rgb8 const& B, std::vector<region> const& Regions) const
+		{
+			mipmaps_regions const MipmapsRegions(A.Extent, Regions);
+			gli::texture2d ViewA, ViewB;
+			mipmaps_views(A, B, MipmapsRegions, ViewA, ViewB);
+			return test_kernel(make_image(ViewA), make_image(ViewB), MipmapsRegions.Regions, 0, *this);
 		}
 	};
 
 	template <typename heuristic>
-	bool compare(gli::texture const& A, gli::texture const& B, heuristic const& Euristic)
+	bool compare(image_rgb8 const& A, image_rgb8 const& B, std::vector<region> const& Regions, heuristic const& Euristic)
 	{
-		return Euristic.test(A, B);
+		return Euristic.test(A, B, Regions);
 	}
 }//namespace
 
-bool framework::checkTemplate(GLFWwindow* pWindow, char const* Title)
+glm::ivec2 framework::readFramebuffer(readback & Readback)
 {
 	GLint ColorType = GL_UNSIGNED_BYTE;
 	GLint ColorFormat = GL_RGBA;
@@ -584,31 +1054,43 @@ bool framework::checkTemplate(GLFWwindow* pWindow, char const* Title)
 
 	GLint WindowSizeX(0);
 	GLint WindowSizeY(0);
-	glfwGetFramebufferSize(pWindow, &WindowSizeX, &WindowSizeY);
-
-	gli::texture2d TextureRead(ColorFormat == GL_RGBA ? gli::FORMAT_RGBA8_UNORM_PACK8 : gli::FORMAT_RGB8_UNORM_PACK8, gli::texture2d::extent_type(WindowSizeX, WindowSizeY), 1);
-	gli::texture2d TextureRGB(gli::FORMAT_RGB8_UNORM_PACK8, gli::texture2d::extent_type(WindowSizeX, WindowSizeY), 1);
+	if(this->Window)
+		glfwGetFramebufferSize(this->Window, &WindowSizeX, &WindowSizeY);
+	else
+	{
+		WindowSizeX = this->Headless->size().x;
+		WindowSizeY = this->Headless->size().y;
+	}
 
 	glBindFramebuffer(GL_FRAMEBUFFER, 0);
-	glReadPixels(0, 0, WindowSizeX, WindowSizeY, ColorFormat, ColorType, TextureRead.format() == gli::FORMAT_RGBA8_UNORM_PACK8 ? TextureRead.data() : TextureRGB.data());
+	Readback.read(glm::ivec2(WindowSizeX, WindowSizeY), ColorFormat, ColorType);
 
-	if(TextureRead.format() == gli::FORMAT_RGBA8_UNORM_PACK8)
-	{
-		for(gli::size_t y = 0; y < TextureRGB.extent().y; ++y)
-		for(gli::size_t x = 0; x < TextureRGB.extent().x; ++x)
-		{
-			gli::texture2d::extent_type TexelCoord(x, y);
+	return glm::ivec2(WindowSizeX, WindowSizeY);
+}
 
-			glm::u8vec3 Color(TextureRead.load<glm::u8vec4>(TexelCoord, 0));
-			TextureRGB.store(TexelCoord, 0, Color);
-		}
-	}
+bool framework::checkTemplate(readback & Readback, glm::ivec2 const & Size, char const* Title)
+{
+	gli::texture2d TextureRGB(gli::FORMAT_RGB8_UNORM_PACK8, gli::texture2d::extent_type(Size), 1);
 
+	// Look for the template while the transfer completes
 	bool Success = true;
 
 	if(Success)
 	{
-		gli::texture Template(load_png((getDataDirectory() + "templates/" + Title + ".png").c_str()));
+		// Compare against the mapped template pack when available, fall back to decoding the PNG template
+		image_rgb8 Template;
+		glm::u64 const* TemplateTileHashes = nullptr;
+		gli::texture TemplateTexture;
+		if(!get_template_pack().find(Title, Template, TemplateTileHashes))
+		{
+			TemplateTexture = load_png((getDataDirectory() + "templates/" + Title + ".png").c_str());
+			if(!TemplateTexture.empty() && TemplateTexture.format() == gli::FORMAT_RGB8_UNORM_PACK8)
+				Template = make_image(TemplateTexture);
+		}
+
+		Success = Readback.resolve(TextureRGB.data<glm::u8>());
+
+		image_rgb8 const Frame(make_image(TextureRGB));
 
 		if(Success)
 			Success = Success && !Template.empty();
@@ -616,43 +1098,57 @@ bool framework::checkTemplate(GLFWwindow* pWindow, char const* Title)
 		bool SameSize = false;
 		if(Success)
 		{
-			SameSize = gli::texture2d(Template).extent() == TextureRGB.extent();
+			SameSize = Template.Extent == Frame.Extent;
 			Success = Success && SameSize;
 		}
 
 		if(Success)
 		{
-			bool Pass = false;
+			// With the template tile hashes, only the tiles which differ from the template go through the heuristics
+			std::vector<region> const Regions = TemplateTileHashes ? find_mismatching_tiles(Frame, TemplateTileHashes) : make_bands(Frame.Extent);
+
+			bool Pass = TemplateTileHashes != nullptr && Regions.empty();
 			if(!Pass && this->Heuristic & HEURISTIC_EQUAL_BIT)
-				Pass = compare(Template, TextureRGB, heuristic_equal());
+				Pass = compare(Template, Frame, Regions, heuristic_equal());
 			if(!Pass && (this->Heuristic & HEURISTIC_ABSOLUTE_DIFFERENCE_MAX_ONE_BIT))
-				Pass = compare(Template, TextureRGB, heuristic_absolute_difference_max_one());
+				Pass = compare(Template, Frame, Regions, heuristic_absolute_difference_max_one());
 			if(!Pass && (this->Heuristic & HEURISTIC_ABSOLUTE_DIFFERENCE_MAX_ONE_KERNEL_BIT))
-				Pass = compare(Template, TextureRGB, heuristic_absolute_difference_max_one_kernel());
+				Pass = compare(Template, Frame, Regions, heuristic_absolute_difference_max_one_kernel());
 			if(!Pass && (this->Heuristic & HEURISTIC_ABSOLUTE_DIFFERENCE_MAX_ONE_LARGE_KERNEL_BIT))
-				Pass = compare(Template, TextureRGB, heuristic_absolute_difference_max_one_large_kernel());
+				Pass = compare(Template, Frame, Regions, heuristic_absolute_difference_max_one_large_kernel());
 			if(!Pass && (this->Heuristic & HEURISTIC_MIPMAPS_ABSOLUTE_DIFFERENCE_MAX_ONE_BIT))
-				Pass = compare(Template, TextureRGB, heuristic_mipmaps_absolute_difference_max_one());
+				Pass = compare(Template, Frame, Regions, heuristic_mipmaps_absolute_difference_max_one());
 			if(!Pass && (this->Heuristic & HEURISTIC_MIPMAPS_ABSOLUTE_DIFFERENCE_MAX_FOUR_BIT))
-				Pass = compare(Template, TextureRGB, heuristic_mipmaps_absolute_difference_max_four());
+				Pass = compare(Template, Frame, Regions, heuristic_mipmaps_absolute_difference_max_four());
 			if(!Pass && (this->Heuristic & HEURISTIC_MIPMAPS_ABSOLUTE_DIFFERENCE_MAX_CHANNEL_BIT))
-				Pass = compare(Template, TextureRGB, heuristic_mipmaps_absolute_difference_max_channel());
+				Pass = compare(Template, Frame, Regions, heuristic_mipmaps_absolute_difference_max_channel());
 			Success = Pass;
 		}
 
 		// Save abs diff
 		if(!Success)
 		{
+			gli::texture2d Correct;
+			if(!Template.empty())
+				Correct = make_texture(Template);
+
+			std::vector<std::string>& Artifacts = get_artifacts();
+
 			if(SameSize && !Template.empty())
 			{
-				gli::texture Diff = ::absolute_difference(Template, TextureRGB, 2);
-				save_png(gli::texture2d(Diff), (getBinaryDirectory() + "/" + Title + "-diff.png").c_str());
+				gli::texture Diff = ::absolute_difference(Correct, TextureRGB, 2);
+				Artifacts.push_back(getBinaryDirectory() + "/" + Title + "-diff.png");
+				save_png(gli::texture2d(Diff), Artifacts.back().c_str());
 			}
 
 			if(!Template.empty())
-				save_png(Template, (getBinaryDirectory() + "/" + Title + "-correct.png").c_str());
+			{
+				Artifacts.push_back(getBinaryDirectory() + "/" + Title + "-correct.png");
+				save_png(Correct, Artifacts.back().c_str());
+			}
 
-			save_png(TextureRGB, (getBinaryDirectory() + "/" + Title + ".png").c_str());
+			Artifacts.push_back(getBinaryDirectory() + "/" + Title + ".png");
+			save_png(TextureRGB, Artifacts.back().c_str());
 		}
 	}
 
@@ -661,42 +1157,56 @@ bool framework::checkTemplate(GLFWwindow* pWindow, char const* Title)
 
 void framework::beginTimer()
 {
-	glBeginQuery(GL_TIME_ELAPSED, this->TimerQueryName);
+	this->harvestTimers(false);
+
+	// The ring is full of frames the GPU hasn't completed yet, drop the oldest result rather than wait for it
+	this->TimerDropped = this->TimerQueryIssued - this->TimerQueryHarvested == TIMER_QUERY_COUNT;
+	if(this->TimerDropped)
+	{
+		++this->TimerQueryHarvested;
+		++this->TimerDropCount;
+	}
+
+	glBeginQuery(GL_TIME_ELAPSED, this->TimerQueryNames[this->TimerQueryIssued % TIMER_QUERY_COUNT]);
 }
 
 void framework::endTimer()
 {
 	glEndQuery(GL_TIME_ELAPSED);
+	++this->TimerQueryIssued;
 
-	GLuint QueryTime(0);
-	glGetQueryObjectuiv(this->TimerQueryName, GL_QUERY_RESULT, &QueryTime);
-
-	double const InstantTime(static_cast<double>(QueryTime) / 1000.0);
-
-	this->TimeSum += InstantTime;
-	this->TimeMax = glm::max(this->TimeMax, InstantTime);
-	this->TimeMin = glm::min(this->TimeMin, InstantTime);
+	this->harvestTimers(false);
 
-	fprintf(stdout, "\rTime: %2.4f ms    ", InstantTime / 1000.0);
+	if(this->GpuTime.count() > 0)
+		fprintf(stdout, "\rTime: %2.4f ms    ", this->TimeLast / 1000000.0);
 }
 
-std::string framework::loadFile(std::string const & Filename) const
+void framework::harvestTimers(bool Wait)
 {
-	std::string Result;
+	// Queries complete in submission order, stop at the first result not available yet
+	for(; this->TimerQueryHarvested < this->TimerQueryIssued; ++this->TimerQueryHarvested)
+	{
+		GLuint const QueryName = this->TimerQueryNames[this->TimerQueryHarvested % TIMER_QUERY_COUNT];
 
-	std::ifstream Stream(Filename.c_str());
-	if(!Stream.is_open())
-		return Result;
+		if(!Wait)
+		{
+			GLuint Available(GL_FALSE);
+			glGetQueryObjectuiv(QueryName, GL_QUERY_RESULT_AVAILABLE, &Available);
+			if(Available == GL_FALSE)
+				break;
+		}
 
-	Stream.seekg(0, std::ios::end);
-	Result.reserve(Stream.tellg());
-	Stream.seekg(0, std::ios::beg);
+		GLuint64 QueryTime(0);
+		glGetQueryObjectui64v(QueryName, GL_QUERY_RESULT, &QueryTime);
 
-	Result.assign(
-		(std::istreambuf_iterator<char>(Stream)),
-		std::istreambuf_iterator<char>());
+		this->GpuTime.record(QueryTime);
+		this->TimeLast = static_cast<double>(QueryTime);
+	}
+}
 
-	return Result;
+std::string framework::loadFile(std::string const & Filename) const
+{
+	return load_file(Filename);
 }
 
 void framework::logImplementationDependentLimit(GLenum Value, std::string const & String) const
@@ -810,15 +1320,20 @@ bool framework::checkFramebuffer(GLuint FramebufferName) const
 
 bool framework::checkExtension(char const* ExtensionName) const
 {
-	GLint ExtensionCount = 0;
-	glGetIntegerv(GL_NUM_EXTENSIONS, &ExtensionCount);
-	for(GLint i = 0; i < ExtensionCount; ++i)
-		if(std::string((char const*)glGetStringi(GL_EXTENSIONS, i)) == std::string(ExtensionName))
-			return true;
+	if(get_extension_set().contains(ExtensionName))
+		return true;
 	printf("Failed to find Extension: \"%s\"\n", ExtensionName);
 	return false;
 }
 
+bool framework::checkExtension(extension Extension) const
+{
+	if(get_extension_set().contains(Extension))
+		return true;
+	printf("Failed to find Extension: \"%s\"\n", extension_name(Extension));
+	return false;
+}
+
 bool framework::checkGLVersion(GLint MajorVersionRequire, GLint MinorVersionRequire) const
 {
 	GLint MajorVersionContext = 0;
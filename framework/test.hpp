@@ -9,8 +9,11 @@
 #include "vertex.hpp"
 #include "buffer.hpp"
 #include "caps.hpp"
+#include "extension_set.hpp"
 #include "util.hpp"
 #include "mesh.hpp"
+#include "headless.hpp"
+#include "readback.hpp"
 
 #include <GL/glew.h>
 #include <GLFW/glfw3.h>
@@ -155,6 +158,13 @@ public:
 	int operator()();
 	void log(csv & CSV, char const* String);
 
+	/// Keep the window or the off-screen context alive when a framework is destroyed, the next framework requesting
+	/// the same profile, version and size reuses it instead of creating a new one. Disabling releases the kept context.
+	static void reuseContext(bool Reuse);
+
+	/// Paths of the images written by the failed template checks since the previous call, the diff, the template and the frame
+	static std::vector<std::string> takeArtifacts();
+
 protected:
 	struct DrawArraysIndirectCommand
 	{
@@ -260,16 +270,24 @@ protected:
 	void stop();
 
 	bool isExtensionSupported(char const* String);
+	bool isExtensionSupported(extension Extension);
 	glm::uvec2 getWindowSize() const;
 	bool isKeyPressed(int Key) const;
 	glm::mat4 view() const;
 	float cameraDistance() const {return this->TranlationCurrent.y;}
 	glm::vec3 cameraPosition() const;
-	bool checkTemplate(GLFWwindow* pWindow, char const* Title);
+	/// Queue the read of the default framebuffer, returns its size
+	glm::ivec2 readFramebuffer(readback & Readback);
+	/// Compare the frame read by readFramebuffer with the template of Title
+	bool checkTemplate(readback & Readback, glm::ivec2 const & Size, char const* Title);
 
 protected:
+	/// GPU time of the frames measured with a ring of GL_TIME_ELAPSED queries, read back without stalling a few frames later.
+	/// When the GPU lags by the whole ring, the oldest result is dropped instead of waiting for it.
 	void beginTimer();
 	void endTimer();
+	/// The last beginTimer call dropped the result of an older frame still in flight
+	bool isTimerDropped() const {return this->TimerDropped;}
 
 	std::string loadFile(std::string const & Filename) const;
 	void logImplementationDependentLimit(GLenum Value, std::string const & String) const;
@@ -277,15 +295,23 @@ protected:
 	bool checkError(const char* Title) const;
 	bool checkFramebuffer(GLuint FramebufferName) const;
 	bool checkExtension(char const* ExtensionName) const;
+	bool checkExtension(extension Extension) const;
 
 private:
 	GLFWwindow* Window;
+	std::unique_ptr<headless> Headless;
+	bool HeadlessClose;
 	success const Success;
 	std::string const Title;
 	profile const Profile;
 	int const Major;
 	int const Minor;
-	GLuint TimerQueryName;
+	enum {TIMER_QUERY_COUNT = 8};
+	std::array<GLuint, TIMER_QUERY_COUNT> TimerQueryNames;
+	std::size_t TimerQueryIssued;
+	std::size_t TimerQueryHarvested;
+	std::size_t TimerDropCount;
+	bool TimerDropped;
 	std::size_t const FrameCount;
 	glm::vec2 MouseOrigin;
 	glm::vec2 MouseCurrent;
@@ -297,13 +323,22 @@ private:
 	std::array<bool, 512> KeyPressed;
 	bool Error;
 	std::size_t Heuristic;
+	glm::uvec2 const ContextSize;
 
 private:
-	double TimeSum, TimeMin, TimeMax;
+	/// Durations in nanoseconds of the CPU side of each frame, of the timed GPU work and of each buffer swap
+	histogram CpuTime;
+	histogram GpuTime;
+	histogram SwapTime;
+	double TimeLast;
 
 private:
 	int version(int Major, int Minor) const{return Major * 100 + Minor * 10;}
 	bool checkGLVersion(GLint MajorVersionRequire, GLint MinorVersionRequire) const;
+	bool isHeadless() const {return this->Headless != nullptr;}
+	void createWindow(char const* Name, glm::uvec2 const & WindowSize);
+	void resetState();
+	void harvestTimers(bool Wait);
 
 	static void cursorPositionCallback(GLFWwindow* Window, double x, double y);
 	static void mouseButtonCallback(GLFWwindow* Window, int Button, int Action, int mods);
@@ -243,7 +243,7 @@ private:
 		caps Caps(caps::CORE);
 
 		// Multisample integer texture is optional
-		bool Validated = Caps.Limits.MAX_INTEGER_SAMPLES > 1;
+		bool Validated = Caps.Limits->MAX_INTEGER_SAMPLES > 1;
 
 		glDisable(GL_DITHER);
 
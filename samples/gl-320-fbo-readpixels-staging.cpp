@@ -273,7 +273,7 @@ private:
 
 	bool begin()
 	{
-		bool Validated = this->checkExtension("GL_ARB_buffer_storage");
+		bool Validated = this->checkExtension(EXTENSION_ARB_buffer_storage);
 
 		this->ReadPixelData.resize(640 * 480);
 
@@ -119,11 +119,18 @@ private:
 	{
 		gli::gl GL(gli::gl::PROFILE_GL32);
 
+		// The files are read by the loader threads while the previous textures are uploaded
+		gli::texture_loader Loader;
+		std::future<gli::texture> DiffuseBC1 = Loader.load(getDataDirectory() + TEXTURE_DIFFUSE_BC1);
+		std::future<gli::texture> DiffuseBC3 = Loader.load(getDataDirectory() + TEXTURE_DIFFUSE_BC3);
+		std::future<gli::texture> DiffuseBC4 = Loader.load(getDataDirectory() + TEXTURE_DIFFUSE_BC4);
+		std::future<gli::texture> DiffuseBC5 = Loader.load(getDataDirectory() + TEXTURE_DIFFUSE_BC5);
+
 		glActiveTexture(GL_TEXTURE0);
 		glGenTextures(TEXTURE_MAX, TextureName);
 
 		{
-			gli::texture2d Texture(gli::load(getDataDirectory() + TEXTURE_DIFFUSE_BC1));
+			gli::texture2d Texture(DiffuseBC1.get());
 			assert(!Texture.empty());
 
 			glBindTexture(GL_TEXTURE_2D, TextureName[TEXTURE_BC1]);
@@ -145,7 +152,7 @@ private:
 		}
 
 		{
-			gli::texture2d Texture(gli::load(getDataDirectory() + TEXTURE_DIFFUSE_BC3));
+			gli::texture2d Texture(DiffuseBC3.get());
 			assert(!Texture.empty());
 
 			glBindTexture(GL_TEXTURE_2D, TextureName[TEXTURE_BC3]);
@@ -167,7 +174,7 @@ private:
 		}
 
 		{
-			gli::texture2d Texture(gli::load(getDataDirectory() + TEXTURE_DIFFUSE_BC4));
+			gli::texture2d Texture(DiffuseBC4.get());
 			assert(!Texture.empty());
 
 			glBindTexture(GL_TEXTURE_2D, TextureName[TEXTURE_BC4]);
@@ -189,7 +196,7 @@ private:
 		}
 
 		{
-			gli::texture2d Texture(gli::load(getDataDirectory() + TEXTURE_DIFFUSE_BC5));
+			gli::texture2d Texture(DiffuseBC5.get());
 			assert(!Texture.empty());
 
 			glBindTexture(GL_TEXTURE_2D, TextureName[TEXTURE_BC5]);
@@ -241,7 +248,7 @@ private:
 		Viewport[TEXTURE_BC5] = glm::ivec4(0, WindowSize.y >> 1, WindowSize >> 1);
 
 		bool Validated = true;
-		Validated = Validated && this->checkExtension("GL_EXT_texture_compression_s3tc");
+		Validated = Validated && this->checkExtension(EXTENSION_EXT_texture_compression_s3tc);
 
 		if(Validated)
 			Validated = initProgram();
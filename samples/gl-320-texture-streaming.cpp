@@ -1,4 +1,5 @@
 #include "test.hpp"
+#include "mapped_file.hpp"
 
 namespace
 {
@@ -122,11 +123,20 @@ private:
 
 	bool initTexture()
 	{
-		gli::texture2d Texture(gli::load_dds((getDataDirectory() + TEXTURE_DIFFUSE).c_str()));
-		gli::gl GL(gli::gl::PROFILE_GL32);
-		gli::gl::format const Format = GL.translate(Texture.format(), Texture.swizzles());
+		// Only the header is parsed, the images are copied once from the file mapping to the pixel buffer
+		mapped_file File;
+		if(!File.open(getDataDirectory() + TEXTURE_DIFFUSE))
+			return false;
+
+		char const* const Data = static_cast<char const*>(File.data());
+		gli::texture_header const Header = gli::load_header(Data, File.size());
+		if(Header.empty())
+			return false;
 
-		glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+		gli::texture_layout const Layout = gli::make_layout(Header, 4);
+
+		gli::gl GL(gli::gl::PROFILE_GL32);
+		gli::gl::format const Format = GL.translate(Header.Format, Header.Swizzles);
 
 		glGenTextures(1, &TextureName);
 		glActiveTexture(GL_TEXTURE0);
@@ -136,29 +146,26 @@ private:
 
 		glTexImage2D(GL_TEXTURE_2D, GLint(0),
 			Format.Internal,
-			GLsizei(Texture.extent().x), GLsizei(Texture.extent().y),
+			GLsizei(Header.Extent.x), GLsizei(Header.Extent.y),
 			0,
 			Format.External, Format.Type,
 			nullptr);
 
-		GLsizei TextureSize = Texture[0].size();
-
 		GLuint PixelBuffer(0);
 		glGenBuffers(1, &PixelBuffer);
 		glBindBuffer(GL_PIXEL_UNPACK_BUFFER, PixelBuffer);
-		glBufferData(GL_PIXEL_UNPACK_BUFFER, TextureSize, nullptr, GL_STREAM_DRAW);
-		void* Pointer = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, TextureSize, GL_MAP_WRITE_BIT);
-		memcpy(Pointer, Texture[0].data(), TextureSize);
+		glBufferData(GL_PIXEL_UNPACK_BUFFER, static_cast<GLsizeiptr>(Layout.Size), nullptr, GL_STREAM_DRAW);
+		void* Pointer = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, static_cast<GLsizeiptr>(Layout.Size), GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+		bool const Copied = Pointer && gli::copy_images(Data, File.size(), Header, Layout, Pointer);
 		glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
 
 		glTexSubImage2D(GL_TEXTURE_2D, 0,
-			0, 0, GLsizei(Texture.extent().x), GLsizei(Texture.extent().y),
-			Format.External, Format.Type, nullptr);
+			0, 0, GLsizei(Header.Extent.x), GLsizei(Header.Extent.y),
+			Format.External, Format.Type, BUFFER_OFFSET(Layout.offset(0, 0, 0)));
+		glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
 		glDeleteBuffers(1, &PixelBuffer);
 
-		glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
-
-		return true;
+		return Copied;
 	}
 
 	bool initVertexArray()
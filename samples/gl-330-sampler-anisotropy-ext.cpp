@@ -176,7 +176,7 @@ private:
 		Viewport[viewport::V01] = glm::ivec4(1, WindowSize.y / 2 + 1, WindowSize / 2 - 1);
 
 		bool Validated = true;
-		Validated = Validated && this->checkExtension("GL_EXT_texture_filter_anisotropic");
+		Validated = Validated && this->checkExtension(EXTENSION_EXT_texture_filter_anisotropic);
 
 		if(Validated)
 			Validated = initProgram();
@@ -197,7 +197,7 @@ private:
 	bool begin()
 	{
 		bool Validated(true);
-		Validated = Validated && this->checkExtension("GL_NV_gpu_shader5");
+		Validated = Validated && this->checkExtension(EXTENSION_NV_gpu_shader5);
 
 		if(Validated)
 			Validated = initProgram();
@@ -155,7 +155,7 @@ private:
 	{
 		bool Validated = true;
 
-		if(Validated && this->checkExtension("GL_ARB_debug_output"))
+		if(Validated && this->checkExtension(EXTENSION_ARB_debug_output))
 			Validated = initDebugOutput();
 		if(Validated)
 			Validated = initProgram();
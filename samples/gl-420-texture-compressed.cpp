@@ -122,11 +122,18 @@ private:
 	{
 		gli::gl GL(gli::gl::PROFILE_GL33);
 
+		// The files are read by the loader threads while the previous textures are uploaded
+		gli::texture_loader Loader;
+		std::future<gli::texture> DiffuseDXT5SRGB = Loader.load(getDataDirectory() + TEXTURE_DIFFUSE_DXT5_SRGB);
+		std::future<gli::texture> DiffuseDXT5UNORM = Loader.load(getDataDirectory() + TEXTURE_DIFFUSE_DXT5_UNORM);
+		std::future<gli::texture> DiffuseRGB5E5UFLOAT = Loader.load(getDataDirectory() + TEXTURE_DIFFUSE_RGB5E5_UFLOAT);
+		std::future<gli::texture> DiffuseRGB8SNORM = Loader.load(getDataDirectory() + TEXTURE_DIFFUSE_RGB8_SNORM);
+
 		glActiveTexture(GL_TEXTURE0);
 		glGenTextures(texture::MAX, &TextureName[0]);
 
 		{
-			gli::texture2d Texture(gli::load((getDataDirectory() + TEXTURE_DIFFUSE_DXT5_SRGB).c_str()));
+			gli::texture2d Texture(DiffuseDXT5SRGB.get());
 			assert(!Texture.empty());
 			gli::gl::format const& Format = GL.translate(Texture.format(), Texture.swizzles());
 
@@ -152,7 +159,7 @@ private:
 		}
 
 		{
-			gli::texture2d Texture(gli::load((getDataDirectory() + TEXTURE_DIFFUSE_DXT5_UNORM).c_str()));
+			gli::texture2d Texture(DiffuseDXT5UNORM.get());
 			assert(!Texture.empty());
 			gli::gl::format const Format = GL.translate(Texture.format(), Texture.swizzles());
 
@@ -178,7 +185,7 @@ private:
 		}
 
 		{
-			gli::texture2d Texture(gli::load((getDataDirectory() + TEXTURE_DIFFUSE_RGB5E5_UFLOAT).c_str()));
+			gli::texture2d Texture(DiffuseRGB5E5UFLOAT.get());
 			assert(!Texture.empty());
 			gli::gl::format const& Format = GL.translate(Texture.format(), Texture.swizzles());
 
@@ -203,7 +210,7 @@ private:
 		}
 
 		{
-			gli::texture2d Texture(gli::load((getDataDirectory() + TEXTURE_DIFFUSE_RGB8_SNORM).c_str()));
+			gli::texture2d Texture(DiffuseRGB8SNORM.get());
 			assert(!Texture.empty());
 			gli::gl::format const& Format = GL.translate(Texture.format(), Texture.swizzles());
 
@@ -195,7 +195,7 @@ private:
 	bool begin()
 	{
 		bool Validated(true);
-		Validated = Validated && this->checkExtension("GL_EXT_texture_compression_s3tc");
+		Validated = Validated && this->checkExtension(EXTENSION_EXT_texture_compression_s3tc);
 
 		if(Validated)
 			Validated = initTexture();
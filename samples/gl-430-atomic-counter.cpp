@@ -141,7 +141,7 @@ private:
 	bool begin()
 	{
 		bool Validated(true);
-		Validated = Validated && this->checkExtension("GL_ARB_clear_buffer_object");
+		Validated = Validated && this->checkExtension(EXTENSION_ARB_clear_buffer_object);
 
 		if(Validated)
 			Validated = initBuffer();
@@ -251,7 +251,7 @@ private:
 	{
 		bool Validated(true);
 
-		if(Validated && this->checkExtension("GL_KHR_debug"))
+		if(Validated && this->checkExtension(EXTENSION_KHR_debug))
 			Validated = initDebug();
 		if(Validated)
 			Validated = initProgram();
@@ -219,7 +219,7 @@ private:
 
 	bool begin()
 	{
-		bool Validated = this->checkExtension("GL_EXT_direct_state_access");
+		bool Validated = this->checkExtension(EXTENSION_EXT_direct_state_access);
 
 		if(Validated)
 			Validated = initProgram();
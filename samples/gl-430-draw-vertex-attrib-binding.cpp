@@ -181,7 +181,7 @@ private:
 
 	bool begin()
 	{
-		bool Validated = this->checkExtension("GL_ARB_vertex_attrib_binding");
+		bool Validated = this->checkExtension(EXTENSION_ARB_vertex_attrib_binding);
 
 		if(Validated)
 			Validated = initProgram();
@@ -142,7 +142,7 @@ private:
 
 	bool begin()
 	{
-		bool Validated = this->checkExtension("GL_ARB_shader_storage_buffer_object");
+		bool Validated = this->checkExtension(EXTENSION_ARB_shader_storage_buffer_object);
 
 		if(Validated)
 			Validated = initBuffer();
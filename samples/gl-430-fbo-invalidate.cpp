@@ -225,7 +225,7 @@ private:
 	bool begin()
 	{
 		bool Validated(true);
-		Validated = Validated && this->checkExtension("GL_ARB_invalidate_subdata");
+		Validated = Validated && this->checkExtension(EXTENSION_ARB_invalidate_subdata);
 
 		if(Validated)
 			Validated = initState();
@@ -188,7 +188,7 @@ private:
 	bool begin()
 	{
 		bool Validated(true);
-		Validated = Validated && this->checkExtension("GL_ARB_framebuffer_no_attachments");
+		Validated = Validated && this->checkExtension(EXTENSION_ARB_framebuffer_no_attachments);
 
 		if(Validated)
 			Validated = initProgram();
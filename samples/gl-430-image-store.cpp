@@ -111,7 +111,7 @@ private:
 	bool begin()
 	{
 		bool Validated(true);
-		Validated = Validated && this->checkExtension("GL_ARB_shader_image_size");
+		Validated = Validated && this->checkExtension(EXTENSION_ARB_shader_image_size);
 
 		this->logImplementationDependentLimit(GL_MAX_TEXTURE_IMAGE_UNITS, "GL_MAX_TEXTURE_IMAGE_UNITS");
 
@@ -315,8 +315,8 @@ private:
 	bool begin()
 	{
 		bool Validated(true);
-		Validated = Validated && this->checkExtension("GL_ARB_arrays_of_arrays");
-		Validated = Validated && this->checkExtension("GL_ARB_program_interface_query");
+		Validated = Validated && this->checkExtension(EXTENSION_ARB_arrays_of_arrays);
+		Validated = Validated && this->checkExtension(EXTENSION_ARB_program_interface_query);
 
 		if(Validated)
 			Validated = initMax();;
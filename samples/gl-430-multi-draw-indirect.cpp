@@ -323,7 +323,7 @@ private:
 
 	bool begin()
 	{
-		bool Validated = this->checkExtension("GL_ARB_multi_draw_indirect");
+		bool Validated = this->checkExtension(EXTENSION_ARB_multi_draw_indirect);
 
 		if(Validated)
 			Validated = initProgram();
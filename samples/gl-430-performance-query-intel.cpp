@@ -301,7 +301,7 @@ private:
 	bool begin()
 	{
 		bool Validated(true);
-		Validated = Validated && this->checkExtension("GL_INTEL_performance_query");
+		Validated = Validated && this->checkExtension(EXTENSION_INTEL_performance_query);
 
 		if(Validated)
 			Validated = initPerf();
@@ -424,7 +424,7 @@ private:
 	bool begin()
 	{
 		bool Validated = true;
-		Validated = Validated && this->checkExtension("GL_AMD_performance_monitor");
+		Validated = Validated && this->checkExtension(EXTENSION_AMD_performance_monitor);
 
 		if(Validated)
 		{
@@ -312,7 +312,7 @@ private:
 	
 		this->logImplementationDependentLimit(GL_TEXTURE_BUFFER_OFFSET_ALIGNMENT, "GL_TEXTURE_BUFFER_OFFSET_ALIGNMENT");
 
-		bool Validated = this->checkExtension("GL_ARB_compute_shader");
+		bool Validated = this->checkExtension(EXTENSION_ARB_compute_shader);
 
 		if(Validated)
 			Validated = initProgram();
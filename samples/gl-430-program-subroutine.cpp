@@ -235,7 +235,7 @@ private:
 	bool begin()
 	{
 		bool Validated(true);
-		Validated = Validated && this->checkExtension("GL_ARB_explicit_uniform_location");
+		Validated = Validated && this->checkExtension(EXTENSION_ARB_explicit_uniform_location);
 
 		if(Validated)
 			Validated = initTest();
@@ -140,7 +140,7 @@ private:
 	bool begin()
 	{
 		bool Validated = true;
-		Validated = Validated && this->checkExtension("GL_ARB_ES3_compatibility");
+		Validated = Validated && this->checkExtension(EXTENSION_ARB_ES3_compatibility);
 
 		if(Validated)
 			Validated = initQuery();
@@ -194,7 +194,7 @@ private:
 	{
 		bool Validated(true);
 	
-		Validated = Validated && this->checkExtension("GL_ARB_texture_buffer_range");
+		Validated = Validated && this->checkExtension(EXTENSION_ARB_texture_buffer_range);
 
 		if(Validated)
 			Validated = initTest();
@@ -191,7 +191,7 @@ private:
 	bool begin()
 	{
 		bool Validated(true);
-		Validated = Validated && this->checkExtension("GL_ARB_copy_image");
+		Validated = Validated && this->checkExtension(EXTENSION_ARB_copy_image);
 
 		if(Validated)
 			Validated = initTexture();
@@ -183,7 +183,7 @@ private:
 	bool begin()
 	{
 		bool Validated(true);
-		Validated = Validated && this->checkExtension("GL_ARB_internalformat_query2");
+		Validated = Validated && this->checkExtension(EXTENSION_ARB_internalformat_query2);
 
 		GLint64 Query_COMPRESSED_RGB8_ETC2(0);
 		glGetInternalformati64v(GL_TEXTURE_2D, GL_RGB4, GL_INTERNALFORMAT_PREFERRED, sizeof(GLint64), &Query_COMPRESSED_RGB8_ETC2);
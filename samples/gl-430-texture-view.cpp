@@ -185,9 +185,9 @@ private:
 	bool begin()
 	{
 		bool Validated(true);
-		Validated = Validated && this->checkExtension("GL_ARB_texture_query_levels");
-		Validated = Validated && this->checkExtension("GL_ARB_texture_view");
-		Validated = Validated && this->checkExtension("GL_ARB_fragment_layer_viewport");
+		Validated = Validated && this->checkExtension(EXTENSION_ARB_texture_query_levels);
+		Validated = Validated && this->checkExtension(EXTENSION_ARB_texture_view);
+		Validated = Validated && this->checkExtension(EXTENSION_ARB_fragment_layer_viewport);
 
 		if(Validated)
 			Validated = initProgram();
@@ -99,7 +99,7 @@ private:
 
 	bool begin()
 	{
-		bool Validated = this->checkExtension("GL_ARB_clear_buffer_object");
+		bool Validated = this->checkExtension(EXTENSION_ARB_clear_buffer_object);
 
 		if(Validated)
 			Validated = initBuffer();
@@ -175,8 +175,8 @@ private:
 	bool begin()
 	{
 		bool Validated(true);
-		Validated = Validated && this->checkExtension("GL_ARB_buffer_storage");
-		Validated = Validated && this->checkExtension("GL_ARB_shader_storage_buffer_object");
+		Validated = Validated && this->checkExtension(EXTENSION_ARB_buffer_storage);
+		Validated = Validated && this->checkExtension(EXTENSION_ARB_shader_storage_buffer_object);
 
 		if(Validated)
 			Validated = initProgram();
@@ -262,7 +262,7 @@ private:
 		Viewport[viewport::VIEWPORT5] = view(glm::vec4(ViewportSize.x * 2.0f, ViewportSize.y * 1.0f, ViewportSize.x * 1.0f, ViewportSize.y * 1.0f), vertex_format::RG11B10F);
 
 		bool Validated = true;
-		Validated = Validated && this->checkExtension("GL_ARB_vertex_type_10f_11f_11f_rev");
+		Validated = Validated && this->checkExtension(EXTENSION_ARB_vertex_type_10f_11f_11f_rev);
 
 		if(Validated)
 			Validated = initProgram();
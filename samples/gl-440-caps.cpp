@@ -17,7 +17,7 @@ private:
 		std::vector<GLint> CompressedTextureFormats(NumCompressedTextureFormats);
 		glGetIntegerv(GL_COMPRESSED_TEXTURE_FORMATS, &CompressedTextureFormats[0]);
 
-		if(this->checkExtension("GL_EXT_texture_compression_s3tc"))
+		if(this->checkExtension(EXTENSION_EXT_texture_compression_s3tc))
 		{
 			if(std::find(CompressedTextureFormats.begin(), CompressedTextureFormats.end(), GL_COMPRESSED_RGB_S3TC_DXT1_EXT) == CompressedTextureFormats.end())
 				return false;
@@ -29,7 +29,7 @@ private:
 				return false;
 		}
 
-		if(this->checkExtension("GL_EXT_texture_sRGB") && this->checkExtension("GL_EXT_texture_compression_s3tc"))
+		if(this->checkExtension(EXTENSION_EXT_texture_sRGB) && this->checkExtension(EXTENSION_EXT_texture_compression_s3tc))
 		{
 			if(std::find(CompressedTextureFormats.begin(), CompressedTextureFormats.end(), GL_COMPRESSED_SRGB_S3TC_DXT1_EXT) == CompressedTextureFormats.end())
 				return false;
@@ -272,7 +272,7 @@ private:
 	bool begin()
 	{
 		bool Validated(true);
-		Validated = Validated && this->checkExtension("GL_ARB_texture_stencil8");
+		Validated = Validated && this->checkExtension(EXTENSION_ARB_texture_stencil8);
 
 		if(Validated)
 			Validated = initProgram();
@@ -259,9 +259,9 @@ private:
 	bool begin()
 	{
 		bool Validated(true);
-		Validated = Validated && this->checkExtension("GL_ARB_framebuffer_no_attachments");
-		Validated = Validated && this->checkExtension("GL_ARB_clear_texture");
-		Validated = Validated && this->checkExtension("GL_ARB_shader_storage_buffer_object");
+		Validated = Validated && this->checkExtension(EXTENSION_ARB_framebuffer_no_attachments);
+		Validated = Validated && this->checkExtension(EXTENSION_ARB_clear_texture);
+		Validated = Validated && this->checkExtension(EXTENSION_ARB_shader_storage_buffer_object);
 
 		if(Validated)
 			Validated = initProgram();
@@ -215,7 +215,7 @@ private:
 		Viewport[viewport::VIEWPORT5] = glm::vec4(ViewportSize.x * 2.0f, ViewportSize.y * 1.0f, ViewportSize.x * 1.0f, ViewportSize.y * 1.0f);
 
 		bool Validated = true;
-		Validated = Validated && this->checkExtension("GL_ARB_texture_mirror_clamp_to_edge");
+		Validated = Validated && this->checkExtension(EXTENSION_ARB_texture_mirror_clamp_to_edge);
 
 		if(Validated)
 			Validated = initProgram();
@@ -122,10 +122,17 @@ private:
 	{
 		gli::gl GL(gli::gl::PROFILE_GL33);
 
+		// The files are read by the loader threads while the previous textures are uploaded
+		gli::texture_loader Loader;
+		std::future<gli::texture> DiffuseRGBADXT5UNORM = Loader.load(getDataDirectory() + TEXTURE_DIFFUSE_RGBA_DXT5_UNORM);
+		std::future<gli::texture> DiffuseRGEACUNORM = Loader.load(getDataDirectory() + TEXTURE_DIFFUSE_RG_EAC_UNORM);
+		std::future<gli::texture> DiffuseRGB9E5UFLOAT = Loader.load(getDataDirectory() + TEXTURE_DIFFUSE_RGB9E5_UFLOAT);
+		std::future<gli::texture> DiffuseRGBETC2SRGB = Loader.load(getDataDirectory() + TEXTURE_DIFFUSE_RGB_ETC2_SRGB);
+
 		glGenTextures(texture::MAX, &TextureName[0]);
 
 		{
-			gli::texture Texture = gli::load((getDataDirectory() + TEXTURE_DIFFUSE_RGBA_DXT5_UNORM));
+			gli::texture Texture = DiffuseRGBADXT5UNORM.get();
 			assert(!Texture.empty());
 			gli::gl::format const& Format = GL.translate(Texture.format(), Texture.swizzles());
 
@@ -157,7 +164,7 @@ private:
 		}
 
 		{
-			gli::texture Texture = gli::load((getDataDirectory() + TEXTURE_DIFFUSE_RG_EAC_UNORM));
+			gli::texture Texture = DiffuseRGEACUNORM.get();
 			assert(!Texture.empty());
 			gli::gl::format const& Format = GL.translate(Texture.format(), Texture.swizzles());
 
@@ -187,7 +194,7 @@ private:
 		}
 
 		{
-			gli::texture Texture = gli::load((getDataDirectory() + TEXTURE_DIFFUSE_RGB9E5_UFLOAT));
+			gli::texture Texture = DiffuseRGB9E5UFLOAT.get();
 			assert(!Texture.empty());
 			gli::gl::format const& Format = GL.translate(Texture.format(), Texture.swizzles());
 
@@ -216,7 +223,7 @@ private:
 		}
 
 		{
-			gli::texture Texture = gli::load((getDataDirectory() + TEXTURE_DIFFUSE_RGB_ETC2_SRGB).c_str());
+			gli::texture Texture = DiffuseRGBETC2SRGB.get();
 			assert(!Texture.empty());
 			gli::gl::format const& Format = GL.translate(Texture.format(), Texture.swizzles());
 
@@ -297,7 +304,7 @@ private:
 		Viewport[texture::BC1] = glm::ivec4(WindowSize.x >> 1, WindowSize.y >> 1, WindowSize >> 1);
 		Viewport[texture::BC3] = glm::ivec4(0, WindowSize.y >> 1, WindowSize >> 1);
 
-		bool Validated = this->checkExtension("GL_ARB_multi_bind");
+		bool Validated = this->checkExtension(EXTENSION_ARB_multi_bind);
 
 		if(Validated)
 			Validated = initProgram();
@@ -160,7 +160,7 @@ private:
 	bool begin()
 	{
 		bool Validated = true;
-		Validated = Validated && this->checkExtension("GL_ARB_enhanced_layouts");
+		Validated = Validated && this->checkExtension(EXTENSION_ARB_enhanced_layouts);
 
 		if(Validated)
 			Validated = initProgram();
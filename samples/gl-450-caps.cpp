@@ -12,7 +12,7 @@ private:
 	{
 		caps Caps(caps::CORE);
 
-		if(Caps.Limits.MAX_SHADER_STORAGE_BLOCK_SIZE < (2 << 27))
+		if(Caps.Limits->MAX_SHADER_STORAGE_BLOCK_SIZE < (2 << 27))
 			return false;
 
 		return true;
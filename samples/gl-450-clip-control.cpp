@@ -186,7 +186,7 @@ private:
 
 	bool begin()
 	{
-		bool Validated = this->checkExtension("GL_ARB_clip_control");
+		bool Validated = this->checkExtension(EXTENSION_ARB_clip_control);
 
 		if(Validated)
 			Validated = initProgram();
@@ -164,7 +164,7 @@ private:
 
 	bool begin()
 	{
-		bool Validated = this->checkExtension("GL_ARB_cull_distance");
+		bool Validated = this->checkExtension(EXTENSION_ARB_cull_distance);
 
 		if(Validated)
 			Validated = initTexture();
@@ -241,7 +241,7 @@ private:
 
 	bool begin()
 	{
-		bool Validated = this->checkExtension("GL_ARB_shader_texture_image_samples");
+		bool Validated = this->checkExtension(EXTENSION_ARB_shader_texture_image_samples);
 		
 		if(Validated)
 			Validated = initProgram();
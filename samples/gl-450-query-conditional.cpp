@@ -140,7 +140,7 @@ private:
 	bool begin()
 	{
 		bool Validated = true;
-		Validated = Validated && this->checkExtension("GL_ARB_conditional_render_inverted");
+		Validated = Validated && this->checkExtension(EXTENSION_ARB_conditional_render_inverted);
 
 		if(Validated)
 			Validated = initQuery();
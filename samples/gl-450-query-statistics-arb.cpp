@@ -235,7 +235,7 @@ private:
 
 	bool begin()
 	{
-		bool Validated = this->checkExtension("GL_ARB_pipeline_statistics_query");
+		bool Validated = this->checkExtension(EXTENSION_ARB_pipeline_statistics_query);
 
 		if(Validated)
 			Validated = initQuery();
@@ -231,7 +231,7 @@ private:
 
 	bool begin()
 	{
-		bool Validated = this->checkExtension("GL_ARB_texture_barrier");
+		bool Validated = this->checkExtension(EXTENSION_ARB_texture_barrier);
 
 		glm::vec2 const WindowSize(this->getWindowSize());
 		glm::vec2 const WindowRange = WindowSize * 3.f;
@@ -1,4 +1,5 @@
 #include "test.hpp"
+#include <thread>
 
 namespace
 {
@@ -66,29 +67,35 @@ private:
 	{
 		bool Validated = true;
 
-		glMaxShaderCompilerThreadsARB(1);
+		// Let the implementation use as many compiler threads as it wants
+		glMaxShaderCompilerThreadsARB(0xFFFFFFFF);
 
 		GLint MaxShaderCompilerThreads = 0;
 		glGetIntegerv(GL_MAX_SHADER_COMPILER_THREADS_ARB, &MaxShaderCompilerThreads);
-		if (MaxShaderCompilerThreads != 1)
+		if (static_cast<GLuint>(MaxShaderCompilerThreads) != 0xFFFFFFFF)
 			return false;
 
 		compiler Compiler;
 	
 		if(Validated)
 		{
-			GLuint VertShaderName = Compiler.create(GL_VERTEX_SHADER, getDataDirectory() + VERT_SHADER_SOURCE, "--version 450 --profile core");
-			GLuint FragShaderName = Compiler.create(GL_FRAGMENT_SHADER, getDataDirectory() + FRAG_SHADER_SOURCE, "--version 450 --profile core");
+			compile_future VertShader = Compiler.createAsync(GL_VERTEX_SHADER, getDataDirectory() + VERT_SHADER_SOURCE, "--version 450 --profile core");
+			compile_future FragShader = Compiler.createAsync(GL_FRAGMENT_SHADER, getDataDirectory() + FRAG_SHADER_SOURCE, "--version 450 --profile core");
 
 			ProgramName[program::USED] = glCreateProgram();
-			glAttachShader(ProgramName[program::USED], VertShaderName);
-			glAttachShader(ProgramName[program::USED], FragShaderName);
+			glAttachShader(ProgramName[program::USED], VertShader.name());
+			glAttachShader(ProgramName[program::USED], FragShader.name());
 
 			glBindAttribLocation(ProgramName[program::USED], semantic::attr::POSITION, "Position");
 			glBindFragDataLocation(ProgramName[program::USED], semantic::frag::COLOR, "Color");
-			glLinkProgram(ProgramName[program::USED]);
+			compile_future Program = compiler::link(ProgramName[program::USED]);
+
+			// GL_COMPLETION_STATUS_ARB polling doesn't block, the sample has nothing else to do meanwhile
+			while(!Program.ready())
+				std::this_thread::yield();
 
 			Validated = Validated && Compiler.check();
+			Validated = Validated && Program.get();
 			Validated = Validated && Compiler.check_program(ProgramName[program::USED]);
 		}
 
@@ -187,7 +194,7 @@ private:
 
 	bool begin()
 	{
-		bool Validated = this->checkExtension("GL_ARB_parallel_shader_compile");
+		bool Validated = this->checkExtension(EXTENSION_ARB_parallel_shader_compile);
 
 		if(Validated)
 			Validated = initProgram();
@@ -63,25 +63,28 @@ private:
 	GLuint ProgramName;
 	GLuint TextureName;
 	glm::uint8* UniformPointer;
+	compiler Compiler;
 
+	// Only issues the compilation and the link, initPipeline waits for them
 	bool initProgram()
 	{
-		bool Validated = true;
-	
-		if(Validated)
-		{
-			compiler Compiler;
-			GLuint VertShaderName = Compiler.create(GL_VERTEX_SHADER, getDataDirectory() + VERT_SHADER_SOURCE, "--version 460 --profile core");
-			GLuint FragShaderName = Compiler.create(GL_FRAGMENT_SHADER, getDataDirectory() + FRAG_SHADER_SOURCE, "--version 460 --profile core");
-			Validated = Validated && Compiler.check();
-
-			ProgramName = glCreateProgram();
-			glProgramParameteri(ProgramName, GL_PROGRAM_SEPARABLE, GL_TRUE);
-			glAttachShader(ProgramName, VertShaderName);
-			glAttachShader(ProgramName, FragShaderName);
-			glLinkProgram(ProgramName);
-			Validated = Validated && Compiler.check_program(ProgramName);
-		}
+		compile_future VertShader = Compiler.createAsync(GL_VERTEX_SHADER, getDataDirectory() + VERT_SHADER_SOURCE, "--version 460 --profile core");
+		compile_future FragShader = Compiler.createAsync(GL_FRAGMENT_SHADER, getDataDirectory() + FRAG_SHADER_SOURCE, "--version 460 --profile core");
+
+		ProgramName = glCreateProgram();
+		glProgramParameteri(ProgramName, GL_PROGRAM_SEPARABLE, GL_TRUE);
+		glAttachShader(ProgramName, VertShader.name());
+		glAttachShader(ProgramName, FragShader.name());
+		compiler::link(ProgramName);
+
+		return this->checkError("initProgram");
+	}
+
+	bool initPipeline()
+	{
+		bool Validated = Compiler.check();
+		Validated = Validated && Compiler.check_program(ProgramName);
+		Compiler.clear();
 
 		if (Validated)
 		{
@@ -167,10 +170,13 @@ private:
 
 		if(Validated)
 			Validated = initBuffer();
+		if(Validated)
+			Validated = initProgram();
+		// The texture is loaded while the driver compiles when GL_KHR_parallel_shader_compile is supported
 		if(Validated)
 			Validated = initTexture();
 		if(Validated)
-			Validated = initProgram();
+			Validated = initPipeline();
 		if(Validated)
 			Validated = initVertexArray();
 
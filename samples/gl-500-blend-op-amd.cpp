@@ -312,7 +312,7 @@ private:
 		Viewport[texture::B] = glm::ivec4(0, WindowSize.y >> 1, WindowSize >> 1);
 
 		bool Validated(true);
-		Validated = Validated && this->checkExtension("GL_AMD_blend_minmax_factor");
+		Validated = Validated && this->checkExtension(EXTENSION_AMD_blend_minmax_factor);
 
 		if(Validated)
 			Validated = initBlend();
@@ -172,7 +172,7 @@ private:
 
 	bool begin()
 	{
-		bool Validated = this->checkExtension("GL_ARB_sparse_buffer");
+		bool Validated = this->checkExtension(EXTENSION_ARB_sparse_buffer);
 
 		if(Validated)
 			Validated = initProgram();
@@ -186,7 +186,7 @@ private:
 	bool begin()
 	{
 		bool Validated = true;
-		Validated = Validated && this->checkExtension("GL_NV_viewport_array2");
+		Validated = Validated && this->checkExtension(EXTENSION_NV_viewport_array2);
 
 		if(Validated)
 			Validated = initProgram();
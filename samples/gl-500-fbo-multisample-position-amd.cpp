@@ -228,7 +228,7 @@ private:
 
 	bool begin()
 	{
-		bool Validated = this->checkExtension("GL_AMD_sample_positions");
+		bool Validated = this->checkExtension(EXTENSION_AMD_sample_positions);
 
 		if(Validated)
 			Validated = initProgram();
@@ -145,8 +145,8 @@ private:
 	bool begin()
 	{
 		bool Validated(true);
-		Validated = Validated && this->checkExtension("GL_NV_shader_buffer_load");
-		Validated = Validated && this->checkExtension("GL_NV_vertex_buffer_unified_memory");
+		Validated = Validated && this->checkExtension(EXTENSION_NV_shader_buffer_load);
+		Validated = Validated && this->checkExtension(EXTENSION_NV_vertex_buffer_unified_memory);
 
 		if(Validated)
 			Validated = initProgram();
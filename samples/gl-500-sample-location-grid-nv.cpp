@@ -282,7 +282,7 @@ private:
 	bool begin()
 	{
 		bool Validated(true);
-		Validated = Validated && this->checkExtension("GL_NV_sample_locations");
+		Validated = Validated && this->checkExtension(EXTENSION_NV_sample_locations);
 
 		if(Validated)
 			Validated = initProgram();
@@ -343,8 +343,8 @@ private:
 	bool begin()
 	{
 		bool Validated(true);
-		Validated = Validated && this->checkExtension("GL_NV_sample_locations");
-		Validated = Validated && this->checkExtension("GL_NV_internalformat_sample_query");
+		Validated = Validated && this->checkExtension(EXTENSION_NV_sample_locations);
+		Validated = Validated && this->checkExtension(EXTENSION_NV_internalformat_sample_query);
 
 		// Obtain supported sample count for a format:
 		GLint num_sample_counts = 0;
@@ -256,7 +256,7 @@ private:
 
 	bool begin()
 	{
-		bool Validated = this->checkExtension("GL_INTEL_fragment_shader_ordering");
+		bool Validated = this->checkExtension(EXTENSION_INTEL_fragment_shader_ordering);
 
 /*
 		glm::vec2 const WindowSize(this->getWindowSize());
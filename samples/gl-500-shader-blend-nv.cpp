@@ -245,7 +245,7 @@ private:
 
 	bool begin()
 	{
-		bool Validated = this->checkExtension("GL_NV_fragment_shader_interlock");
+		bool Validated = this->checkExtension(EXTENSION_NV_fragment_shader_interlock);
 
 		glm::vec2 WindowSize(this->getWindowSize());
 		this->Viewports.resize(1000);
@@ -132,7 +132,7 @@ private:
 
 	bool begin()
 	{
-		bool Validated = this->checkExtension("GL_NV_shader_thread_group");
+		bool Validated = this->checkExtension(EXTENSION_NV_shader_thread_group);
 
 		if(Validated)
 			Validated = initBuffer();
@@ -124,7 +124,7 @@ private:
 	bool begin()
 	{
 		bool Validated(true);
-		Validated = Validated && this->checkExtension("GL_AMD_depth_clamp_separate");
+		Validated = Validated && this->checkExtension(EXTENSION_AMD_depth_clamp_separate);
 
 		if(Validated)
 			Validated = Validated && initTest();
@@ -184,7 +184,7 @@ private:
 	bool begin()
 	{
 		bool Validated(true);
-		Validated = Validated && this->checkExtension("GL_ARB_bindless_texture");
+		Validated = Validated && this->checkExtension(EXTENSION_ARB_bindless_texture);
 
 		this->sync(framework::ASYNC);
 
@@ -162,7 +162,7 @@ private:
 	bool begin()
 	{
 		bool Validated(true);
-		Validated = Validated && this->checkExtension("GL_NV_bindless_texture");
+		Validated = Validated && this->checkExtension(EXTENSION_NV_bindless_texture);
 
 		if(Validated)
 			Validated = initProgram();
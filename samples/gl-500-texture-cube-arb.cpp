@@ -201,10 +201,10 @@ private:
 	bool begin()
 	{
 		bool Validated = true;
-		Validated = Validated && this->checkExtension("GL_ARB_seamless_cubemap_per_texture");
-		Validated = Validated && this->checkExtension("GL_ARB_shader_storage_buffer_object");
-		Validated = Validated && this->checkExtension("GL_ARB_buffer_storage");
-		Validated = Validated && this->checkExtension("GL_ARB_multi_bind");
+		Validated = Validated && this->checkExtension(EXTENSION_ARB_seamless_cubemap_per_texture);
+		Validated = Validated && this->checkExtension(EXTENSION_ARB_shader_storage_buffer_object);
+		Validated = Validated && this->checkExtension(EXTENSION_ARB_buffer_storage);
+		Validated = Validated && this->checkExtension(EXTENSION_ARB_multi_bind);
 
 		if(Validated)
 			Validated = initProgram();
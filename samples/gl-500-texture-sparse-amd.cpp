@@ -189,7 +189,7 @@ private:
 	bool begin()
 	{
 		bool Validated(true);
-		Validated = Validated && this->checkExtension("GL_AMD_sparse_texture");
+		Validated = Validated && this->checkExtension(EXTENSION_AMD_sparse_texture);
 
 		if(Validated)
 			Validated = initProgram();
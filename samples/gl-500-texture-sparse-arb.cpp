@@ -192,7 +192,7 @@ private:
 	bool begin()
 	{
 		bool Validated(true);
-		Validated = Validated && this->checkExtension("GL_ARB_sparse_texture");
+		Validated = Validated && this->checkExtension(EXTENSION_ARB_sparse_texture);
 
 		if(Validated)
 			Validated = initProgram();
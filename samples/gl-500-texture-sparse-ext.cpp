@@ -177,7 +177,7 @@ private:
 	bool begin()
 	{
 		bool Validated(true);
-		Validated = Validated && this->checkExtension("GL_EXT_sparse_texture2");
+		Validated = Validated && this->checkExtension(EXTENSION_EXT_sparse_texture2);
 
 		if(Validated)
 			Validated = initProgram();
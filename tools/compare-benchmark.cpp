@@ -0,0 +1,103 @@
+#include "compare.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+namespace
+{
+	typedef std::size_t (*find_function)(glm::u8 const* A, glm::u8 const* B, std::size_t Offset, std::size_t Size, glm::u8 Threshold);
+
+	// Scan each row of the images as the template heuristics do and count the bytes above Threshold
+	std::size_t count_differences(image_rgb8 const & A, image_rgb8 const & B, glm::u8 Threshold, find_function Find)
+	{
+		std::size_t const RowSize = A.Extent.x * sizeof(glm::u8vec3);
+
+		std::size_t Count = 0;
+		for(int Y = 0; Y < A.Extent.y; ++Y)
+			for(std::size_t Offset = Find(A.row(Y), B.row(Y), 0, RowSize, Threshold); Offset < RowSize; Offset = Find(A.row(Y), B.row(Y), Offset + 1, RowSize, Threshold))
+				++Count;
+		return Count;
+	}
+
+	double time_differences(image_rgb8 const & A, image_rgb8 const & B, glm::u8 Threshold, find_function Find, int Iterations, std::size_t& Count)
+	{
+		std::chrono::steady_clock::time_point const Start = std::chrono::steady_clock::now();
+		for(int Iteration = 0; Iteration < Iterations; ++Iteration)
+			Count = count_differences(A, B, Threshold, Find);
+		return std::chrono::duration<double>(std::chrono::steady_clock::now() - Start).count() / Iterations;
+	}
+
+	char const* simd_name()
+	{
+#		if GLM_ARCH & GLM_ARCH_AVX2_BIT
+			return "AVX2";
+#		elif GLM_ARCH & GLM_ARCH_SSE2_BIT
+			return "SSE2";
+#		else
+			return "none";
+#		endif
+	}
+}//namespace
+
+// Usage: compare-benchmark [iterations]
+// Times the scalar and the SIMD find_absolute_difference kernels on 640x480 and 3840x2160 frames. The frames differ
+// from the template by at most one on most bytes so that the threshold 1 scan runs through the whole image, and by more
+// than one on a few bytes so that both kernels also have to report the same mismatches.
+int main(int argc, char* argv[])
+{
+	if(argc > 2)
+	{
+		fprintf(stderr, "Usage: %s [iterations]\n", argv[0]);
+		return EXIT_FAILURE;
+	}
+
+	int const Iterations = argc == 2 ? std::max(std::atoi(argv[1]), 1) : 100;
+	glm::ivec2 const Extents[] = {glm::ivec2(640, 480), glm::ivec2(3840, 2160)};
+
+	fprintf(stdout, "SIMD path: %s, %d iterations\n", simd_name(), Iterations);
+
+	bool Success = true;
+	for(std::size_t ExtentIndex = 0; ExtentIndex < sizeof(Extents) / sizeof(Extents[0]); ++ExtentIndex)
+	{
+		glm::ivec2 const Extent = Extents[ExtentIndex];
+		std::size_t const Size = static_cast<std::size_t>(Extent.x) * Extent.y * sizeof(glm::u8vec3);
+
+		std::vector<glm::u8> Template(Size);
+		std::vector<glm::u8> Frame(Size);
+		unsigned int Seed = 1;
+		for(std::size_t Offset = 0; Offset < Size; ++Offset)
+		{
+			Seed = Seed * 1103515245u + 12345u;
+			Template[Offset] = static_cast<glm::u8>(Seed >> 16);
+			Frame[Offset] = static_cast<glm::u8>(Template[Offset] + ((Seed >> 8) & 1));
+			if((Seed >> 4) % 65536 == 0)
+				Frame[Offset] = static_cast<glm::u8>(Template[Offset] + 128);
+		}
+
+		image_rgb8 const A(&Template[0], Extent);
+		image_rgb8 const B(&Frame[0], Extent);
+
+		std::size_t ScalarCount = 0;
+		std::size_t SimdCount = 0;
+		double const ScalarTime = time_differences(A, B, 1, find_absolute_difference_scalar, Iterations, ScalarCount);
+		double const SimdTime = time_differences(A, B, 1, find_absolute_difference, Iterations, SimdCount);
+
+		fprintf(stdout, "%dx%d: scalar %.3f ms (%.1f MB/s), SIMD %.3f ms (%.1f MB/s), %.1fx, %d mismatches\n",
+			Extent.x, Extent.y,
+			ScalarTime * 1e3, static_cast<double>(Size) * 2 / ScalarTime / (1024.0 * 1024.0),
+			SimdTime * 1e3, static_cast<double>(Size) * 2 / SimdTime / (1024.0 * 1024.0),
+			ScalarTime / SimdTime, static_cast<int>(SimdCount));
+
+		if(ScalarCount != SimdCount)
+		{
+			fprintf(stderr, "%dx%d: the scalar kernel found %d mismatches, the SIMD kernel %d\n",
+				Extent.x, Extent.y, static_cast<int>(ScalarCount), static_cast<int>(SimdCount));
+			Success = false;
+		}
+	}
+
+	return Success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
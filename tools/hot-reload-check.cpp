@@ -0,0 +1,133 @@
+#include "test.hpp"
+#include "shader_watcher.hpp"
+
+#include <chrono>
+#include <fstream>
+#include <iterator>
+#include <thread>
+#include <vector>
+
+namespace
+{
+	char const* VERT_SHADER_SOURCE("gl-420/texture-2d.vert");
+	char const* FRAG_SHADER_SOURCE("gl-420/texture-2d.frag");
+	char const* SHARED_HEADER_SOURCE("gl-420/texture-2d.glsl");
+
+	// Relinks take a few milliseconds on llvmpipe, the deadline only bounds a broken watcher
+	std::chrono::seconds const RELOAD_TIMEOUT(10);
+}//namespace
+
+// Builds its program the way the samples do, with a compiler local to begin() and cleared right away, then rewrites
+// the header shared by both shaders with the same bytes. The watcher must recompile them and relink the program.
+class sample : public framework
+{
+public:
+	sample(int argc, char* argv[]) :
+		framework(argc, argv, "hot-reload-check", framework::CORE, 4, 2, 1, RUN_ONLY, glm::uvec2(64, 64)),
+		ProgramName(0),
+		Reloaded(false)
+	{}
+
+private:
+	GLuint ProgramName;
+	bool Reloaded;
+
+	bool begin()
+	{
+		if(!get_shader_watcher().isEnabled())
+		{
+			fprintf(stderr, "Shader hot reload is unavailable\n");
+			return false;
+		}
+
+		bool Validated(true);
+
+		compiler Compiler;
+		GLuint VertShaderName = Compiler.create(GL_VERTEX_SHADER, getDataDirectory() + VERT_SHADER_SOURCE, "--version 420 --profile core");
+		GLuint FragShaderName = Compiler.create(GL_FRAGMENT_SHADER, getDataDirectory() + FRAG_SHADER_SOURCE, "--version 420 --profile core");
+		Validated = Validated && Compiler.check();
+
+		this->ProgramName = glCreateProgram();
+		glAttachShader(this->ProgramName, VertShaderName);
+		glAttachShader(this->ProgramName, FragShaderName);
+		glLinkProgram(this->ProgramName);
+		Validated = Validated && Compiler.check_program(this->ProgramName);
+
+		// Deletes the shaders, the program holds them
+		Compiler.clear();
+
+		return Validated;
+	}
+
+	bool end()
+	{
+		glDeleteProgram(this->ProgramName);
+
+		return true;
+	}
+
+	bool render()
+	{
+		if(this->Reloaded)
+			return true;
+
+		shader_watcher& Watcher = get_shader_watcher();
+		std::size_t const Relinks = Watcher.relinks();
+
+		std::string const Filename = getDataDirectory() + SHARED_HEADER_SOURCE;
+		std::vector<char> Content;
+		{
+			std::ifstream Input(Filename.c_str(), std::ios::binary);
+			Content.assign(std::istreambuf_iterator<char>(Input), std::istreambuf_iterator<char>());
+			if(!Input || Content.empty())
+			{
+				fprintf(stderr, "%s: can't be read\n", Filename.c_str());
+				return false;
+			}
+		}
+		{
+			std::ofstream Output(Filename.c_str(), std::ios::binary | std::ios::trunc);
+			Output.write(&Content[0], static_cast<std::streamsize>(Content.size()));
+			if(!Output)
+			{
+				fprintf(stderr, "%s: can't be written\n", Filename.c_str());
+				return false;
+			}
+		}
+
+		std::chrono::steady_clock::time_point const Deadline = std::chrono::steady_clock::now() + RELOAD_TIMEOUT;
+		while(Watcher.relinks() == Relinks && std::chrono::steady_clock::now() < Deadline)
+		{
+			Watcher.update();
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+
+		if(Watcher.relinks() == Relinks)
+		{
+			fprintf(stderr, "%s changed but the program including it wasn't relinked\n", Filename.c_str());
+			return false;
+		}
+
+		this->Reloaded = true;
+
+		GLint Status = GL_FALSE;
+		glGetProgramiv(this->ProgramName, GL_LINK_STATUS, &Status);
+		return Status == GL_TRUE;
+	}
+};
+
+// Usage: hot-reload-check [--headless]
+int main(int argc, char* argv[])
+{
+	std::vector<char*> Arguments(argv, argv + argc);
+	char HotReload[] = "--hot-reload";
+	Arguments.push_back(HotReload);
+	Arguments.push_back(nullptr);
+
+	int Error = 0;
+
+	sample Sample(static_cast<int>(Arguments.size() - 1), &Arguments[0]);
+	Error += Sample();
+
+	return Error;
+}
@@ -0,0 +1,483 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if !defined(_WIN32)
+#	include <fcntl.h>
+#	include <poll.h>
+#	include <signal.h>
+#	include <sys/wait.h>
+#	include <unistd.h>
+#endif
+
+namespace
+{
+	typedef std::chrono::steady_clock clock_type;
+
+	struct sample_result
+	{
+		sample_result() :
+			ExitCode(-1),
+			Time(0.0),
+			Worker(-1)
+		{}
+
+		std::string Name;
+		std::string Status;
+		int ExitCode;
+		double Time;
+		int Worker;
+		std::vector<std::string> Artifacts;
+	};
+
+	struct worker
+	{
+		worker() :
+			Pid(-1),
+			Input(-1),
+			Output(-1)
+		{}
+
+		int Pid;
+		int Input;
+		int Output;
+		std::string Pending;
+		std::string Sample;
+		clock_type::time_point Start;
+	};
+
+	std::vector<std::string> split(std::string const & String, char Separator)
+	{
+		std::vector<std::string> Tokens;
+		std::istringstream Stream(String);
+		std::string Token;
+		while(std::getline(Stream, Token, Separator))
+			Tokens.push_back(Token);
+		return Tokens;
+	}
+
+	std::string escape_json(std::string const & String)
+	{
+		std::string Escaped;
+		Escaped.reserve(String.size());
+		for(std::size_t CharIndex = 0; CharIndex < String.size(); ++CharIndex)
+		{
+			char const Char = String[CharIndex];
+			if(Char == '"' || Char == '\\')
+				Escaped += '\\';
+			if(static_cast<unsigned char>(Char) < 0x20)
+				continue;
+			Escaped += Char;
+		}
+		return Escaped;
+	}
+
+	// Timings file: one "name<TAB>milliseconds" line per sample, written by the previous runs
+	std::map<std::string, double> load_timings(std::string const & Filename)
+	{
+		std::map<std::string, double> Timings;
+
+		std::ifstream File(Filename.c_str());
+		std::string Line;
+		while(std::getline(File, Line))
+		{
+			std::vector<std::string> const Tokens = split(Line, '\t');
+			if(Tokens.size() == 2)
+				Timings[Tokens[0]] = std::atof(Tokens[1].c_str());
+		}
+
+		return Timings;
+	}
+
+	bool save_timings(std::string const & Filename, std::map<std::string, double> const & Timings)
+	{
+		std::string const Temporary = Filename + ".tmp";
+		{
+			std::ofstream File(Temporary.c_str());
+			for(std::map<std::string, double>::const_iterator It = Timings.begin(); It != Timings.end(); ++It)
+				File << It->first << '\t' << It->second << '\n';
+			if(!File)
+				return false;
+		}
+		return std::rename(Temporary.c_str(), Filename.c_str()) == 0;
+	}
+
+	bool save_report(std::string const & Filename, std::vector<sample_result> const & Results, std::size_t Jobs, double WallTime)
+	{
+		std::size_t PassCount = 0;
+		for(std::size_t ResultIndex = 0; ResultIndex < Results.size(); ++ResultIndex)
+			if(Results[ResultIndex].Status == "pass")
+				++PassCount;
+
+		std::ofstream File(Filename.c_str());
+		File << "{\n";
+		File << "\t\"jobs\": " << Jobs << ",\n";
+		File << "\t\"wall_time_ms\": " << WallTime << ",\n";
+		File << "\t\"passed\": " << PassCount << ",\n";
+		File << "\t\"failed\": " << Results.size() - PassCount << ",\n";
+		File << "\t\"samples\": [\n";
+		for(std::size_t ResultIndex = 0; ResultIndex < Results.size(); ++ResultIndex)
+		{
+			sample_result const & Result = Results[ResultIndex];
+			File << "\t\t{\"name\": \"" << escape_json(Result.Name) << "\", \"status\": \"" << Result.Status << "\", \"exit_code\": " << Result.ExitCode
+				<< ", \"time_ms\": " << Result.Time << ", \"worker\": " << Result.Worker << ", \"artifacts\": [";
+			for(std::size_t ArtifactIndex = 0; ArtifactIndex < Result.Artifacts.size(); ++ArtifactIndex)
+				File << (ArtifactIndex ? ", " : "") << '"' << escape_json(Result.Artifacts[ArtifactIndex]) << '"';
+			File << "]}" << (ResultIndex + 1 < Results.size() ? "," : "") << "\n";
+		}
+		File << "\t]\n";
+		File << "}\n";
+
+		return static_cast<bool>(File);
+	}
+
+#	if !defined(_WIN32)
+		std::vector<std::string> list_samples(std::string const & Runner, std::vector<std::string> const & Filters)
+		{
+			std::string Command = "\"" + Runner + "\" --list";
+			for(std::size_t FilterIndex = 0; FilterIndex < Filters.size(); ++FilterIndex)
+				Command += " \"" + Filters[FilterIndex] + "\"";
+
+			std::vector<std::string> Samples;
+			FILE* Pipe = popen(Command.c_str(), "r");
+			if(!Pipe)
+				return Samples;
+
+			char Line[256];
+			while(std::fgets(Line, sizeof(Line), Pipe))
+			{
+				std::string Name(Line);
+				while(!Name.empty() && (Name.back() == '\n' || Name.back() == '\r'))
+					Name.pop_back();
+				if(!Name.empty())
+					Samples.push_back(Name);
+			}
+			pclose(Pipe);
+
+			return Samples;
+		}
+
+		// Each worker is a headless sample-runner: sample names go through its stdin, results come back on a dedicated pipe
+		// so that the logs of the samples can't corrupt them.
+		bool spawn_worker(worker& Worker, std::string const & Runner, std::size_t ThreadCount, bool Verbose)
+		{
+			int InputPipe[2];
+			int OutputPipe[2];
+			if(pipe(InputPipe) != 0)
+				return false;
+			if(pipe(OutputPipe) != 0)
+			{
+				close(InputPipe[0]);
+				close(InputPipe[1]);
+				return false;
+			}
+
+			int const Pid = fork();
+			if(Pid == 0)
+			{
+				dup2(InputPipe[0], STDIN_FILENO);
+				close(InputPipe[0]);
+				close(InputPipe[1]);
+				close(OutputPipe[0]);
+
+				if(!Verbose)
+				{
+					int const Null = open("/dev/null", O_WRONLY);
+					dup2(Null, STDOUT_FILENO);
+					dup2(Null, STDERR_FILENO);
+					close(Null);
+				}
+
+				// The workers already use every core, keep llvmpipe from spawning its own rasterizer threads in each of them
+				setenv("LP_NUM_THREADS", "1", 0);
+				// and the template comparisons of each worker to its share of the cores
+				setenv("OGL_SAMPLES_THREADS", std::to_string(ThreadCount).c_str(), 1);
+
+				std::string const ResultArgument = "--worker=" + std::to_string(OutputPipe[1]);
+				execl(Runner.c_str(), Runner.c_str(), "--headless", ResultArgument.c_str(), static_cast<char*>(nullptr));
+				_exit(127);
+			}
+
+			close(InputPipe[0]);
+			close(OutputPipe[1]);
+			if(Pid < 0)
+			{
+				close(InputPipe[1]);
+				close(OutputPipe[0]);
+				return false;
+			}
+
+			fcntl(InputPipe[1], F_SETFD, FD_CLOEXEC);
+			fcntl(OutputPipe[0], F_SETFD, FD_CLOEXEC);
+
+			Worker.Pid = Pid;
+			Worker.Input = InputPipe[1];
+			Worker.Output = OutputPipe[0];
+			Worker.Pending.clear();
+			Worker.Sample.clear();
+			return true;
+		}
+
+		void stop_worker(worker& Worker, bool Kill)
+		{
+			if(Worker.Pid < 0)
+				return;
+
+			close(Worker.Input);
+			if(Kill)
+				kill(Worker.Pid, SIGKILL);
+			waitpid(Worker.Pid, nullptr, 0);
+			close(Worker.Output);
+
+			Worker.Pid = -1;
+			Worker.Input = -1;
+			Worker.Output = -1;
+		}
+
+		bool dispatch(worker& Worker, std::string const & Sample)
+		{
+			std::string const Line = Sample + "\n";
+			if(write(Worker.Input, Line.c_str(), Line.size()) != static_cast<ssize_t>(Line.size()))
+				return false;
+
+			Worker.Sample = Sample;
+			Worker.Start = clock_type::now();
+			return true;
+		}
+#	endif//!_WIN32
+}//namespace
+
+// Usage: sample-orchestrator [--jobs=N] [--threads=N] [--runner=path] [--report=file] [--timings=file] [--timeout=seconds] [--verbose] [filter...]
+// Runs the samples selected by the filters in N headless sample-runner worker processes, each with its own context.
+// The samples are scheduled longest first using the timings of the previous runs, the samples without timing first.
+// Each worker compares the frames with N threads, by default the hardware threads shared between the workers.
+// A crashed or hung worker only fails its current sample and is replaced. The results, timings and template diff
+// images of every sample are written to a JSON report.
+int main(int argc, char* argv[])
+{
+#	if defined(_WIN32)
+		fprintf(stderr, "sample-orchestrator requires a POSIX system, use sample-runner instead\n");
+		return EXIT_FAILURE;
+#	else
+		std::size_t Jobs = std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+		std::size_t Threads = 0;
+		std::string Runner;
+		std::string ReportFile = "sample-report.json";
+		std::string TimingsFile = "sample-timings.txt";
+		double Timeout = 300.0;
+		bool Verbose = false;
+		std::vector<std::string> Filters;
+
+		for(int ArgIndex = 1; ArgIndex < argc; ++ArgIndex)
+		{
+			std::string const Argument(argv[ArgIndex]);
+			if(Argument.compare(0, 7, "--jobs=") == 0)
+				Jobs = std::max(std::atoi(Argument.c_str() + 7), 1);
+			else if(Argument.compare(0, 10, "--threads=") == 0)
+				Threads = std::max(std::atoi(Argument.c_str() + 10), 1);
+			else if(Argument.compare(0, 9, "--runner=") == 0)
+				Runner = Argument.substr(9);
+			else if(Argument.compare(0, 9, "--report=") == 0)
+				ReportFile = Argument.substr(9);
+			else if(Argument.compare(0, 10, "--timings=") == 0)
+				TimingsFile = Argument.substr(10);
+			else if(Argument.compare(0, 10, "--timeout=") == 0)
+				Timeout = std::atof(Argument.c_str() + 10);
+			else if(Argument == "--verbose")
+				Verbose = true;
+			else if(Argument.compare(0, 2, "--") != 0)
+				Filters.push_back(Argument);
+			else
+			{
+				fprintf(stderr, "Unknown option: %s\n", Argument.c_str());
+				return EXIT_FAILURE;
+			}
+		}
+
+		if(Runner.empty())
+		{
+			std::string const Self(argv[0]);
+			std::size_t const Separator = Self.find_last_of('/');
+			Runner = (Separator == std::string::npos ? std::string(".") : Self.substr(0, Separator)) + "/sample-runner";
+		}
+
+		signal(SIGPIPE, SIG_IGN);
+
+		std::vector<std::string> Queue = list_samples(Runner, Filters);
+		if(Queue.empty())
+		{
+			fprintf(stderr, "No sample to run with %s\n", Runner.c_str());
+			return EXIT_FAILURE;
+		}
+
+		// Longest first so the last samples to finish are short ones, unknown samples first as they may be long
+		std::map<std::string, double> Timings = load_timings(TimingsFile);
+		std::stable_sort(Queue.begin(), Queue.end(), [&](std::string const & A, std::string const & B)
+		{
+			std::map<std::string, double>::const_iterator const TimingA = Timings.find(A);
+			std::map<std::string, double>::const_iterator const TimingB = Timings.find(B);
+			if(TimingA == Timings.end() || TimingB == Timings.end())
+				return TimingA == Timings.end() && TimingB != Timings.end();
+			return TimingA->second > TimingB->second;
+		});
+		std::reverse(Queue.begin(), Queue.end());
+
+		std::size_t const SampleCount = Queue.size();
+		std::vector<sample_result> Results;
+		Results.reserve(SampleCount);
+
+		clock_type::time_point const SuiteStart = clock_type::now();
+
+		std::vector<worker> Workers(std::min(Jobs, SampleCount));
+		if(Threads == 0)
+			Threads = std::max<std::size_t>(std::thread::hardware_concurrency() / Workers.size(), 1);
+
+		for(std::size_t WorkerIndex = 0; WorkerIndex < Workers.size(); ++WorkerIndex)
+			if(!spawn_worker(Workers[WorkerIndex], Runner, Threads, Verbose))
+			{
+				fprintf(stderr, "Failed to start the worker %s\n", Runner.c_str());
+				return EXIT_FAILURE;
+			}
+
+		auto Record = [&](worker const & Worker, std::size_t WorkerIndex, char const* Status, int ExitCode, double Time, std::vector<std::string> const & Artifacts)
+		{
+			sample_result Result;
+			Result.Name = Worker.Sample;
+			Result.Status = Status;
+			Result.ExitCode = ExitCode;
+			Result.Time = Time;
+			Result.Worker = static_cast<int>(WorkerIndex);
+			Result.Artifacts = Artifacts;
+			Results.push_back(Result);
+
+			fprintf(stdout, "[%d/%d] %s %s (%.1f ms)\n", static_cast<int>(Results.size()), static_cast<int>(SampleCount), Status, Result.Name.c_str(), Time);
+			fflush(stdout);
+		};
+
+		while(Results.size() < SampleCount)
+		{
+			std::vector<pollfd> PollDescriptors;
+			std::vector<std::size_t> PollWorkers;
+
+			for(std::size_t WorkerIndex = 0; WorkerIndex < Workers.size(); ++WorkerIndex)
+			{
+				worker& Worker = Workers[WorkerIndex];
+
+				if(Worker.Pid < 0 && !Queue.empty())
+					spawn_worker(Worker, Runner, Threads, Verbose);
+				if(Worker.Pid < 0)
+					continue;
+
+				if(Worker.Sample.empty() && !Queue.empty())
+				{
+					std::string const Sample = Queue.back();
+					Queue.pop_back();
+					if(!dispatch(Worker, Sample))
+					{
+						Worker.Sample = Sample;
+						Record(Worker, WorkerIndex, "crash", -1, 0.0, std::vector<std::string>());
+						Worker.Sample.clear();
+						stop_worker(Worker, true);
+						continue;
+					}
+				}
+
+				if(Worker.Sample.empty())
+					continue;
+
+				pollfd Descriptor;
+				Descriptor.fd = Worker.Output;
+				Descriptor.events = POLLIN;
+				Descriptor.revents = 0;
+				PollDescriptors.push_back(Descriptor);
+				PollWorkers.push_back(WorkerIndex);
+			}
+
+			if(PollDescriptors.empty())
+			{
+				if(Queue.empty())
+					break;
+				fprintf(stderr, "Failed to start the worker %s\n", Runner.c_str());
+				return EXIT_FAILURE;
+			}
+
+			poll(&PollDescriptors[0], PollDescriptors.size(), 100);
+
+			for(std::size_t PollIndex = 0; PollIndex < PollDescriptors.size(); ++PollIndex)
+			{
+				std::size_t const WorkerIndex = PollWorkers[PollIndex];
+				worker& Worker = Workers[WorkerIndex];
+				double const Elapsed = std::chrono::duration<double, std::milli>(clock_type::now() - Worker.Start).count();
+
+				if(PollDescriptors[PollIndex].revents & (POLLIN | POLLHUP | POLLERR))
+				{
+					char Buffer[4096];
+					ssize_t const Size = read(Worker.Output, Buffer, sizeof(Buffer));
+					if(Size <= 0)
+					{
+						// The worker died during the sample, most likely an assert or a driver crash
+						Record(Worker, WorkerIndex, "crash", -1, Elapsed, std::vector<std::string>());
+						Worker.Sample.clear();
+						stop_worker(Worker, false);
+						continue;
+					}
+
+					Worker.Pending.append(Buffer, static_cast<std::size_t>(Size));
+					std::size_t const LineEnd = Worker.Pending.find('\n');
+					if(LineEnd == std::string::npos)
+						continue;
+
+					std::vector<std::string> const Fields = split(Worker.Pending.substr(0, LineEnd), '\t');
+					Worker.Pending.erase(0, LineEnd + 1);
+
+					int const ExitCode = Fields.size() > 1 ? std::atoi(Fields[1].c_str()) : -1;
+					double const Time = Fields.size() > 2 ? std::atof(Fields[2].c_str()) : Elapsed;
+					std::vector<std::string> const Artifacts = Fields.size() > 3 ? split(Fields[3], ';') : std::vector<std::string>();
+
+					Record(Worker, WorkerIndex, ExitCode == EXIT_SUCCESS ? "pass" : "fail", ExitCode, Time, Artifacts);
+					Timings[Worker.Sample] = Time;
+					Worker.Sample.clear();
+				}
+				else if(Timeout > 0.0 && Elapsed > Timeout * 1000.0)
+				{
+					Record(Worker, WorkerIndex, "timeout", -1, Elapsed, std::vector<std::string>());
+					Timings[Worker.Sample] = Elapsed;
+					Worker.Sample.clear();
+					stop_worker(Worker, true);
+				}
+			}
+		}
+
+		for(std::size_t WorkerIndex = 0; WorkerIndex < Workers.size(); ++WorkerIndex)
+			stop_worker(Workers[WorkerIndex], false);
+
+		double const WallTime = std::chrono::duration<double, std::milli>(clock_type::now() - SuiteStart).count();
+
+		std::sort(Results.begin(), Results.end(), [](sample_result const & A, sample_result const & B)
+		{
+			return A.Name < B.Name;
+		});
+
+		if(!save_report(ReportFile, Results, Workers.size(), WallTime))
+			fprintf(stderr, "Failed to write the report: %s\n", ReportFile.c_str());
+		if(!save_timings(TimingsFile, Timings))
+			fprintf(stderr, "Failed to write the timings: %s\n", TimingsFile.c_str());
+
+		std::size_t PassCount = 0;
+		for(std::size_t ResultIndex = 0; ResultIndex < Results.size(); ++ResultIndex)
+			if(Results[ResultIndex].Status == "pass")
+				++PassCount;
+
+		fprintf(stdout, "%d/%d samples passed with %d workers (%.1f ms)\n", static_cast<int>(PassCount), static_cast<int>(Results.size()), static_cast<int>(Workers.size()), WallTime);
+
+		return PassCount == Results.size() ? EXIT_SUCCESS : EXIT_FAILURE;
+#	endif
+}
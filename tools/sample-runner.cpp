@@ -0,0 +1,150 @@
+#include "test.hpp"
+#include "sample_registry.hpp"
+#include "program_cache.hpp"
+#include "compiler_telemetry.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+namespace
+{
+	sample_entry const* find_sample(std::vector<sample_entry> const & Samples, std::string const & Name)
+	{
+		for(std::size_t SampleIndex = 0; SampleIndex < Samples.size(); ++SampleIndex)
+			if(Samples[SampleIndex].Name == Name)
+				return &Samples[SampleIndex];
+		return nullptr;
+	}
+
+	// Runs a sample and returns its duration in milliseconds
+	double run_sample(sample_entry const & Sample, int argc, char* argv[], int& Result)
+	{
+		std::chrono::high_resolution_clock::time_point const Start = std::chrono::high_resolution_clock::now();
+		Result = Sample.Main(argc, argv);
+		return std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - Start).count();
+	}
+
+	// Worker mode used by sample-orchestrator: sample names are read from stdin, one per line, and each result is written
+	// as "name<TAB>exit code<TAB>milliseconds<TAB>artifact;artifact" to the result file descriptor. The samples keep
+	// stdout and stderr for their own logs.
+	int run_worker(std::vector<sample_entry> const & Samples, int ResultDescriptor, int argc, char* argv[])
+	{
+		FILE* Results = fdopen(ResultDescriptor, "w");
+		if(!Results)
+		{
+			fprintf(stderr, "Failed to open the result descriptor %d\n", ResultDescriptor);
+			return EXIT_FAILURE;
+		}
+
+		std::string Name;
+		while(std::getline(std::cin, Name))
+		{
+			int Result = EXIT_FAILURE;
+			double Time = 0.0;
+
+			sample_entry const* Sample = find_sample(Samples, Name);
+			if(Sample)
+				Time = run_sample(*Sample, argc, argv, Result);
+
+			std::vector<std::string> const Artifacts = framework::takeArtifacts();
+			std::string ArtifactList;
+			for(std::size_t ArtifactIndex = 0; ArtifactIndex < Artifacts.size(); ++ArtifactIndex)
+				ArtifactList += (ArtifactIndex ? ";" : "") + Artifacts[ArtifactIndex];
+
+			fprintf(Results, "%s\t%d\t%f\t%s\n", Name.c_str(), Sample ? Result : -1, Time, ArtifactList.c_str());
+			fflush(Results);
+		}
+
+		fclose(Results);
+		return EXIT_SUCCESS;
+	}
+}//namespace
+
+// Usage: sample-runner [--headless] [--list] [--worker=<fd>] [--telemetry=<file.json>] [filter...]
+// Runs every sample linked in the runner, or the samples whose name contains one of the filters, in a single process.
+// Consecutive samples requesting the same profile, version and window size share one window or context.
+// The arguments are forwarded to each sample so --headless applies to all of them.
+// --list prints the selected sample names, --worker runs the samples requested on stdin for sample-orchestrator.
+// --telemetry writes the compile and link records of every shader and program of the run.
+int main(int argc, char* argv[])
+{
+	std::vector<char const*> Filters;
+	bool List = false;
+	int ResultDescriptor = -1;
+	char const* TelemetryFile = nullptr;
+	for(int ArgIndex = 1; ArgIndex < argc; ++ArgIndex)
+	{
+		if(std::strcmp(argv[ArgIndex], "--list") == 0)
+			List = true;
+		else if(std::strncmp(argv[ArgIndex], "--telemetry=", 12) == 0)
+			TelemetryFile = argv[ArgIndex] + 12;
+		else if(std::strncmp(argv[ArgIndex], "--worker=", 9) == 0)
+			ResultDescriptor = std::atoi(argv[ArgIndex] + 9);
+		else if(std::strncmp(argv[ArgIndex], "--", 2) != 0)
+			Filters.push_back(argv[ArgIndex]);
+	}
+
+	std::vector<sample_entry> Samples;
+	{
+		std::vector<sample_entry> const Registered = get_registered_samples();
+		for(std::size_t SampleIndex = 0; SampleIndex < Registered.size(); ++SampleIndex)
+		{
+			bool Selected = Filters.empty();
+			for(std::size_t FilterIndex = 0; FilterIndex < Filters.size() && !Selected; ++FilterIndex)
+				Selected = Registered[SampleIndex].Name.find(Filters[FilterIndex]) != std::string::npos;
+			if(Selected)
+				Samples.push_back(Registered[SampleIndex]);
+		}
+	}
+
+	if(List)
+	{
+		for(std::size_t SampleIndex = 0; SampleIndex < Samples.size(); ++SampleIndex)
+			fprintf(stdout, "%s\n", Samples[SampleIndex].Name.c_str());
+		return EXIT_SUCCESS;
+	}
+
+	framework::reuseContext(true);
+
+	if(ResultDescriptor >= 0)
+	{
+		int const Result = run_worker(Samples, ResultDescriptor, argc, argv);
+		framework::reuseContext(false);
+		return Result;
+	}
+
+	std::size_t FailureCount = 0;
+	std::chrono::high_resolution_clock::time_point const SuiteStart = std::chrono::high_resolution_clock::now();
+
+	for(std::size_t SampleIndex = 0; SampleIndex < Samples.size(); ++SampleIndex)
+	{
+		int Result = EXIT_FAILURE;
+		double const SampleTime = run_sample(Samples[SampleIndex], argc, argv, Result);
+		if(Result != EXIT_SUCCESS)
+			++FailureCount;
+
+		fprintf(stdout, "%s %s (%.1f ms)\n", Result == EXIT_SUCCESS ? "PASS" : "FAIL", Samples[SampleIndex].Name.c_str(), SampleTime);
+		fflush(stdout);
+	}
+
+	framework::reuseContext(false);
+
+	double const SuiteTime = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - SuiteStart).count();
+	fprintf(stdout, "%d/%d samples passed (%.1f ms)\n", static_cast<int>(Samples.size() - FailureCount), static_cast<int>(Samples.size()), SuiteTime);
+	variant_statistics const Variants = compiler::getVariantStatistics();
+	fprintf(stdout, "Shader variants: %d requested, %d compiled, %d deduplicated\n", static_cast<int>(Variants.Requests), static_cast<int>(Variants.Compiles), static_cast<int>(Variants.Deduplicated));
+
+	if(get_program_cache().isEnabled())
+	{
+		program_cache const & Cache = get_program_cache();
+		fprintf(stdout, "Program cache: %d hits, %d misses, %d rejected\n", static_cast<int>(Cache.hits()), static_cast<int>(Cache.misses()), static_cast<int>(Cache.rejects()));
+	}
+
+	if(TelemetryFile && !get_compiler_telemetry().saveJson(TelemetryFile))
+		fprintf(stderr, "Failed to write the compiler telemetry: %s\n", TelemetryFile);
+
+	return FailureCount == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
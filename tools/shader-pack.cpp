@@ -0,0 +1,79 @@
+#include "shader_pack.hpp"
+#include "compiler.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+
+std::string getDataDirectory();
+
+// Usage: shader-pack <output.pack> <list.txt>
+// list.txt holds one shader path relative to the data directory per line. Each shader is preprocessed to find the
+// files it includes, the shaders and their includes are packed with the stamp they have now.
+int main(int argc, char* argv[])
+{
+	if(argc != 3)
+	{
+		fprintf(stderr, "Usage: %s <output.pack> <shader-list.txt>\n", argv[0]);
+		return EXIT_FAILURE;
+	}
+
+	std::ifstream List(argv[2]);
+	if(!List.is_open())
+	{
+		fprintf(stderr, "Failed to open the shader list: %s\n", argv[2]);
+		return EXIT_FAILURE;
+	}
+
+	std::string const Directory = getDataDirectory();
+	std::map<std::string, file_stamp> Files;
+
+	std::string Path;
+	while(std::getline(List, Path))
+	{
+		if(Path.empty())
+			continue;
+
+		source_cache::dependencies Dependencies;
+		compiler::preprocess(Directory + Path, std::string(), &Dependencies);
+		if(Dependencies.empty() || !Dependencies[0].second.Exists)
+		{
+			fprintf(stderr, "Failed to load the shader: %s\n", Path.c_str());
+			return EXIT_FAILURE;
+		}
+
+		// Only the files of the data directory are packed, the candidates that don't exist are left out
+		for(std::size_t DependencyIndex = 0; DependencyIndex < Dependencies.size(); ++DependencyIndex)
+		{
+			std::string const & Filename = Dependencies[DependencyIndex].first;
+			if(Dependencies[DependencyIndex].second.Exists && Filename.compare(0, Directory.size(), Directory) == 0)
+				Files[Filename.substr(Directory.size())] = Dependencies[DependencyIndex].second;
+		}
+	}
+
+	std::vector<std::string> Paths;
+	std::vector<std::string> Contents;
+	std::vector<file_stamp> Stamps;
+	for(std::map<std::string, file_stamp>::const_iterator Iterator = Files.begin(); Iterator != Files.end(); ++Iterator)
+	{
+		std::shared_ptr<std::string const> Content = get_source_cache().loadFile(Directory + Iterator->first);
+		if(!Content)
+		{
+			fprintf(stderr, "Failed to load the shader: %s\n", Iterator->first.c_str());
+			return EXIT_FAILURE;
+		}
+
+		Paths.push_back(Iterator->first);
+		Contents.push_back(*Content);
+		Stamps.push_back(Iterator->second);
+	}
+
+	if(!save_shader_pack(argv[1], Paths, Contents, Stamps))
+	{
+		fprintf(stderr, "Failed to write the shader pack: %s\n", argv[1]);
+		return EXIT_FAILURE;
+	}
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,62 @@
+#include "compiler.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+
+// Usage: shader-preprocess <shader-list.txt> [iterations]
+// shader-list.txt holds one shader path per line. Each shader is preprocessed once to warm the file cache, then every
+// shader is preprocessed the given number of times and the throughput of the preprocessor is printed.
+int main(int argc, char* argv[])
+{
+	if(argc != 2 && argc != 3)
+	{
+		fprintf(stderr, "Usage: %s <shader-list.txt> [iterations]\n", argv[0]);
+		return EXIT_FAILURE;
+	}
+
+	std::ifstream List(argv[1]);
+	if(!List.is_open())
+	{
+		fprintf(stderr, "Failed to open the shader list: %s\n", argv[1]);
+		return EXIT_FAILURE;
+	}
+
+	std::vector<std::string> Paths;
+	std::string Path;
+	while(std::getline(List, Path))
+		if(!Path.empty())
+			Paths.push_back(Path);
+
+	int const Iterations = argc == 3 ? std::max(std::atoi(argv[2]), 1) : 100;
+
+	std::size_t InputBytes = 0;
+	std::size_t OutputBytes = 0;
+	for(std::size_t PathIndex = 0; PathIndex < Paths.size(); ++PathIndex)
+	{
+		std::shared_ptr<std::string const> Source = get_source_cache().loadFile(Paths[PathIndex]);
+		if(!Source)
+		{
+			fprintf(stderr, "Failed to open the shader: %s\n", Paths[PathIndex].c_str());
+			return EXIT_FAILURE;
+		}
+		InputBytes += Source->size();
+		OutputBytes += compiler::preprocess(Paths[PathIndex]).size();
+	}
+
+	std::chrono::steady_clock::time_point const Start = std::chrono::steady_clock::now();
+	for(int Iteration = 0; Iteration < Iterations; ++Iteration)
+		for(std::size_t PathIndex = 0; PathIndex < Paths.size(); ++PathIndex)
+			compiler::preprocess(Paths[PathIndex]);
+	double const Seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - Start).count();
+
+	double const Count = static_cast<double>(Paths.size()) * Iterations;
+	fprintf(stdout, "%d shaders, %d bytes read, %d bytes preprocessed, %d iterations\n",
+		static_cast<int>(Paths.size()), static_cast<int>(InputBytes), static_cast<int>(OutputBytes), Iterations);
+	fprintf(stdout, "%.2f us per shader, %.1f MB/s\n",
+		Seconds * 1e6 / Count, static_cast<double>(InputBytes) * Iterations / Seconds / (1024.0 * 1024.0));
+
+	return EXIT_SUCCESS;
+}
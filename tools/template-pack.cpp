@@ -0,0 +1,55 @@
+#include "template_pack.hpp"
+#include "png.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+
+// Usage: template-pack <output.pack> <list.txt>
+// list.txt holds one PNG template path per line. The template name is the file name without extension.
+int main(int argc, char* argv[])
+{
+	if(argc != 3)
+	{
+		fprintf(stderr, "Usage: %s <output.pack> <template-list.txt>\n", argv[0]);
+		return EXIT_FAILURE;
+	}
+
+	std::ifstream List(argv[2]);
+	if(!List.is_open())
+	{
+		fprintf(stderr, "Failed to open the template list: %s\n", argv[2]);
+		return EXIT_FAILURE;
+	}
+
+	std::vector<std::string> Names;
+	std::vector<gli::texture> Textures;
+
+	std::string Path;
+	while(std::getline(List, Path))
+	{
+		if(Path.empty())
+			continue;
+
+		gli::texture Texture(load_png(Path.c_str()));
+		if(Texture.empty())
+		{
+			fprintf(stderr, "Failed to load the template: %s\n", Path.c_str());
+			return EXIT_FAILURE;
+		}
+
+		std::size_t const NameOffset = Path.find_last_of("/\\") + 1;
+		std::size_t const ExtensionOffset = Path.find_last_of('.');
+		Names.push_back(Path.substr(NameOffset, ExtensionOffset - NameOffset));
+		Textures.push_back(Texture);
+	}
+
+	if(!save_template_pack(argv[1], Names, Textures))
+	{
+		fprintf(stderr, "Failed to write the template pack: %s\n", argv[1]);
+		return EXIT_FAILURE;
+	}
+
+	fprintf(stdout, "Packed %d templates in %s\n", static_cast<int>(Names.size()), argv[1]);
+	return EXIT_SUCCESS;
+}